@@ -0,0 +1,233 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sr/network/core/networkinterface.h"
+#include "sr/network/core/receiver.h"
+#include "sr/network/core/tcptransport.h"
+#include "sr/sense/eyetracker/eyepairlistener.h"
+#include "sr/sense/handtracker/handposelistener.h"
+#include "sr/sense/headtracker/headlistener.h"
+#include "sr/sense/system/systemeventlistener.h"
+
+namespace SR {
+
+/*!
+ * \brief SR_packet destinations of sense frames
+ *
+ * Eye pairs, heads and hand poses are sent as their structs. A system event is its time and type as two uint64_t,
+ * followed by the message without a terminating zero. Readers accept payloads longer than they expect and ignore the
+ * rest, so a frame can grow at the end without breaking older readers.
+ *
+ * An Encoding packet holds one uint64_t, the highest SensePacketEncoding a client decodes, and the server answers with
+ * the encoding it chose for the connection.
+ *
+ * \ingroup Core_Network API
+ */
+enum class SensePacketType : uint64_t {
+    EyePair = 1,
+    Head = 2,
+    HandPose = 3,
+    SystemEvent = 4,
+    Encoding = 5,
+};
+
+/*!
+ * \brief Versions of the payload of sense frames, the upper 32 bits of the destination
+ *
+ * Compact frames start with the sequence number of their stream as a varint and a key frame flag. Integers are then
+ * written as zigzag varints of the difference to the previous frame of the same stream, positions in fixed point of
+ * 1/100 mm and head orientations of 1e-5 radians the same way. Key frames are differences to zero, so a reader can start
+ * with any of them. Hand poses have a stream per side. A system event is its time, type and message length as varints,
+ * followed by the message.
+ *
+ * \ingroup Core_Network API
+ */
+enum class SensePacketEncoding : uint64_t {
+    Raw = 0,     //!< The structs as they lie in memory
+    Compact = 1, //!< Delta to the previous frame, fixed point and varints
+};
+
+inline uint64_t getSensePacketDestination(SensePacketType type, SensePacketEncoding encoding)
+{
+    return static_cast<uint64_t>(encoding) << 32 | static_cast<uint64_t>(type);
+}
+
+/*!
+ * \brief Listener of every sense that sends the frames it accepts as SR_packet
+ *
+ * Open the streams of a tracker, or add it to a SenseSimulator, and every frame goes to the NetworkInterface or sink,
+ * e.g. TCPServer::broadcast(). Safe to call from several streams at once.
+ *
+ * Compact frames depend on the previous frame of their stream, so every receiver must get all packets of the writer from
+ * the last key frame on. Call requestKeyFrame() when a receiver joins.
+ *
+ * \ingroup Core_Network API
+ */
+class SensePacketWriter : public EyePairListener, public HeadListener, public HandPoseListener, public SystemEventListener {
+public:
+    using Sink = std::function<void(uint64_t destination, void* payload, uint64_t payloadSize)>;
+
+    /*!
+     * \param keyFrameInterval Compact frames of a stream from one key frame to the next
+     * \throw std::invalid_argument if the key frame interval is 0
+     */
+    explicit SensePacketWriter(Sink sink, SensePacketEncoding encoding = SensePacketEncoding::Raw, uint32_t keyFrameInterval = 60);
+
+    /*!
+     * \param network Sends the packets, must outlive the writer
+     */
+    explicit SensePacketWriter(NetworkInterface& network, SensePacketEncoding encoding = SensePacketEncoding::Raw, uint32_t keyFrameInterval = 60);
+
+    ~SensePacketWriter();
+
+    void accept(const SR_eyePair& frame) override;
+    void accept(const SR_head& frame) override;
+    void accept(const SR_handPose& frame) override;
+    void accept(const SystemEvent& frame) override;
+
+    /*!
+     * \brief The next compact frame of every stream is a key frame
+     */
+    void requestKeyFrame();
+
+    SensePacketEncoding getEncoding() const { return encoding; }
+
+    uint64_t getSentCount() const { return sent.load(std::memory_order_relaxed); }
+
+private:
+    class Encoder;
+
+    template <class Frame>
+    void write(SensePacketType type, const Frame& frame);
+
+    Sink sink;
+    const SensePacketEncoding encoding;
+    std::mutex mutex;
+    std::vector<uint8_t> buffer; //!< Reused for system events and compact frames
+    std::unique_ptr<Encoder> encoder;
+    std::atomic<uint64_t> sent{ 0 };
+};
+
+/*!
+ * \brief Receiver that decodes the packets of a SensePacketWriter and passes the frames to listeners
+ *
+ * Decodes every SensePacketEncoding, whichever the packet has. Listeners are called on the thread of the network
+ * interface, one after another with the listener list locked.
+ *
+ * \ingroup Core_Network API
+ */
+class SensePacketReader : public Receiver {
+public:
+    SensePacketReader();
+    ~SensePacketReader();
+
+    void addListener(EyePairListener* listener);
+    void removeListener(EyePairListener* listener);
+    void addListener(HeadListener* listener);
+    void removeListener(HeadListener* listener);
+    void addListener(HandPoseListener* listener);
+    void removeListener(HandPoseListener* listener);
+    void addListener(SystemEventListener* listener);
+    void removeListener(SystemEventListener* listener);
+
+    void receive(SR_packet& packet) override;
+    void print(SR_packet& packet) override;
+
+    /*!
+     * \brief Asks a SensePacketPublisher for frames in \p encoding, or a lower one it supports
+     *
+     * Send it after every connect(). A server that does not know the request keeps sending raw frames.
+     */
+    static void requestEncoding(NetworkInterface& network, SensePacketEncoding encoding);
+
+    /*!
+     * \brief Encoding the server chose in answer to requestEncoding(), raw until it answered
+     */
+    SensePacketEncoding getEncoding() const { return encoding.load(); }
+
+    /*!
+     * \brief Frames passed to the listeners
+     */
+    uint64_t getDecodedCount() const { return decoded.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Compact frames dropped while waiting for a key frame, e.g. after joining a stream
+     */
+    uint64_t getSkippedCount() const { return skipped.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Packets with an unknown destination or encoding, or too short for their frame
+     */
+    uint64_t getRejectedCount() const { return rejected.load(std::memory_order_relaxed); }
+
+private:
+    class Decoder;
+
+    std::mutex listenerMutex;
+    std::vector<EyePairListener*> eyePairListeners;
+    std::vector<HeadListener*> headListeners;
+    std::vector<HandPoseListener*> handPoseListeners;
+    std::vector<SystemEventListener*> systemEventListeners;
+    std::unique_ptr<Decoder> decoder; //!< Previous compact frames, guarded by the listener mutex
+    std::atomic<SensePacketEncoding> encoding{ SensePacketEncoding::Raw };
+    std::atomic<uint64_t> decoded{ 0 };
+    std::atomic<uint64_t> skipped{ 0 };
+    std::atomic<uint64_t> rejected{ 0 };
+};
+
+/*!
+ * \brief Streams sense frames to the clients of a TCPServer, in the encoding each client asked for
+ *
+ * Every client starts with raw frames and may switch with SensePacketReader::requestEncoding(). Each frame is encoded
+ * once per encoding in use, and while every client takes raw frames they go out with TCPServer::broadcast(). The
+ * publisher sets the connection handler of the server and the receiver of every accepted connection.
+ *
+ * \ingroup Core_Network API
+ */
+class SensePacketPublisher : public EyePairListener, public HeadListener, public HandPoseListener, public SystemEventListener {
+public:
+    /*!
+     * \param server Must outlive the publisher
+     * \param receiver Gets the other packets of the clients, may be null
+     * \param maximumEncoding Highest encoding a client gets
+     * \param keyFrameInterval See SensePacketWriter
+     */
+    explicit SensePacketPublisher(TCPServer& server, Receiver* receiver = nullptr,
+        SensePacketEncoding maximumEncoding = SensePacketEncoding::Compact, uint32_t keyFrameInterval = 60);
+    ~SensePacketPublisher();
+
+    SensePacketPublisher(const SensePacketPublisher&) = delete;
+    SensePacketPublisher& operator=(const SensePacketPublisher&) = delete;
+
+    void accept(const SR_eyePair& frame) override;
+    void accept(const SR_head& frame) override;
+    void accept(const SR_handPose& frame) override;
+    void accept(const SystemEvent& frame) override;
+
+    /*!
+     * \brief Frames accepted so far, each sent to every client
+     */
+    uint64_t getSentCount() const;
+
+    /*!
+     * \brief Active clients that take frames in \p encoding
+     */
+    size_t getConnectionCount(SensePacketEncoding encoding);
+
+private:
+    class Impl;
+    class Negotiator;
+    std::shared_ptr<Impl> pimpl;
+};
+
+}
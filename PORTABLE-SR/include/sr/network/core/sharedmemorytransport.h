@@ -0,0 +1,114 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "sr/network/core/networkinterface.h"
+#include "sr/network/core/receiver.h"
+
+namespace SR {
+
+/*!
+ * \brief Sizes and waiting of a SharedMemoryChannel
+ *
+ * \ingroup Core_Network API
+ */
+struct SharedMemoryTransportSettings {
+    size_t ringSize = 1 << 20;      //!< Bytes of the ring of each direction, a packet may take at most half of it
+    uint64_t spinTime = 50;         //!< Microseconds the receive thread polls the ring before it sleeps until woken
+    uint64_t sendTimeout = 1000000; //!< Microseconds send() waits for room in a full ring before it closes the channel, 0 waits while it is open
+};
+
+/*!
+ * \brief NetworkInterface that exchanges SR_packet with another process on the same host through shared memory
+ *
+ * One process creates the channel under a name and the other opens it. Each direction is a single producer, single
+ * consumer ring of SR_packet records in the shared memory: send() copies the packet into the ring and publishes it with
+ * one atomic store, and a receive thread passes each packet to Receiver::receive() where it lies in the ring, 8 byte
+ * aligned. The receive thread polls for a short time after each packet and then sleeps on a futex (an event on Windows),
+ * which send() only wakes when the thread sleeps, so a busy stream needs no system call per packet.
+ *
+ * Sends from several threads are serialized. send() waits while the ring is full, until close() or for at most
+ * SharedMemoryTransportSettings::sendTimeout, after which the peer counts as stuck and the channel closes. The packet is only
+ * valid during receive(). A process that crashes is not noticed by the channel itself, TCPConnection closes the channel
+ * it switched to when its TCP connection ends, and ends the connection when the channel closed. A record the peer wrote
+ * outside the part of the ring it published, e.g. by a peer of another version, closes the channel.
+ *
+ * \ingroup Core_Network API
+ */
+class SharedMemoryChannel : public NetworkInterface {
+public:
+    /*!
+     * \param receiver Receives the incoming packets on the receive thread, must outlive the channel
+     */
+    explicit SharedMemoryChannel(Receiver& receiver, const SharedMemoryTransportSettings& settings = SharedMemoryTransportSettings());
+
+    /*!
+     * \brief Closes the channel and waits for the receive thread
+     */
+    ~SharedMemoryChannel();
+
+    SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+    SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+
+    /*!
+     * \brief Creates the shared memory of a new channel, packets sent before the peer opened it wait in the ring
+     * \return false if the name is taken or the memory cannot be created
+     * \throw std::invalid_argument if the ring size is not a power of two of at least 4 KiB
+     */
+    bool create(const std::string& name);
+
+    /*!
+     * \brief Opens a channel created by another process, ring sizes are taken from the creator
+     * \return false if there is no channel with this name
+     */
+    bool open(const std::string& name);
+
+    /*!
+     * \brief Removes the name of a created channel once the peer has opened it, see SharedMemory::unlink()
+     */
+    void unlink();
+
+    /*!
+     * \brief Tells the peer that the channel closed and stops the receive thread
+     */
+    void close();
+
+    /*!
+     * \brief Copies one SR_packet into the ring, does nothing when the channel is not active
+     * \throw std::invalid_argument if the packet would take more than half of the ring
+     */
+    void send(uint64_t destination, void* payload, uint64_t payloadSize) override;
+
+    /*!
+     * \brief Whether the channel is open on this side and not closed by the peer
+     */
+    bool isActive() override;
+
+    /*!
+     * \brief Packets passed to the receiver so far
+     */
+    uint64_t getReceivedCount() const;
+
+    /*!
+     * \brief Times send() woke the sleeping receive thread of the peer
+     */
+    uint64_t getWakeCount() const;
+
+    /*!
+     * \brief Name that no other channel on this host uses, from the process id and a counter
+     */
+    static std::string makeUniqueName();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+}
@@ -0,0 +1,207 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "sr/network/core/networkinterface.h"
+#include "sr/network/core/receiver.h"
+
+namespace SR {
+
+/*!
+ * \brief Limits of a TCPConnection
+ *
+ * \ingroup Core_Network API
+ */
+struct TCPTransportSettings {
+    uint64_t maximumPacketSize = 16 << 20; //!< Bytes of header and payload, larger incoming packets close the connection
+    size_t receiveBufferSize = 64 << 10;   //!< Initial bytes of the receive buffer, it grows once to the largest packet
+    bool noDelay = true;                   //!< Disable Nagle's algorithm, packets are sent when send() is called
+    size_t coalesceSize = 0;               //!< Packets are collected until this many bytes are pending and written at once, 0 writes every packet
+    uint64_t coalesceDelay = 1000;         //!< Microseconds a collected packet waits at most before it is written
+    size_t sharedMemoryRingSize = 0;       //!< Bytes per direction of the SharedMemoryChannel of loopback connections, 0 keeps them on TCP
+    size_t sendQueueSize = 32 << 20;       //!< Bytes queued for a peer that reads slower than packets are sent, more close the connection
+};
+
+/*!
+ * \brief NetworkInterface that exchanges SR_packet over a TCP connection
+ *
+ * send() writes the SR_packet header and the payload with one gather write straight from the caller's memory, so the
+ * payload is never copied into a packet. send() never waits for the peer: what the socket buffer cannot take is copied
+ * into a send queue that the network thread writes, and a peer that lets the queue grow beyond
+ * TCPTransportSettings::sendQueueSize is disconnected. Sends from several threads are serialized. close() drops what is
+ * still queued.
+ *
+ * Incoming packets are read in large chunks into a receive buffer that belongs to the connection and passed to
+ * Receiver::receive() where they lie, on the network thread of the connection. The buffer is reused for every packet and
+ * only grows when a packet does not fit, so receiving does not allocate per packet. The packet is only valid during
+ * receive(). Packets whose size is not a multiple of 8 bytes shift the ones behind them to the start of the buffer, so
+ * every packet handed out is 8 byte aligned.
+ *
+ * With TCPTransportSettings::coalesceSize set, send() copies the packet into a batch instead, which is written when it
+ * reaches the size, after TCPTransportSettings::coalesceDelay, or on flush(). A high rate of small packets then costs one
+ * system call per batch instead of one per packet, for at most the delay of added latency. The delay is a timer on the
+ * network thread, which the connections of a TCPServer share, so its flush never waits for the peer either: a batch the
+ * socket does not take at once is handed to the send queue as it is.
+ *
+ * With TCPTransportSettings::sharedMemoryRingSize set on both sides, a connection to a loopback address switches to a
+ * SharedMemoryChannel once the server accepted it, and the packets of both sides go through shared memory from then on,
+ * while the TCP connection only tells whether the peer is still there. Packets sent during the switch may arrive out of
+ * order with the first ones sent through shared memory. connect() asks for the switch with a packet to destination
+ * 2^64 - 1 and the server answers to 2^64 - 2, so only set it when the server is a TCPServer that has it set as well.
+ * Without it these destinations are ordinary packets that go to the receiver.
+ *
+ * Do not destroy a connection from its own receiver.
+ *
+ * \ingroup Core_Network API
+ */
+class TCPConnection : public NetworkInterface {
+public:
+    /*!
+     * \param receiver Receives the incoming packets, must outlive the connection
+     */
+    explicit TCPConnection(Receiver& receiver, const TCPTransportSettings& settings = TCPTransportSettings());
+
+    /*!
+     * \brief Closes the connection and waits for its network thread
+     */
+    ~TCPConnection();
+
+    TCPConnection(const TCPConnection&) = delete;
+    TCPConnection& operator=(const TCPConnection&) = delete;
+
+    /*!
+     * \brief Connects to a TCPServer or another SR_packet endpoint
+     * \return false if the host cannot be resolved or refuses the connection
+     */
+    bool connect(const std::string& host, uint16_t port);
+
+    /*!
+     * \brief Replaces the receiver of the incoming packets, the connection keeps it alive
+     *
+     * Only call it before connect(), or from the TCPServer::ConnectionHandler of an accepted connection, so that every
+     * packet goes to one receiver, e.g. to tell the clients of a server apart.
+     *
+     * \throw std::invalid_argument if \p receiver is null
+     */
+    void setReceiver(std::shared_ptr<Receiver> receiver);
+
+    void close();
+
+    /*!
+     * \brief Sends one SR_packet, does nothing when the connection is not active
+     * \throw std::invalid_argument if the packet would be larger than TCPTransportSettings::maximumPacketSize
+     */
+    void send(uint64_t destination, void* payload, uint64_t payloadSize) override;
+
+    /*!
+     * \brief Writes the coalesced packets now
+     */
+    void flush();
+
+    bool isActive() override;
+
+    /*!
+     * \brief Packets passed to the receiver so far
+     */
+    uint64_t getReceivedCount() const;
+
+    /*!
+     * \brief Current size of the receive buffer in bytes
+     */
+    size_t getReceiveBufferSize() const;
+
+    /*!
+     * \brief Writes to the socket so far, each is one gather write of one or more packets
+     */
+    uint64_t getWriteCount() const;
+
+    /*!
+     * \brief Whether packets are sent through a SharedMemoryChannel instead of the socket
+     */
+    bool isSharedMemory();
+
+private:
+    friend class TCPServer;
+    class Impl;
+    class Thread;
+
+    explicit TCPConnection(std::shared_ptr<Impl> impl);
+
+    std::shared_ptr<Impl> pimpl;
+    std::shared_ptr<Thread> ownThread; //!< Network thread of connections made with connect()
+};
+
+/*!
+ * \brief Accepts TCPConnection clients, for streaming tracking data to several applications
+ *
+ * All connections of a server share one network thread, their packets go to the receiver of the server. Packets of local
+ * clients that switched to shared memory arrive on the receive thread of their channel instead, so the receiver of a server
+ * may be called from several threads.
+ *
+ * broadcast() never waits for a client, a client that does not keep up is disconnected once its send queue is full, see
+ * TCPConnection. With coalescing, broadcast() encodes each packet once into a batch shared by all connections, and every
+ * connection writes the same batch, so the cost of encoding does not grow with the number of clients. Packets passed to send() of a
+ * connection are written before the next broadcast batch, the order within each stays as sent.
+ *
+ * \ingroup Core_Network API
+ */
+class TCPServer {
+public:
+    /*!
+     * \brief Called on the network thread for every accepted connection, before its first packet is received
+     */
+    using ConnectionHandler = std::function<void(const std::shared_ptr<TCPConnection>& connection)>;
+
+    /*!
+     * \param receiver Receives the packets of all clients, must outlive the server
+     */
+    explicit TCPServer(Receiver& receiver, const TCPTransportSettings& settings = TCPTransportSettings());
+
+    /*!
+     * \brief Closes all connections and waits for the network thread
+     */
+    ~TCPServer();
+
+    TCPServer(const TCPServer&) = delete;
+    TCPServer& operator=(const TCPServer&) = delete;
+
+    /*!
+     * \param port Port to accept connections on, 0 picks a free one, see getPort()
+     * \param address Local address to bind, all interfaces by default
+     * \return false if the address cannot be bound
+     */
+    bool listen(uint16_t port, const std::string& address = "0.0.0.0");
+
+    uint16_t getPort() const;
+
+    void setConnectionHandler(ConnectionHandler handler);
+
+    /*!
+     * \brief Sends one packet to every active connection, see TCPConnection::send()
+     */
+    void broadcast(uint64_t destination, void* payload, uint64_t payloadSize);
+
+    /*!
+     * \brief Writes the coalesced packets of the server and of all connections now
+     */
+    void flush();
+
+    /*!
+     * \brief Number of active connections
+     */
+    size_t getConnectionCount();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+}
@@ -0,0 +1,147 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "sr/sense/eyetracker/eyepairlistener.h"
+#include "sr/sense/headtracker/headlistener.h"
+#include "sr/sense/weavertracker/weaverpositionlistener.h"
+#include "sr/utility/boundedqueue.h"
+
+namespace SR {
+
+/*!
+ * \brief What AsyncListener::accept() does when the queue of the listener is full
+ *
+ * \ingroup API
+ */
+enum class OverflowPolicy {
+    DropOldest,   //!< Discard the oldest queued frame, the stream thread never waits
+    Backpressure, //!< Wait until the listener took a frame, the stream thread is slowed down to the listener
+};
+
+/*!
+ * \brief Listener that decouples a slow listener from the thread of its stream
+ *
+ * Open the stream on the AsyncListener instead of the listener itself. accept() copies the frame into a bounded
+ * lock-free queue and returns, and a dispatch thread per AsyncListener passes the frames to the listener in order.
+ * A slow listener, for instance a UI, therefore adds no latency to the other listeners of the tracker.
+ *
+ * The queue accepts frames from several streams at once. accept() only takes a lock to wake an idle dispatch thread,
+ * which is uncontended because that thread is waiting.
+ *
+ * \ingroup API
+ */
+template <class Frame, class Listener>
+class AsyncListener : public Listener {
+public:
+    /*!
+     * \param listener Receives the frames on the dispatch thread, must outlive this object
+     * \param capacity Frames that can be queued, rounded up to a power of two
+     * \param policy What to do when the queue is full
+     */
+    explicit AsyncListener(Listener& listener, size_t capacity = 64, OverflowPolicy policy = OverflowPolicy::DropOldest)
+        : listener(listener), queue(capacity), policy(policy), thread(&AsyncListener::dispatch, this)
+    {
+    }
+
+    /*!
+     * \brief Stops the dispatch thread, frames that are still queued are not delivered
+     */
+    ~AsyncListener()
+    {
+        stopping.store(true);
+        wake();
+        thread.join();
+    }
+
+    AsyncListener(const AsyncListener&) = delete;
+    AsyncListener& operator=(const AsyncListener&) = delete;
+
+    void accept(const Frame& frame) override
+    {
+        bool full = false;
+        while (!queue.tryPush(frame)) {
+            if (policy == OverflowPolicy::DropOldest) {
+                Frame oldest;
+                if (queue.tryPop(oldest))
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                if (stopping.load(std::memory_order_relaxed))
+                    return;
+                if (!full)
+                    waited.fetch_add(1, std::memory_order_relaxed);
+                full = true;
+                std::this_thread::yield();
+            }
+        }
+        // Pairs with the fence in dispatch(): either the dispatcher sees the frame or this sees that it sleeps
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed))
+            wake();
+    }
+
+    /*!
+     * \brief Frames discarded by OverflowPolicy::DropOldest
+     */
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Times accept() found the queue full with OverflowPolicy::Backpressure and waited
+     */
+    uint64_t getWaitCount() const { return waited.load(std::memory_order_relaxed); }
+
+    uint64_t getDeliveredCount() const { return delivered.load(std::memory_order_relaxed); }
+
+private:
+    void wake()
+    {
+        { std::lock_guard<std::mutex> lock(mutex); }
+        condition.notify_one();
+    }
+
+    void dispatch()
+    {
+        Frame frame;
+        while (!stopping.load()) {
+            if (queue.tryPop(frame)) {
+                listener.accept(frame);
+                delivered.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            condition.wait(lock, [this] { return stopping.load() || !queue.empty(); });
+            sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    Listener& listener;
+    BoundedQueue<Frame> queue;
+    const OverflowPolicy policy;
+
+    std::atomic<uint64_t> dropped{ 0 };
+    std::atomic<uint64_t> waited{ 0 };
+    std::atomic<uint64_t> delivered{ 0 };
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<bool> sleeping{ false };
+    std::atomic<bool> stopping{ false };
+    std::thread thread;
+};
+
+using AsyncEyePairListener = AsyncListener<SR_eyePair, EyePairListener>;
+using AsyncHeadListener = AsyncListener<SR_head, HeadListener>;
+using AsyncWeaverPositionListener = AsyncListener<SR_weaverPosition, WeaverPositionListener>;
+
+}
@@ -0,0 +1,115 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "sr/sense/eyetracker/eyepairlistener.h"
+#include "sr/sense/headtracker/headlistener.h"
+#include "sr/sense/weavertracker/weaverpositionlistener.h"
+#include "sr/utility/seqlock.h"
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+#include "sr/sense/core/inputstream.h"
+#include "sr/sense/eyetracker/eyetracker.h"
+#include "sr/sense/headtracker/headtracker.h"
+#include "sr/sense/weavertracker/weavertracker.h"
+#endif
+
+namespace SR {
+
+/*!
+ * \brief Listener that keeps only the newest frame of its stream, for threads that poll instead of listening
+ *
+ * accept() stores the frame in a SeqLock, get() copies the newest frame out without taking a lock, so a render thread
+ * reads the eye positions once per frame without contending with the tracker thread, and without a mutex around
+ * the render loop to guard the state of a listener. Frames that arrive between two get() calls are overwritten.
+ *
+ * \ingroup API
+ */
+template <class Frame, class Listener>
+class LatestValueListener : public Listener {
+public:
+    void accept(const Frame& frame) override { latest.store(frame); }
+
+    /*!
+     * \return false if no frame arrived yet, \p frame is unchanged then
+     */
+    bool get(Frame& frame) const
+    {
+        Frame copy;
+        if (latest.load(copy) == 0)
+            return false;
+        frame = copy;
+        return true;
+    }
+
+    /*!
+     * \brief Frames accepted so far, changes when a new frame arrived
+     */
+    uint64_t getVersion() const { return latest.getVersion(); }
+
+private:
+    SeqLock<Frame> latest;
+};
+
+/*!
+ * \brief Newest SR_eyePair of an EyeTracker, PredictingEyeTracker or any other eye pair stream
+ *
+ * Open a stream on it like on any EyePairListener, or construct it from the tracker when the SDK runtime is linked.
+ * A PredictingEyeTracker streams the frames its predict() calls produce.
+ *
+ * \ingroup API
+ */
+class LatestEyePair : public LatestValueListener<SR_eyePair, EyePairListener> {
+public:
+    LatestEyePair() = default;
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+    /*!
+     * \brief Opens an eye pair stream on \p tracker, which is closed again when this object is destroyed
+     */
+    explicit LatestEyePair(EyeTracker& tracker) { stream.set(tracker.openEyePairStream(this)); }
+
+private:
+    InputStream<EyePairStream> stream;
+#endif
+};
+
+/*!
+ * \brief Newest SR_head of a HeadTracker, see LatestEyePair
+ *
+ * \ingroup API
+ */
+class LatestHead : public LatestValueListener<SR_head, HeadListener> {
+public:
+    LatestHead() = default;
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+    explicit LatestHead(HeadTracker& tracker) { stream.set(tracker.openHeadStream(this)); }
+
+private:
+    InputStream<HeadStream> stream;
+#endif
+};
+
+/*!
+ * \brief Newest SR_weaverPosition of a WeaverTracker or PredictingWeaverTracker, see LatestEyePair
+ *
+ * \ingroup API
+ */
+class LatestWeaverPosition : public LatestValueListener<SR_weaverPosition, WeaverPositionListener> {
+public:
+    LatestWeaverPosition() = default;
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+    explicit LatestWeaverPosition(WeaverTracker& tracker) { stream.set(tracker.openWeaverPositionStream(this)); }
+
+private:
+    InputStream<WeaverPositionStream> stream;
+#endif
+};
+
+}
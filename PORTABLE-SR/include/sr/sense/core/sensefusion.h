@@ -0,0 +1,106 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "sr/sense/eyetracker/eyepairlistener.h"
+#include "sr/sense/gestureanalyser/gesturelistener.h"
+#include "sr/sense/handtracker/handposelistener.h"
+#include "sr/sense/headtracker/headlistener.h"
+
+namespace SR {
+
+/*!
+ * \brief Buffering and interpolation limits of a SenseFusion
+ *
+ * \ingroup API
+ */
+struct SenseFusionSettings {
+    size_t capacity = 256;                //!< Frames kept per stream, and per hand
+    uint64_t maximumExtrapolation = 50000; //!< Microseconds a stream is extrapolated past its newest frame, further times are clamped
+    uint64_t timeout = 500000;            //!< A stream whose newest frame is this many microseconds older than the requested time is missing
+};
+
+/*!
+ * \brief State of all streams at one time, see SenseFusion::getSnapshot()
+ *
+ * \ingroup API
+ */
+struct SenseSnapshot {
+    uint64_t time = 0; //!< Requested time in microseconds since epoch
+
+    bool hasEyePair = false;
+    SR_eyePair eyePair = {};
+
+    bool hasHead = false;
+    SR_head head = {};
+
+    bool hasHand[2] = {};       //!< Indexed by SR_handSide
+    SR_handPose hands[2] = {};
+
+    bool hasGesture = false;
+    SR_gesture gesture = {};    //!< Newest gesture at or before the requested time, not interpolated
+};
+
+/*!
+ * \brief Aligns eye pair, head, hand pose and gesture streams by their frame times
+ *
+ * Open the streams on the fusion, it is a listener of each kind. Every stream, and each hand, is kept in a ring of the
+ * newest frames ordered by SR_eyePair::time and so on, frames that are not newer than their predecessor are dropped.
+ * Gestures are events rather than samples, only those older than their predecessor are dropped.
+ * getSnapshot() interpolates every stream linearly to the requested time, for instance the predicted photon time, so
+ * frames that arrived on different threads in any order are combined by when they were captured instead of when they arrived.
+ *
+ * Times after the newest frame of a stream extrapolate its last two frames, up to SenseFusionSettings::maximumExtrapolation.
+ * Times before the oldest kept frame leave the stream missing in the snapshot. Head orientations are interpolated per angle
+ * along the shortest way around, so blending 3.1 and -3.1 radians passes through pi instead of 0.
+ *
+ * Each stream remembers where its previous lookup ended, so snapshots at increasing times, like once per rendered frame,
+ * find their frames in amortized constant time. Other times fall back to a binary search of the ring.
+ *
+ * All methods can be called from any thread, each stream is guarded by its own short lock.
+ *
+ * \ingroup API
+ */
+class SenseFusion : public EyePairListener, public HeadListener, public HandPoseListener, public GestureListener {
+public:
+    /*!
+     * \throw std::invalid_argument if the capacity is less than 2
+     */
+    explicit SenseFusion(const SenseFusionSettings& settings = SenseFusionSettings());
+    ~SenseFusion();
+    SenseFusion(const SenseFusion&) = delete;
+    SenseFusion& operator=(const SenseFusion&) = delete;
+
+    void accept(const SR_eyePair& frame) override;
+    void accept(const SR_head& frame) override;
+
+    /*!
+     * \brief Adds a hand pose to the ring of its SR_handPose::side, poses of other sides are ignored
+     */
+    void accept(const SR_handPose& frame) override;
+    void accept(const SR_gesture& frame) override;
+
+    /*!
+     * \param time Microseconds since epoch, on the clock of the frame times
+     */
+    SenseSnapshot getSnapshot(uint64_t time) const;
+
+    /*!
+     * \brief Forgets all frames, for instance after the clock of the trackers jumped
+     */
+    void reset();
+
+    const SenseFusionSettings& getSettings() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+}
@@ -0,0 +1,222 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "sr/sense/eyetracker/eyepairlistener.h"
+#include "sr/sense/headtracker/headlistener.h"
+#include "sr/sense/headtracker/headposelistener.h"
+#include "sr/sense/weavertracker/weaverpositionlistener.h"
+
+namespace SR {
+
+/*!
+ * \brief Frame type stored in a sense recording, every file holds one type
+ *
+ * \ingroup API
+ */
+enum class SenseRecordType : uint32_t {
+    EyePair = 1,        //!< SR_eyePair
+    Head = 2,           //!< SR_head
+    HeadPose = 3,       //!< SR_headPose
+    WeaverPosition = 4, //!< SR_weaverPosition
+};
+
+template <class Frame>
+struct SenseRecordTraits;
+
+template <>
+struct SenseRecordTraits<SR_eyePair> {
+    static constexpr SenseRecordType type = SenseRecordType::EyePair;
+};
+
+template <>
+struct SenseRecordTraits<SR_head> {
+    static constexpr SenseRecordType type = SenseRecordType::Head;
+};
+
+template <>
+struct SenseRecordTraits<SR_headPose> {
+    static constexpr SenseRecordType type = SenseRecordType::HeadPose;
+};
+
+template <>
+struct SenseRecordTraits<SR_weaverPosition> {
+    static constexpr SenseRecordType type = SenseRecordType::WeaverPosition;
+};
+
+/*!
+ * \brief Size in bytes of one record of \p type, 0 for unknown types
+ */
+size_t getSenseRecordSize(SenseRecordType type);
+
+/*!
+ * \brief Appends sense frames to a recording file
+ *
+ * A recording is a 64 byte header followed by fixed size records, each the frame struct as it is in memory. Frames
+ * start with their frameId and time, and records are stored in time order, so a reader can seek by time with a binary
+ * search. Records are copied into a large stdio buffer, so recording costs a memcpy per frame and a write per buffer.
+ *
+ * Records that are not complete when the process stops, for instance when a kiosk loses power, are ignored by readers
+ * and overwritten when the file is appended to again.
+ *
+ * Files are written in the byte order of the machine, all supported targets are little-endian.
+ *
+ * \ingroup API
+ */
+class SenseRecordWriter {
+public:
+    SenseRecordWriter() = default;
+    ~SenseRecordWriter();
+    SenseRecordWriter(const SenseRecordWriter&) = delete;
+    SenseRecordWriter& operator=(const SenseRecordWriter&) = delete;
+
+    /*!
+     * \brief Opens a recording for appending, creating it if needed
+     * \param append Continue an existing recording of the same type instead of replacing it
+     * \return false if the file cannot be written, or is an existing recording of another type or version
+     */
+    bool open(const std::string& path, SenseRecordType type, bool append = true);
+
+    /*!
+     * \brief Flushes the buffered records and closes the file
+     */
+    void close();
+
+    bool isOpen() const { return file != nullptr; }
+    SenseRecordType getType() const { return type; }
+
+    /*!
+     * \brief Appends a frame, the type must match the recording
+     * \return false if the file is not open, the write failed or the frame is older than the previous record, which would break seeking
+     * \throw std::invalid_argument if the frame type does not match the recording
+     */
+    template <class Frame>
+    bool write(const Frame& frame)
+    {
+        if (SenseRecordTraits<Frame>::type != type)
+            throw std::invalid_argument("Frame type does not match the recording");
+        return writeRecord(&frame, frame.time);
+    }
+
+    /*!
+     * \brief Writes buffered records to the operating system
+     */
+    bool flush();
+
+private:
+    bool writeRecord(const void* record, uint64_t time);
+
+    std::FILE* file = nullptr;
+    std::unique_ptr<char[]> buffer;
+    SenseRecordType type = SenseRecordType::EyePair;
+    size_t recordSize = 0;
+    uint64_t lastTime = 0;
+};
+
+/*!
+ * \brief Listener that records every frame of a stream, open it on the stream of a tracker
+ *
+ * accept() is called on the thread of the stream, the writer is only used from there until the stream is closed.
+ *
+ * \ingroup API
+ */
+template <class Frame, class Listener>
+class SenseRecorder : public Listener {
+public:
+    bool open(const std::string& path, bool append = true)
+    {
+        return writer.open(path, SenseRecordTraits<Frame>::type, append);
+    }
+
+    void accept(const Frame& frame) override
+    {
+        if (writer.write(frame))
+            recorded++;
+        else
+            dropped++;
+    }
+
+    SenseRecordWriter& getWriter() { return writer; }
+    uint64_t getRecordedCount() const { return recorded; }
+    uint64_t getDroppedCount() const { return dropped; }
+
+private:
+    SenseRecordWriter writer;
+    uint64_t recorded = 0;
+    uint64_t dropped = 0;
+};
+
+using EyePairRecorder = SenseRecorder<SR_eyePair, EyePairListener>;
+using HeadRecorder = SenseRecorder<SR_head, HeadListener>;
+using HeadPoseRecorder = SenseRecorder<SR_headPose, HeadPoseListener>;
+using WeaverPositionRecorder = SenseRecorder<SR_weaverPosition, WeaverPositionListener>;
+
+/*!
+ * \brief Read-only memory-mapped view of a recording written by SenseRecordWriter
+ *
+ * Records are used in place without copying. The view covers the complete records at the time open() was called.
+ *
+ * \ingroup API
+ */
+class SenseRecording {
+public:
+    SenseRecording();
+    ~SenseRecording();
+    SenseRecording(SenseRecording&& other) noexcept;
+    SenseRecording& operator=(SenseRecording&& other) noexcept;
+    SenseRecording(const SenseRecording&) = delete;
+    SenseRecording& operator=(const SenseRecording&) = delete;
+
+    /*!
+     * \return false if the file cannot be mapped or is not a recording of a known type and version, the view is empty then
+     */
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const;
+    SenseRecordType getType() const;
+
+    /*!
+     * \brief Number of complete records
+     */
+    size_t size() const;
+
+    /*!
+     * \brief Time of the record at \p index < size() in microseconds since epoch
+     */
+    uint64_t getTime(size_t index) const;
+
+    /*!
+     * \brief Index of the first record at or after \p time, size() if there is none, in O(log n)
+     */
+    size_t seek(uint64_t time) const;
+
+    /*!
+     * \brief Record at \p index < size(), valid as long as the recording is open
+     * \throw std::invalid_argument if \p Frame is not the type of the recording
+     */
+    template <class Frame>
+    const Frame& get(size_t index) const
+    {
+        if (SenseRecordTraits<Frame>::type != getType())
+            throw std::invalid_argument("Frame type does not match the recording");
+        return *static_cast<const Frame*>(getRecord(index));
+    }
+
+    const void* getRecord(size_t index) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+}
@@ -0,0 +1,206 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sr/sense/core/senserecording.h"
+#include "sr/utility/eyetrajectory.h"
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+#include <memory>
+
+#include "sr/management/srcontext.h"
+#include "sr/sense/eyetracker/eyetracker.h"
+#include "sr/sense/headtracker/headtracker.h"
+#endif
+
+namespace SR {
+
+/*!
+ * \brief Timing of a SenseSimulator
+ *
+ * \ingroup API
+ */
+struct SenseSimulatorSettings {
+    double rate = 60.0;              //!< Frames per second of trajectories, recordings keep their own timing
+    bool simulatedClock = false;     //!< Frames are emitted by advance() instead of a thread running in real time
+    uint64_t startTime = 0;          //!< Time of the first frame on the simulated clock, microseconds since epoch
+    bool loop = false;               //!< Start over at the end of the trajectory or recording instead of stopping
+    float eyeDistance = 63.0f;       //!< Distance between the eyes of trajectories in mm
+    float earDistance = 150.0f;      //!< Distance between the ears of trajectories in mm
+};
+
+/*!
+ * \brief Eye tracker and head tracker without hardware, emitting SR_eyePair and SR_head frames to listeners
+ *
+ * Frames come from an EyeTrajectory, sampled at the configured rate, or from an eye pair or head recording, replayed
+ * with its recorded timing. Frame times are on the clock of the simulator and frame ids count up from 0, whatever the source.
+ *
+ * With the real clock, start() runs a thread that emits every frame when it is due, at rates up to 1 kHz and more.
+ * With the simulated clock, advance() moves time forward and emits the frames that became due on the calling thread,
+ * so tests and load runs are deterministic and run as fast as the listeners allow.
+ *
+ * Listeners are called one after another with the listener list locked, a listener that is removed is not called afterwards.
+ *
+ * \ingroup API
+ */
+class SenseSimulator {
+public:
+    /*!
+     * \throw std::invalid_argument if the trajectory is empty or the rate is not positive
+     */
+    SenseSimulator(EyeTrajectory trajectory, const SenseSimulatorSettings& settings);
+
+    /*!
+     * \throw std::invalid_argument if the recording is empty or holds neither eye pairs nor heads
+     */
+    SenseSimulator(SenseRecording recording, const SenseSimulatorSettings& settings);
+
+    ~SenseSimulator();
+    SenseSimulator(const SenseSimulator&) = delete;
+    SenseSimulator& operator=(const SenseSimulator&) = delete;
+
+    void addListener(EyePairListener* listener);
+    void removeListener(EyePairListener* listener);
+    void addListener(HeadListener* listener);
+    void removeListener(HeadListener* listener);
+
+    /*!
+     * \brief Starts emitting frames in real time, does nothing with the simulated clock or when already running
+     */
+    void start();
+
+    /*!
+     * \brief Stops the thread started by start(), a frame that is being emitted is finished first
+     */
+    void stop();
+
+    /*!
+     * \brief Waits until the thread started by start() emitted the last frame of the source or was stopped
+     *
+     * Returns at once when no thread runs, and only after stop() when looping.
+     */
+    void wait();
+
+    /*!
+     * \brief Moves the simulated clock forward and emits all frames that became due
+     * \return false when the source is exhausted, always true when looping
+     * \throw std::logic_error with the real clock
+     */
+    bool advance(uint64_t microseconds);
+
+    /*!
+     * \brief Current time of the simulated clock, or the time of the last emitted frame with the real clock
+     */
+    uint64_t getTime() const;
+
+    uint64_t getFrameCount() const;
+
+    const SenseSimulatorSettings& getSettings() const { return settings; }
+
+private:
+    // Offset of frame index from the start of the simulation and whether the source has it
+    bool getFrameOffset(uint64_t index, uint64_t& offset) const;
+    void makeFrame(uint64_t index, uint64_t time, SR_eyePair& pair, SR_head& head) const;
+    void emit(uint64_t index, uint64_t time);
+    void run();
+
+    SenseSimulatorSettings settings;
+    EyeTrajectory trajectory;
+    SenseRecording recording;
+    bool fromRecording = false;
+    uint64_t sourceDuration = 0; //!< Microseconds until the source starts over when looping
+
+    std::mutex listenerMutex;
+    std::vector<EyePairListener*> eyePairListeners;
+    std::vector<HeadListener*> headListeners;
+
+    uint64_t nextFrame = 0;
+    std::atomic<uint64_t> frameCount{ 0 };
+    std::atomic<uint64_t> time{ 0 };
+
+    std::thread thread;
+    std::mutex threadMutex;
+    std::condition_variable stopCondition; //!< Also tells wait() that the thread ended
+    bool stopping = false;
+    bool running = false;
+};
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+
+/*!
+ * \brief EyeTracker sense that streams the frames of a SenseSimulator, for registering in an SRContext without hardware
+ *
+ * Only available when linking the SDK runtime, which implements the streams.
+ *
+ * \ingroup API
+ */
+class SimulatedEyeTracker : public EyeTracker {
+public:
+    /*!
+     * \brief Creates a simulated eye tracker and registers it in \p context like EyeTracker::create()
+     * \param simulator Source of the frames, must outlive the tracker
+     */
+    static SimulatedEyeTracker* create(SRContext& context, SenseSimulator& simulator);
+
+    explicit SimulatedEyeTracker(SenseSimulator& simulator);
+    ~SimulatedEyeTracker() override;
+
+    std::string getName() override;
+    std::string getDescription() override;
+    void start() override;
+    void stop() override;
+    std::shared_ptr<EyePairStream> openEyePairStream(EyePairListener* listener) override;
+    void streamClosed(EyePairStream* stream) override;
+
+private:
+    class Forwarder;
+
+    SenseSimulator& simulator;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Forwarder>> forwarders;
+};
+
+/*!
+ * \brief HeadTracker sense that streams the frames of a SenseSimulator, see SimulatedEyeTracker
+ *
+ * \ingroup API
+ */
+class SimulatedHeadTracker : public HeadTracker {
+public:
+    /*!
+     * \brief Creates a simulated head tracker and registers it in \p context like HeadTracker::create()
+     * \param simulator Source of the frames, must outlive the tracker
+     */
+    static SimulatedHeadTracker* create(SRContext& context, SenseSimulator& simulator);
+
+    explicit SimulatedHeadTracker(SenseSimulator& simulator);
+    ~SimulatedHeadTracker() override;
+
+    std::string getName() override;
+    std::string getDescription() override;
+    void start() override;
+    void stop() override;
+    std::shared_ptr<HeadStream> openHeadStream(HeadListener* listener) override;
+    void streamClosed(HeadStream* stream) override;
+
+private:
+    class Forwarder;
+
+    SenseSimulator& simulator;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Forwarder>> forwarders;
+};
+
+#endif
+
+}
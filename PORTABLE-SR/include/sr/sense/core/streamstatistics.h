@@ -0,0 +1,218 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sr/sense/eyetracker/eyepairlistener.h"
+#include "sr/sense/headtracker/headlistener.h"
+#include "sr/sense/weavertracker/weaverpositionlistener.h"
+
+namespace SR {
+
+/*!
+ * \brief Histogram of durations in nanoseconds with a relative resolution of 1/8, safe to record into from several threads
+ *
+ * Durations are counted in buckets, eight per power of two, with one atomic increment per record() and no allocation.
+ *
+ * \ingroup API
+ */
+class DurationHistogram {
+public:
+    struct Summary {
+        uint64_t count = 0;
+        double mean = 0.0;    //!< Microseconds, exact
+        double p50 = 0.0;     //!< Microseconds, within 1/16 of the true percentile
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double maximum = 0.0; //!< Microseconds, exact
+    };
+
+    DurationHistogram();
+    DurationHistogram(const DurationHistogram&) = delete;
+    DurationHistogram& operator=(const DurationHistogram&) = delete;
+
+    void record(uint64_t nanoseconds);
+
+    Summary getSummary() const;
+
+    /*!
+     * \brief Clears all counts, durations recorded at the same time may be partially lost
+     */
+    void reset();
+
+private:
+    static constexpr int bucketCount = 8 + 61 * 8;
+
+    std::atomic<uint64_t> buckets[bucketCount];
+    std::atomic<uint64_t> sum{ 0 };
+    std::atomic<uint64_t> maximum{ 0 };
+};
+
+/*!
+ * \brief What an instrumented stream measured, see StreamInstrumentation::getStatistics()
+ *
+ * \ingroup API
+ */
+struct StreamStatistics {
+    uint64_t frames = 0;                 //!< Frames passed to the listener
+    uint64_t dropped = 0;                //!< Frame ids that were skipped, frames the tracker produced but this listener never got
+    DurationHistogram::Summary latency;  //!< From the capture time of the frame to its dispatch to the listener
+    DurationHistogram::Summary interval; //!< Between consecutive dispatches
+    double jitter = 0.0;                 //!< Standard deviation of the interval in microseconds
+    DurationHistogram::Summary listener; //!< Time spent in accept() of the listener
+};
+
+/*!
+ * \brief Measurements of one stream, shared by every InstrumentedListener
+ *
+ * \ingroup API
+ */
+class StreamInstrumentation {
+public:
+    StreamInstrumentation() = default;
+    StreamInstrumentation(const StreamInstrumentation&) = delete;
+    StreamInstrumentation& operator=(const StreamInstrumentation&) = delete;
+
+    StreamStatistics getStatistics() const;
+
+    /*!
+     * \brief Starts a new measurement period
+     */
+    void resetStatistics();
+
+    /*!
+     * \brief Formats \p statistics as a single line of text, prefixed with \p name
+     */
+    static std::string format(const std::string& name, const StreamStatistics& statistics);
+
+protected:
+    /*!
+     * \brief Records one dispatch
+     * \param frameId Frame id of the frame, consecutive frames differ by one
+     * \param captureTime Capture time of the frame in microseconds since epoch
+     * \param dispatchTime Start of the dispatch in microseconds since epoch
+     * \param dispatchClock Start of the dispatch on the steady clock, for intervals
+     * \param listenerNanoseconds Duration of the listener call
+     */
+    void record(uint64_t frameId, uint64_t captureTime, uint64_t dispatchTime, std::chrono::steady_clock::time_point dispatchClock,
+        uint64_t listenerNanoseconds);
+
+private:
+    std::atomic<uint64_t> frames{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+    std::atomic<uint64_t> lastFrameId{ 0 };
+    std::atomic<int64_t> lastDispatch{ 0 };  //!< Steady clock nanoseconds, 0 before the first frame
+    std::atomic<double> intervalSquares{ 0.0 }; //!< Nanoseconds squared, for the jitter
+    DurationHistogram latency;
+    DurationHistogram interval;
+    DurationHistogram listenerTime;
+};
+
+/*!
+ * \brief Listener that measures the timing of a stream and of the listener it forwards to
+ *
+ * Open the stream on the InstrumentedListener instead of the listener itself, the frames are passed on unchanged on the
+ * thread of the stream. Every frame costs two clock reads and a few atomic increments, so it can stay in production builds.
+ * Wrapping an AsyncListener measures the stream up to the queue, wrapping the listener behind an AsyncListener measures
+ * the dispatch thread as well.
+ *
+ * Latencies compare SR_eyePair::time and so on to the system clock, so they are only meaningful when the tracker stamps
+ * frames with the clock of this machine.
+ *
+ * \ingroup API
+ */
+template <class Frame, class Listener>
+class InstrumentedListener : public Listener, public StreamInstrumentation {
+public:
+    /*!
+     * \param listener Receives the frames, must outlive this object
+     */
+    explicit InstrumentedListener(Listener& listener) : listener(listener) {}
+
+    void accept(const Frame& frame) override
+    {
+        const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        const uint64_t dispatchTime = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        listener.accept(frame);
+        const uint64_t listenerNanoseconds = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+        record(frame.frameId, frame.time, dispatchTime, begin, listenerNanoseconds);
+    }
+
+private:
+    Listener& listener;
+};
+
+using InstrumentedEyePairListener = InstrumentedListener<SR_eyePair, EyePairListener>;
+using InstrumentedHeadListener = InstrumentedListener<SR_head, HeadListener>;
+using InstrumentedWeaverPositionListener = InstrumentedListener<SR_weaverPosition, WeaverPositionListener>;
+
+/*!
+ * \brief Writes the statistics of instrumented streams periodically to a log
+ *
+ * Every period one line per stream is written and its statistics are reset, so each line covers the last period.
+ * By default the lines go to SR::Log::info() when the SDK runtime is linked and to std::clog otherwise.
+ *
+ * \ingroup API
+ */
+class StreamStatisticsReporter {
+public:
+    using Sink = std::function<void(const std::string& line)>;
+
+    /*!
+     * \param period Time between reports
+     * \param sink Receives the lines, the default log if empty
+     * \throw std::invalid_argument if \p period is not positive
+     */
+    explicit StreamStatisticsReporter(std::chrono::milliseconds period, Sink sink = Sink());
+
+    /*!
+     * \brief Stops reporting, without a final report
+     */
+    ~StreamStatisticsReporter();
+
+    StreamStatisticsReporter(const StreamStatisticsReporter&) = delete;
+    StreamStatisticsReporter& operator=(const StreamStatisticsReporter&) = delete;
+
+    /*!
+     * \param instrumentation Stream to report, must stay alive until it is removed
+     */
+    void add(const std::string& name, StreamInstrumentation& instrumentation);
+    void remove(StreamInstrumentation& instrumentation);
+
+    /*!
+     * \brief Reports and resets all streams now, the next periodic report follows a period later
+     */
+    void report();
+
+private:
+    void run();
+
+    struct Entry {
+        std::string name;
+        StreamInstrumentation* instrumentation;
+    };
+
+    const std::chrono::milliseconds period;
+    Sink sink;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<Entry> entries;
+    bool stopping = false;
+    std::chrono::steady_clock::time_point nextReport;
+    std::thread thread;
+};
+
+}
@@ -0,0 +1,61 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "sr/sense/eyetracker/eyepair.h"
+
+namespace SR {
+
+/*!
+ * \brief Fixed size ring buffer of the most recent SR_eyePair samples, never allocates
+ *
+ * Pushing to a full history drops the oldest sample. Samples are addressed by age, 0 is the newest.
+ *
+ * \ingroup EyeTracker API
+ */
+template <size_t Capacity>
+class EyePairHistory {
+public:
+    static_assert(Capacity > 0, "An eye pair history holds at least one sample");
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    void clear()
+    {
+        count = 0;
+        next = 0;
+    }
+
+    void push(const SR_eyePair& pair)
+    {
+        samples[next] = pair;
+        next = (next + 1) % Capacity;
+        if (count < Capacity)
+            count++;
+    }
+
+    /*!
+     * \param age 0 for the newest sample, up to size() - 1 for the oldest
+     */
+    const SR_eyePair& operator[](size_t age) const
+    {
+        return samples[(next + Capacity - 1 - age) % Capacity];
+    }
+
+    const SR_eyePair& newest() const { return (*this)[0]; }
+
+private:
+    std::array<SR_eyePair, Capacity> samples{};
+    size_t next = 0;
+    size_t count = 0;
+};
+
+}
@@ -0,0 +1,104 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "sr/sense/eyetracker/eyepairlistener.h"
+
+namespace SR {
+
+/*!
+ * \brief Motion model of an EyePredictor
+ *
+ * \ingroup EyeTracker API
+ */
+enum class EyePredictorModel {
+    ConstantVelocity,     //!< Least squares line through the newest window samples
+    ConstantAcceleration, //!< Least squares parabola through the newest window samples
+    Kalman,               //!< Kalman filter per coordinate with position and velocity state
+    OneEuro,              //!< One-Euro filter, extrapolated with its filtered velocity
+};
+
+/*!
+ * \brief Settings of an EyePredictor, the defaults reproduce two point constant velocity extrapolation
+ *
+ * Larger windows, a smaller Kalman process noise and a smaller One-Euro cutoff all reduce jitter at the cost of lag.
+ *
+ * \ingroup EyeTracker API
+ */
+struct EyePredictorSettings {
+    static constexpr size_t maximumWindow = 16;
+
+    EyePredictorModel model = EyePredictorModel::ConstantVelocity;
+    size_t window = 2;                //!< Samples fitted by the polynomial models, at least 2 for constant velocity and 3 for constant acceleration
+    double processNoise = 1.0e6;      //!< Kalman white acceleration noise density in mm^2/s^3
+    double measurementNoise = 1.0;    //!< Kalman standard deviation of the tracker samples in mm
+    double minimumCutoff = 1.0;       //!< One-Euro cutoff frequency in Hz when the eyes are still
+    double beta = 0.01;               //!< One-Euro cutoff increase in Hz per mm/s of speed
+    double derivativeCutoff = 1.0;    //!< One-Euro cutoff frequency of the velocity in Hz
+    uint64_t maximumHorizon = 100000; //!< Predictions further than this many microseconds after the newest sample are clamped
+};
+
+/*!
+ * \brief Predicts the eye positions at a given time from the SR_eyePair samples of an eye tracker
+ *
+ * An open alternative to PredictingEyeTracker::predict() with a selectable motion model. The predictor is an EyePairListener,
+ * so it can listen to the EyePairStream of any EyeTracker, or samples can be passed to accept() directly.
+ *
+ * accept() updates the filter state, the least squares fit of the polynomial models included, so predict() only evaluates
+ * the motion model and predictions for several windows with their own latencies share one update per sample.
+ *
+ * accept() and predict() run in bounded time on fixed size state and never allocate. They are not synchronized,
+ * call them from one thread or guard them.
+ *
+ * \ingroup EyeTracker API
+ */
+class EyePredictor : public EyePairListener {
+public:
+    virtual ~EyePredictor() = default;
+
+    /*!
+     * \brief Adds a tracker sample, samples that are not newer than the previous one are ignored
+     */
+    void accept(const SR_eyePair& frame) override = 0;
+
+    /*!
+     * \brief Predicts both eye positions at \p time
+     *
+     * \param time Microseconds since epoch, on the clock of SR_eyePair::time
+     * \param output Receives the positions, the frameId of the newest sample and \p time
+     * \return false if no sample was accepted yet, \p output is unchanged then
+     */
+    virtual bool predict(uint64_t time, SR_eyePair& output) const = 0;
+
+    /*!
+     * \brief Predicts both eye positions at several times in one call, e.g. for windows with different latencies
+     *
+     * Equal to calling predict() for every time, without the call overhead per time.
+     *
+     * \param times \p count times in microseconds since epoch, in any order
+     * \param outputs Receives \p count predictions, one per time
+     * \return false if no sample was accepted yet, \p outputs are unchanged then
+     */
+    virtual bool predict(const uint64_t* times, size_t count, SR_eyePair* outputs) const = 0;
+
+    /*!
+     * \brief Forgets all samples, for instance after the tracker lost the user
+     */
+    virtual void reset() = 0;
+
+    virtual const EyePredictorSettings& getSettings() const = 0;
+};
+
+/*!
+ * \brief Creates the predictor of \p settings.model
+ * \throw std::invalid_argument if the window does not fit the model or a filter parameter is not positive
+ */
+std::unique_ptr<EyePredictor> createEyePredictor(const EyePredictorSettings& settings);
+
+}
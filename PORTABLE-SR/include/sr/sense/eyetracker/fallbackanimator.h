@@ -0,0 +1,105 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sr/sense/eyetracker/eyepair.h"
+
+namespace SR {
+
+/*!
+ * \brief Shape of a FallbackAnimator transition, mapping progress in [0, 1] to a blend weight in [0, 1]
+ *
+ * \ingroup EyeTracker API
+ */
+enum class EasingCurve {
+    Linear,           //!< Constant speed, starts and stops abruptly
+    SmoothStep,       //!< 3t^2 - 2t^3, starts and stops with zero speed
+    SmootherStep,     //!< 6t^5 - 15t^4 + 10t^3, also starts and stops with zero acceleration
+    EaseOutCubic,     //!< 1 - (1 - t)^3, moves at once and slows down towards the end
+    CriticallyDamped, //!< Like a critically damped spring, scaled to arrive at t = 1
+};
+
+/*!
+ * \brief Settings of a FallbackAnimator
+ *
+ * \ingroup EyeTracker API
+ */
+struct FallbackAnimatorSettings {
+    float defaultLeft[3] = { -31.5f, 100.0f, 600.0f };  //!< Left eye position in mm when nobody is tracked
+    float defaultRight[3] = { 31.5f, 100.0f, 600.0f };  //!< Right eye position in mm when nobody is tracked
+    uint64_t lostDelay = 500000;                        //!< Microseconds the last position is held after the user was lost
+    uint64_t fallbackDuration = 1000000;                //!< Microseconds of the movement to the default position
+    EasingCurve fallbackCurve = EasingCurve::SmoothStep;
+    uint64_t reacquireDuration = 250000;                //!< Microseconds of blending into the tracked position after the user was found
+    EasingCurve reacquireCurve = EasingCurve::EaseOutCubic;
+    size_t tableSize = 256;                             //!< Samples of each precomputed curve
+};
+
+/*!
+ * \brief Eases the eye positions passed to the weaver to a default position when tracking is lost, and back when it is found
+ *
+ * Call setTracking() on the UserLost and UserFound system events, and update() once per frame with the newest tracked
+ * eye pair. The animator holds the last position for a delay, moves to the default position and, when the user is found,
+ * blends from wherever it is into the tracked position, so neither event makes the view jump. A transition that starts
+ * while another one is running starts from the current position.
+ *
+ * Both curves are sampled into tables at construction. update() is the same table lookup and blend in every state, without
+ * branches on the state and without allocation, so its cost is constant. The weaver receives plain eye positions and
+ * needs no fallback logic of its own.
+ *
+ * \ingroup EyeTracker API
+ */
+class FallbackAnimator {
+public:
+    /*!
+     * \brief Starts without a tracked user at the default position
+     * \throw std::invalid_argument if the table size is less than 2
+     */
+    explicit FallbackAnimator(const FallbackAnimatorSettings& settings = FallbackAnimatorSettings());
+
+    /*!
+     * \brief Starts the transition to the default position, or back to the tracked position
+     * \param time Microseconds since epoch, on the clock passed to update()
+     */
+    void setTracking(bool tracking, uint64_t time);
+
+    bool isTracking() const { return tracking; }
+
+    /*!
+     * \brief Whether the transition started by the last setTracking() has finished at \p time
+     */
+    bool isSettled(uint64_t time) const;
+
+    /*!
+     * \brief Computes the eye positions to weave for at \p time
+     * \param tracked Newest eye pair of the tracker, ignored while not tracking and may hold anything then
+     * \param output Receives the positions, the frameId of \p tracked and \p time
+     */
+    void update(uint64_t time, const SR_eyePair& tracked, SR_eyePair& output);
+
+    /*!
+     * \brief Evaluates \p curve at \p progress, clamped to [0, 1], without a table
+     */
+    static double evaluate(EasingCurve curve, double progress);
+
+    const FallbackAnimatorSettings& getSettings() const { return settings; }
+
+private:
+    FallbackAnimatorSettings settings;
+    std::vector<float> tables[2];     //!< Fallback and reacquire curve, tableSize + 1 samples each
+    SR_point3d defaultEyes[2];
+
+    bool tracking = false;
+    SR_point3d from[2];               //!< Position when the running transition started
+    SR_point3d current[2];            //!< Position of the last update()
+    uint64_t start = 0;               //!< Microseconds since epoch when the running transition starts moving
+    double inverseDuration = 1.0;     //!< Of the running transition, per microsecond
+};
+
+}
@@ -0,0 +1,118 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace SR {
+
+/*!
+ * \brief Bounded lock-free queue for any number of producers and consumers
+ *
+ * Every slot carries a sequence number that tells producers and consumers whose turn it is, so tryPush() and tryPop()
+ * claim a slot with a single compare-and-swap and never block or allocate. The capacity is rounded up to a power of two.
+ *
+ * T must be copy assignable, the slots are default constructed up front.
+ */
+template <class T>
+class BoundedQueue {
+public:
+    /*!
+     * \throw std::invalid_argument if \p capacity is 0
+     */
+    explicit BoundedQueue(size_t capacity)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("A queue holds at least one element");
+        size_t size = 1;
+        while (size < capacity)
+            size *= 2;
+        mask = size - 1;
+        slots.reset(new Slot[size]);
+        for (size_t i = 0; i < size; i++)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    /*!
+     * \return false if the queue is full
+     */
+    bool tryPush(const T& value)
+    {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[position & mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /*!
+     * \return false if the queue is empty
+     */
+    bool tryPop(T& value)
+    {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[position & mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = slot.value;
+                    slot.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /*!
+     * \brief Whether an element was pushed that was not popped yet, exact only while no other thread uses the queue
+     */
+    bool empty() const
+    {
+        const size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        const Slot& slot = slots[position & mask];
+        return slot.sequence.load(std::memory_order_acquire) != position + 1;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask = 0;
+    // Producers and consumers update different cache lines
+    alignas(64) std::atomic<size_t> enqueuePosition{ 0 };
+    alignas(64) std::atomic<size_t> dequeuePosition{ 0 };
+};
+
+}
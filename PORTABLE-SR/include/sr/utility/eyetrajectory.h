@@ -0,0 +1,80 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SR {
+
+/*!
+ * \brief Scripted movement of the viewer, the center between both eyes in millimeters in display coordinates
+ *
+ * Positions are interpolated linearly between keyframes and held constant before the first and after the last keyframe.
+ * Both eyes keep their distance, so the left eye is at the center minus half the eye distance in x.
+ *
+ * \ingroup API
+ */
+class EyeTrajectory {
+public:
+    struct Keyframe {
+        double time;        //!< Seconds since the start of the trajectory
+        float position[3];  //!< Center between the eyes in mm
+    };
+
+    EyeTrajectory() = default;
+
+    /*!
+     * \throw std::invalid_argument if the keyframes are empty or not sorted by time
+     */
+    explicit EyeTrajectory(std::vector<Keyframe> keyframes);
+
+    /*!
+     * \brief Side to side sway around \p center, sampled every millisecond
+     * \param amplitude Largest horizontal offset in mm
+     * \param frequency Swings per second
+     * \param duration Length of the trajectory in seconds
+     */
+    static EyeTrajectory sway(const float center[3], float amplitude, double frequency, double duration);
+
+    /*!
+     * \brief Random movement that stays near \p center, sampled every millisecond
+     *
+     * The velocity of every axis changes randomly and decorrelates over half a second, while the position is pulled
+     * back to the center over two seconds, so the viewer wanders smoothly. Equal seeds give equal trajectories.
+     *
+     * \param deviation Standard deviation of the offset from the center per axis in mm
+     * \param duration Length of the trajectory in seconds
+     * \param seed Seed of the random numbers
+     */
+    static EyeTrajectory randomWalk(const float center[3], float deviation, double duration, uint32_t seed);
+
+    /*!
+     * \brief Holds \p from until \p stepTime and then jumps to \p to, like a viewer that is replaced by another one
+     * \param duration Length of the trajectory in seconds, at least \p stepTime
+     */
+    static EyeTrajectory step(const float from[3], const float to[3], double stepTime, double duration);
+
+    /*!
+     * \brief Reads keyframes from a text file, one "time x y z" line per keyframe, lines starting with # are skipped
+     * \return false if the file cannot be read or holds no valid sorted keyframes, \p trajectory is unchanged then
+     */
+    static bool load(const std::string& path, EyeTrajectory& trajectory);
+
+    void evaluate(double time, float position[3]) const;
+
+    /*!
+     * \brief Time of the last keyframe
+     */
+    double getDuration() const;
+
+    const std::vector<Keyframe>& getKeyframes() const { return keyframes; }
+
+private:
+    std::vector<Keyframe> keyframes;
+};
+
+}
@@ -0,0 +1,84 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace SR {
+
+/*!
+ * \brief Converts an IEEE 754 binary16 value, as stored in RGBA16F buffers, to float
+ *
+ * \ingroup API
+ */
+inline float halfToFloat(uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1f;
+    uint32_t mantissa = half & 0x3ff;
+    uint32_t bits;
+    if (exponent == 0x1f) {
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // Subnormal half, normalize into a float
+        uint32_t shift = 0;
+        while ((mantissa & 0x400) == 0) {
+            mantissa <<= 1;
+            shift++;
+        }
+        bits = sign | ((113 - shift) << 23) | ((mantissa & 0x3ff) << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/*!
+ * \brief Converts a float to IEEE 754 binary16 with round to nearest even, overflow becomes infinity
+ *
+ * \ingroup API
+ */
+inline uint16_t floatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const uint32_t exponent = (bits >> 23) & 0xff;
+    const uint32_t mantissa = bits & 0x7fffff;
+
+    if (exponent == 0xff)
+        return static_cast<uint16_t>(sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0));
+    if (exponent > 142)
+        return static_cast<uint16_t>(sign | 0x7c00);
+    if (exponent < 102)
+        return sign;
+
+    uint32_t significand = mantissa | 0x800000;
+    uint32_t shift;
+    uint32_t halfExponent;
+    if (exponent < 113) {
+        // Subnormal half
+        shift = 126 - exponent;
+        halfExponent = 0;
+    } else {
+        shift = 13;
+        halfExponent = exponent - 112;
+        significand &= 0x7fffff;
+    }
+    uint32_t result = (halfExponent << 10) | (significand >> shift);
+    const uint32_t remainder = significand & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    // A carry out of the mantissa correctly increments the exponent
+    if (remainder > halfway || (remainder == halfway && (result & 1) != 0))
+        result++;
+    return static_cast<uint16_t>(sign | result);
+}
+
+}
@@ -0,0 +1,88 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace SR {
+
+/*!
+ * \brief Holds the latest value of a small trivially copyable type, readable without locks while it is written
+ *
+ * A writer makes the sequence number odd, copies the value and makes it even again. A reader copies the value between
+ * two reads of the sequence number and retries when a write overlapped, so readers never block the writer and never
+ * see a torn value. The value is stored in atomic words, which keeps the concurrent copy free of data races.
+ *
+ * Writers exclude each other with the sequence number, a single writer, such as the thread of a stream, never waits.
+ */
+template <class T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock copies values with memcpy");
+
+public:
+    SeqLock()
+    {
+        for (std::atomic<uint64_t>& word : words)
+            word.store(0, std::memory_order_relaxed);
+    }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    void store(const T& value)
+    {
+        uint64_t buffer[WordCount] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+
+        uint64_t before = sequence.load(std::memory_order_relaxed);
+        while ((before & 1) != 0 || !sequence.compare_exchange_weak(before, before + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            std::this_thread::yield();
+            before = sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WordCount; i++)
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        sequence.store(before + 2, std::memory_order_release);
+    }
+
+    /*!
+     * \return Number of store() calls the value is from, 0 if nothing was stored yet and \p value is all zero bytes
+     */
+    uint64_t load(T& value) const
+    {
+        uint64_t buffer[WordCount];
+        for (;;) {
+            const uint64_t before = sequence.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                for (size_t i = 0; i < WordCount; i++)
+                    buffer[i] = words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before) {
+                    std::memcpy(&value, buffer, sizeof(T));
+                    return before / 2;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    /*!
+     * \brief Number of completed store() calls, a cheap way to poll for a new value
+     */
+    uint64_t getVersion() const { return sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint64_t> sequence{ 0 };
+    std::atomic<uint64_t> words[WordCount];
+};
+
+}
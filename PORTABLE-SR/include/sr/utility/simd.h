@@ -0,0 +1,54 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+namespace SR {
+
+/*!
+ * \brief Instruction sets used by the vectorized kernels of the portable components
+ *
+ * \ingroup API
+ */
+enum class SIMDLevel : int {
+    Scalar = 0, //!< Portable C++, one element per operation
+    SSE2   = 1, //!< x86, 4 floats per operation
+    AVX2   = 2, //!< x86, 8 floats per operation
+    AVX512 = 3, //!< x86 AVX-512F, 16 floats per operation
+    NEON   = 4, //!< ARMv8, 4 floats per operation
+};
+
+/*!
+ * \brief Returns the widest instruction set supported by the build and the running CPU
+ */
+SIMDLevel getSupportedSIMDLevel();
+
+/*!
+ * \brief Returns the instruction set currently used by the vectorized kernels
+ *
+ * Defaults to getSupportedSIMDLevel().
+ */
+SIMDLevel getSIMDLevel();
+
+/*!
+ * \brief Selects the instruction set used by the vectorized kernels, for instance to benchmark against the scalar path
+ *
+ * All levels produce bit-exact identical results.
+ *
+ * \param level to use from now on
+ * \return false if the level is not available on this CPU, the current level is kept in that case
+ */
+bool setSIMDLevel(SIMDLevel level);
+
+/*!
+ * \brief Returns whether an instruction set is available on this CPU
+ */
+bool isSIMDLevelSupported(SIMDLevel level);
+
+/*!
+ * \brief Returns a readable name of an instruction set, for example "avx2"
+ */
+const char* getSIMDLevelName(SIMDLevel level);
+
+}
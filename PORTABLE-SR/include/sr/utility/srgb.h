@@ -0,0 +1,52 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SR {
+
+/*!
+ * \file
+ * \brief Table driven conversions between 8-bit sRGB and linear values, as applied by setShaderSRGBConversion()
+ *
+ * All conversions return exactly what the IEC 61966-2-1 formulas evaluated with single precision pow() return, only
+ * without evaluating pow() per sample. Decoding uses a table per input value. Encoding compares against the 255
+ * exact decision thresholds between consecutive codes, located through a small table indexed by the float exponent
+ * and upper mantissa bits. Linear values are clamped to [0, 1], NaN encodes to 0.
+ *
+ * The row functions use gathers on AVX2 and AVX-512, see SR::setSIMDLevel(), and produce the same result on every
+ * instruction set.
+ */
+
+/*!
+ * \brief Decodes an 8-bit sRGB value to linear
+ *
+ * \ingroup API
+ */
+float srgbToLinear(uint8_t value);
+
+/*!
+ * \brief Encodes a linear value to 8-bit sRGB
+ */
+uint8_t linearToSrgb(float value);
+
+/*!
+ * \brief Decodes an 8-bit sRGB value to a linear binary16 value, see SR::halfToFloat()
+ */
+uint16_t srgbToLinearHalf(uint8_t value);
+
+/*!
+ * \brief Encodes a linear binary16 value to 8-bit sRGB through a single 64 KiB table lookup
+ */
+uint8_t linearHalfToSrgb(uint16_t value);
+
+void srgbToLinearRow(const uint8_t* in, float* out, size_t count);
+void linearToSrgbRow(const float* in, uint8_t* out, size_t count);
+void srgbToLinearHalfRow(const uint8_t* in, uint16_t* out, size_t count);
+void linearHalfToSrgbRow(const uint16_t* in, uint8_t* out, size_t count);
+
+}
@@ -0,0 +1,123 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sr/weaver/WeaverTypes.h"
+
+namespace SR
+{
+    /*!
+     * \brief Encoding of the pixels in a correction texture cache file.
+     */
+    enum class CorrectionTextureCompression : uint32_t
+    {
+        None  = 0, ///< Pixels are stored as decoded, the mapped file is used directly without copying
+        Delta = 1, ///< Pixels are stored as run-length encoded differences to the previous pixel, lossless
+    };
+
+    /*!
+     * \brief Correction texture that is served from a memory-mapped cache file.
+     *
+     * The pixel layout is the same as the buffer returned by Dimenco::Weaver::LoadTexture(). Uncompressed textures
+     * point straight into the read-only shared mapping, so all processes using the same cache file share one copy.
+     * Compressed textures are decoded into memory owned by this object.
+     *
+     * \ingroup API
+     */
+    class CorrectionTexture
+    {
+    public:
+        CorrectionTexture();
+        ~CorrectionTexture();
+        CorrectionTexture(CorrectionTexture&& other) noexcept;
+        CorrectionTexture& operator=(CorrectionTexture&& other) noexcept;
+
+        CorrectionTexture(const CorrectionTexture&) = delete;
+        CorrectionTexture& operator=(const CorrectionTexture&) = delete;
+
+        /*!
+         * \brief Pixels of the texture, valid as long as this object lives, nullptr when nothing is loaded
+         */
+        const unsigned char* getData() const;
+
+        int getWidth() const;
+        int getHeight() const;
+        int getChannels() const;
+        int getBitsPerPixel() const;
+        size_t getSize() const;
+
+        /*!
+         * \brief True when the pixels are read from the shared mapping, false when they were decoded into private memory
+         */
+        bool isShared() const;
+
+    private:
+        friend class CorrectionTextureStore;
+
+        class Impl;
+        std::unique_ptr<Impl> pimpl;
+    };
+
+    /*!
+     * \brief On-disk cache of decoded correction textures.
+     *
+     * Decoding CorrectionA and CorrectionB through Dimenco::Weaver::LoadTexture() allocates and decodes the textures on
+     * every call, in every process. The store keeps them in a directory as files with a page-aligned payload that
+     * are memory-mapped read-only, so loading a cached uncompressed texture costs reading its pages once to verify the
+     * checksum, and no copy.
+     *
+     * Files are identified by texture type, vertical flip and a caller supplied key that identifies the calibration,
+     * for instance WeaverDisplayGeometry::identifier. Files are replaced atomically, so concurrent processes can
+     * populate and read the same directory.
+     *
+     * \ingroup API
+     */
+    class CorrectionTextureStore
+    {
+    public:
+        /*!
+         * \param directory Existing directory that holds the cache files
+         */
+        explicit CorrectionTextureStore(std::string directory);
+
+        /*!
+         * \brief Path of the cache file of a texture
+         */
+        std::string getPath(WeaverTextureType type, uint64_t key, bool flipVertical) const;
+
+        /*!
+         * \brief Writes a decoded texture to the store, replacing an older file.
+         * \param texture Pixels as returned by Dimenco::Weaver::LoadTexture()
+         * \return WeaverSuccess, WeaverTextureUnknownPixelFormat for an invalid description or WeaverTextureFailedToLoad
+         *         if the file could not be written
+         */
+        WeaverErrorCode store(WeaverTextureType type, uint64_t key, bool flipVertical, const unsigned char* texture, int width, int height,
+            int channels, int bitsPerPixel, CorrectionTextureCompression compression) const;
+
+        /*!
+         * \brief Maps a texture from the store.
+         * \return WeaverSuccess, WeaverTextureNotFound if the texture is not cached or WeaverTextureFailedToLoad if the
+         *         cache file is damaged, which includes pixels that do not match the checksum of either compression
+         */
+        WeaverErrorCode load(WeaverTextureType type, uint64_t key, bool flipVertical, CorrectionTexture& texture) const;
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+        /*!
+         * \brief Maps a texture from the store, decoding it through Dimenco::Weaver::LoadTexture() and storing it first when it
+         *        is not cached yet.
+         */
+        WeaverErrorCode loadOrDecode(WeaverTextureType type, uint64_t key, bool flipVertical, CorrectionTexture& texture,
+            CorrectionTextureCompression compression = CorrectionTextureCompression::None) const;
+#endif
+
+    private:
+        std::string directory;
+    };
+}
@@ -0,0 +1,25 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+namespace SR
+{
+    /*!
+     * \brief Pixel formats accepted by the CPU weaver and the CPU anti-crosstalk stage.
+     */
+    enum class CPUPixelFormat
+    {
+        RGBA8,   ///< 8 bits per channel, red in the lowest byte
+        RGBA16F, ///< IEEE 754 binary16 per channel, red first, always linear
+    };
+
+    /*!
+     * \brief Returns the size of a pixel of \p format in bytes
+     */
+    inline int getCPUPixelSize(CPUPixelFormat format)
+    {
+        return format == CPUPixelFormat::RGBA16F ? 8 : 4;
+    }
+}
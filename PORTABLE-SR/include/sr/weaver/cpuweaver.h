@@ -0,0 +1,213 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "sr/types.h"
+#include "sr/weaver/WeaverTypes.h"
+#include "sr/weaver/IWeaverBase.h"
+#include "sr/weaver/cpupixelformat.h"
+#include "sr/weaver/crosstalk.h"
+#include "sr/weaver/lensparameters.h"
+
+namespace SR
+{
+    /*!
+     * \brief class to be used for weaving side-by-side images in system memory, without a graphics device
+     *
+     * The weaver interleaves the left and right half of the input view buffer into the output buffer.
+     * Output pixels are mapped to panel pixels through setScreenRect(), the user position is set through setEyePositions().
+     * weave() weaves the full output buffer, the other weave(...) functions weave a region of it.
+     * Every combination of pixel formats, sRGB conversion, anti-crosstalk, contrast and fallback behavior runs its own
+     * compiled row function, which reads every source pixel once.
+     * setShaderSRGBConversion() applies to RGBA8 buffers, RGBA16F buffers are always linear.
+     * Weaving is deterministic: identical inputs and settings produce bit-exact identical output on every platform.
+     *
+     * \ingroup API
+     */
+    class ICPUWeaver1 : public virtual IDestroyable, public virtual IQueryInterface, public virtual IWeaverBase1
+    {
+    public:
+
+        using IWeaverBase1::weave;
+
+        /*!
+         * \brief Sets the side-by-side view buffer that will be used for weaving.
+         * \param data Pointer to the first row of the buffer, must stay valid while weaving
+         * \param width Width of the buffer, containing both views
+         * \param height Height of the buffer
+         * \param rowPitch Distance in bytes between the start of two rows
+         * \param format Pixel format of the buffer
+         * \throw std::invalid_argument if the buffer description is invalid
+         */
+        virtual void setInputViewBuffer(const void* data, int width, int height, int rowPitch, CPUPixelFormat format) = 0;
+
+        /*!
+         * \brief Sets the buffer that the woven image is written to.
+         * \param data Pointer to the first row of the buffer, must stay valid while weaving
+         * \param width Width of the buffer
+         * \param height Height of the buffer
+         * \param rowPitch Distance in bytes between the start of two rows
+         * \param format Pixel format of the buffer
+         * \throw std::invalid_argument if the buffer description is invalid
+         */
+        virtual void setOutputBuffer(void* data, int width, int height, int rowPitch, CPUPixelFormat format) = 0;
+
+        /*!
+         * \brief Sets the position of the output buffer on the SR panel, in panel pixels.
+         * By default the output buffer covers the panel starting at its top-left corner.
+         * \param x Horizontal position of the first output column
+         * \param y Vertical position of the first output row
+         */
+        virtual void setScreenRect(int x, int y) = 0;
+
+        /*!
+         * \brief Sets the location of the SR display on the desktop, as returned by IDisplay::getLocation().
+         *
+         * The weaver caches the panel dependent part of the lens phase per woven region, screen rect and display.
+         * A changed location, e.g. after the display configuration changed, discards the cached phase of the old location.
+         * \param location Rectangle of the display in desktop coordinates
+         */
+        virtual void setDisplayLocation(const SR_recti& location) = 0;
+
+        /*!
+         * \brief Sets the eye positions to weave for, in millimeters in display coordinates.
+         * \param left 3D vector of the left eye position.
+         * \param right 3D vector of the right eye position.
+         */
+        virtual void setEyePositions(const float left[3], const float right[3]) = 0;
+
+        /*!
+         * \brief Sets the refresh rate used to convert setLatencyInFrames() into microseconds.
+         * \param refreshRate Refresh rate in Hz, 60 by default
+         */
+        virtual void setRefreshRate(double refreshRate) = 0;
+
+        /*!
+         * \brief Sets the number of threads used for weaving.
+         *
+         * The woven region is split into 64x64 tiles that are scheduled over a persistent work-stealing pool,
+         * the calling thread takes part in weaving.
+         *
+         * \param threadCount Number of threads, 0 selects the number of hardware threads
+         */
+        virtual void setThreadCount(unsigned int threadCount) = 0;
+
+        /*!
+         * \brief Sets the anti-crosstalk mode, see CrosstalkParameters. Off by default.
+         */
+        virtual void setACTMode(WeaverACTMode mode) = 0;
+
+        /*!
+         * \brief Gets the anti-crosstalk mode.
+         */
+        virtual WeaverACTMode getACTMode() const = 0;
+
+        /*!
+         * \brief Sets the anti-crosstalk factor, clamped to [0, CrosstalkParameters::maximumFactor].
+         */
+        virtual void setCrosstalkStaticFactor(float factor) = 0;
+
+        /*!
+         * \brief Gets the anti-crosstalk factor.
+         */
+        virtual float getCrosstalkStaticFactor() const = 0;
+
+        /*!
+         * \brief Sets the anti-crosstalk dynamic factor, clamped to [0, CrosstalkParameters::maximumFactor].
+         */
+        virtual void setCrosstalkDynamicFactor(float factor) = 0;
+
+        /*!
+         * \brief Gets the anti-crosstalk dynamic factor.
+         */
+        virtual float getCrosstalkDynamicFactor() const = 0;
+
+        /*!
+         * \brief Sets the weaving contrast, clamped to [0, 1].
+         * 1, the default, separates the views as far as the lens allows, 0 shows the average of both views everywhere.
+         */
+        virtual void setContrast(float contrast) = 0;
+
+        /*!
+         * \brief Gets the current weaving contrast.
+         */
+        virtual float getContrast() const = 0;
+
+        /*!
+         * \brief Sets what is shown while setTracking(false) is in effect, BehaviorWhenNotTracking::Default by default.
+         *
+         * ShowLeft shows the left view on both eyes. ShowLeftWithShader additionally dims it to half brightness,
+         * so the user notices that tracking was lost.
+         */
+        virtual void setBehaviorWhenNotTracking(BehaviorWhenNotTracking behavior) = 0;
+
+        /*!
+         * \brief Gets what is shown while tracking is lost.
+         */
+        virtual BehaviorWhenNotTracking getBehaviorWhenNotTracking() const = 0;
+
+        /*!
+         * \brief Sets whether the eye positions passed to setEyePositions() currently come from a tracked face.
+         * \param tracking false while the eye tracker has lost the user, true by default
+         */
+        virtual void setTracking(bool tracking) = 0;
+
+        /*!
+         * \brief Used to determine if weaving is possible for a certain size of the output buffer
+         * \param width of the image to be rendered to the output buffer
+         * \param height of the image to be rendered to the output buffer
+         * \returns bool indicating whether input and output buffers are set and the region fits in the output buffer
+         */
+        virtual bool canWeave(unsigned int width, unsigned int height) = 0;
+
+        /*!
+         * \brief Used to determine if weaving is possible for a certain region of the output buffer
+         * \param width of the image to be rendered to the output buffer
+         * \param height of the image to be rendered to the output buffer
+         * \param xOffset of the image to be rendered to the output buffer
+         * \param yOffset of the image to be rendered to the output buffer
+         * \returns bool indicating whether input and output buffers are set and the region fits in the output buffer
+         */
+        virtual bool canWeave(unsigned int width, unsigned int height, unsigned int xOffset, unsigned int yOffset) = 0;
+
+        /*!
+         * \brief Renders a woven image of a certain size to the top-left corner of the output buffer
+         * \param width of the image to be rendered to the output buffer
+         * \param height of the image to be rendered to the output buffer
+         */
+        virtual void weave(unsigned int width, unsigned int height) = 0;
+
+        /*!
+         * \brief Renders a woven image of a certain size to a region of the output buffer
+         * The full input view buffer is scaled to the region, pixels outside of the region are left untouched.
+         * \param width of the image to be rendered to the output buffer
+         * \param height of the image to be rendered to the output buffer
+         * \param xOffset of the image to be rendered to the output buffer
+         * \param yOffset of the image to be rendered to the output buffer
+         */
+        virtual void weave(unsigned int width, unsigned int height, unsigned int xOffset, unsigned int yOffset) = 0;
+
+    protected:
+        ICPUWeaver1() = default;
+        virtual ~ICPUWeaver1() = default;
+
+        ICPUWeaver1(const ICPUWeaver1&) = delete;
+        ICPUWeaver1& operator=(const ICPUWeaver1&) = delete;
+        ICPUWeaver1(ICPUWeaver1&&) = delete;
+        ICPUWeaver1& operator=(ICPUWeaver1&&) = delete;
+    };
+
+    /*!
+     * \brief Creates a new CPU weaver.
+     *
+     * \param lens Lens parameters to weave with
+     * \param display Geometry of the panel that is woven for
+     * \param weaver Pointer to created weaver, if successful
+     * \throw std::invalid_argument if lens or display parameters are invalid
+     * \returns WeaverErrorCode Success or error code
+     */
+    WeaverErrorCode CreateCPUWeaver(const WeaverLensParameters& lens, const WeaverDisplayGeometry& display, ICPUWeaver1** weaver);
+}
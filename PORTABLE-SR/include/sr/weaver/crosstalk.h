@@ -0,0 +1,53 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include "sr/weaver/WeaverTypes.h"
+#include "sr/weaver/cpupixelformat.h"
+
+namespace SR
+{
+    /*!
+     * \brief Anti-crosstalk (ACT) settings of the CPU weaver, see DX11WeaverBase::setACTMode().
+     *
+     * The lens leaks a fraction k of the other view into every view. ACT subtracts that leakage in advance, in linear light:
+     * left' = max((left - k * right) / (1 - k), 0), and likewise for the right view. Identical views pass unchanged.
+     *
+     * WeaverACTMode::Static uses k = staticFactor for every sample. WeaverACTMode::Dynamic adds dynamicFactor * |left - right|
+     * per channel, so disparity edges, where ghosting is most visible, are compensated harder than flat areas.
+     * This costs a division per sample instead of a multiplication.
+     *
+     * \ingroup API
+     */
+    struct CrosstalkParameters
+    {
+        static constexpr float maximumFactor = 0.5f; //!< Upper limit of both factors and of the resulting k
+
+        WeaverACTMode mode  = WeaverACTMode::Off;
+        float staticFactor  = 0.0f; //!< Leakage present everywhere, clamped to [0, maximumFactor]
+        float dynamicFactor = 0.0f; //!< Leakage per unit of difference between the views, clamped to [0, maximumFactor]
+    };
+
+    /*!
+     * \brief Applies anti-crosstalk to a side-by-side view buffer, the left view in the left half.
+     *
+     * The CPU weaver applies the same compensation while weaving, so this is only needed to inspect or store the compensated views.
+     * Uses the instruction set selected through SR::setSIMDLevel(), the result is bit-exact identical for every instruction set.
+     * Alpha is copied unchanged.
+     *
+     * \param parameters Mode and factors to apply
+     * \param input Pointer to the first row of the side-by-side buffer
+     * \param width Width of the buffer, containing both views
+     * \param height Height of the buffer
+     * \param inputRowPitch Distance in bytes between the start of two input rows
+     * \param output Pointer to the first row of the compensated buffer of the same size and format, may equal \p input
+     * \param outputRowPitch Distance in bytes between the start of two output rows
+     * \param format Pixel format of both buffers
+     * \param srgb Whether RGBA8 values are sRGB encoded and are converted to linear light and back, ignored for RGBA16F
+     * \throw std::invalid_argument if the buffer description is invalid
+     */
+    void compensateCrosstalk(const CrosstalkParameters& parameters, const void* input, int width, int height, int inputRowPitch,
+        void* output, int outputRowPitch, CPUPixelFormat format, bool srgb);
+}
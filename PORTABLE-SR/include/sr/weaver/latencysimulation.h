@@ -0,0 +1,68 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "sr/sense/eyetracker/eyepredictor.h"
+#include "sr/utility/eyetrajectory.h"
+
+namespace SR
+{
+    /*!
+     * \brief Timing of a simulated display pipeline and eye tracker, see simulateLatency().
+     *
+     * weave() is called renderOffset frames after every vsync. The frame reaches the viewer pipelineFrames frames after
+     * the weave() call, this is the property of the machine that setLatencyInFrames() should match. latencyInFrames is the value passed
+     * to setLatencyInFrames(): the weaver predicts the eye position to weave() plus latencyInFrames frames.
+     *
+     * \ingroup API
+     */
+    struct LatencySimulationSettings
+    {
+        double refreshRate = 60.0;     //!< Vsync rate in Hz
+        uint64_t pipelineFrames = 2;   //!< Frames from the weave() call until the frame is visible
+        uint64_t latencyInFrames = 2;  //!< As passed to IWeaverBase1::setLatencyInFrames()
+        double renderOffset = 0.25;    //!< Time from vsync to the weave() call, in frames
+        double lateLatchLead = 0.5;    //!< Time from the late latch until the frame is visible, in frames
+        double trackerRate = 60.0;     //!< Eye tracker samples per second
+        double trackerLatency = 0.03;  //!< Seconds from capturing a tracker sample until it is available
+        float trackerNoise = 0.0f;     //!< Standard deviation of the tracker measurement noise in mm
+        uint32_t seed = 1;             //!< Seed of the tracker noise, runs with equal settings give equal results
+        EyePredictorSettings predictor; //!< Motion model that extrapolates the tracker samples
+    };
+
+    /*!
+     * \brief Photon-time eye position error of a simulation run, in millimeters.
+     */
+    struct LatencySimulationResult
+    {
+        uint64_t frames = 0;
+        double rmsError = 0.0;
+        double percentile95Error = 0.0;
+        double maximumError = 0.0;
+        double meanHorizon = 0.0;      //!< Mean time from the capture of the newest used sample to the photon time, in seconds
+    };
+
+    /*!
+     * \brief Simulates a display pipeline on a virtual clock and measures the eye position error at photon time.
+     *
+     * Every frame passes the newest available tracker samples to an EyePredictor and predicts the eye positions at
+     * weave() plus latencyInFrames frames, just like the weaver prediction. Without late latching the
+     * samples are read at the weave() call. With late latching they are read again lateLatchLead frames before the
+     * frame is visible, which shortens the extrapolation when newer samples arrived in between. The error is the
+     * distance between the extrapolated position and the trajectory when the frame becomes visible. Frames whose weave()
+     * has fewer than two samples are skipped in both modes, so runs with and without late latching cover the same frames.
+     *
+     * The simulation does not depend on wall clock time and is deterministic.
+     *
+     * \param settings Timing of the pipeline and the tracker
+     * \param trajectory Movement of the viewer, simulated from 0 to its duration
+     * \param lateLatching Whether the eye position is latched again before the frame is visible
+     * \throw std::invalid_argument if a rate is not positive, the late latch would happen before the weave() call or the
+     *        predictor settings are invalid
+     */
+    LatencySimulationResult simulateLatency(const LatencySimulationSettings& settings, const EyeTrajectory& trajectory, bool lateLatching);
+}
@@ -0,0 +1,72 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace SR
+{
+    class IDisplay;
+
+    /*!
+     * \brief Lens and view filter parameters used by the portable weavers.
+     *
+     * Mirrors the values exposed by Dimenco::Weaver. The default values describe a generic slanted lens panel
+     * and are only meant for offline experiments, use fromDimencoWeaver() to obtain the calibrated values of a device.
+     *
+     * \ingroup API
+     */
+    struct WeaverLensParameters
+    {
+        float slant       = 0.1667f; //!< Slant as a coefficient, see Dimenco::Weaver::GetSlant()
+        float px          = 6.0f;    //!< Lens pitch in x direction in pixels, see Dimenco::Weaver::GetPx()
+        float n           = 1.5f;    //!< Refractive index of the lens stack, see Dimenco::Weaver::GetN()
+        float doN         = 2.5f;    //!< Lens gap D over refractive index N in millimeters, see Dimenco::Weaver::GetDoN()
+        float pattern     = 0.0f;    //!< Phase offset of the lens pattern in lens periods, see Dimenco::Weaver::GetPattern()
+        float filterWidth = 0.1f;    //!< Width of the view transition in lens periods, see Dimenco::Weaver::GetFilterWidth()
+        float filterSlope = 1.0f;    //!< Steepness of the view transition, see Dimenco::Weaver::GetFilterSlope()
+
+        /*!
+         * \brief Returns whether the parameters describe a usable lens.
+         */
+        bool isValid() const;
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+        /*!
+         * \brief Reads the calibrated parameters of the connected device from Dimenco::Weaver.
+         * Dimenco::Weaver::SetGlobalParameters() should have been called before.
+         */
+        static WeaverLensParameters fromDimencoWeaver();
+#endif
+    };
+
+    /*!
+     * \brief Geometry of the SR panel that is woven for.
+     *
+     * Positions are expressed in panel pixels, the origin of the physical coordinate system is at the center of the display.
+     *
+     * \ingroup API
+     */
+    struct WeaverDisplayGeometry
+    {
+        uint64_t identifier   = 0;        //!< Identifier of the display, see IDisplay::identifier()
+        int resolutionWidth   = 3840;     //!< Horizontal resolution accepted by the display
+        int resolutionHeight  = 2160;     //!< Vertical resolution accepted by the display
+        float dotPitch        = 0.00896f; //!< Dot pitch (pixel size) in cm, see IDisplay::getDotPitch()
+
+        /*!
+         * \brief Returns whether the geometry describes a usable display.
+         */
+        bool isValid() const;
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+        /*!
+         * \brief Reads the geometry of an SR display.
+         * \param display Display to read the geometry from
+         */
+        static WeaverDisplayGeometry fromDisplay(const IDisplay& display);
+#endif
+    };
+}
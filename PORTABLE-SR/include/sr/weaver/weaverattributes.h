@@ -0,0 +1,62 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include "sr/weaver/WeaverTypes.h"
+
+namespace SR
+{
+    /*!
+     * \brief Affine interpolators of the weaver vertex attributes, as produced by FillInterpolators() in WeaverC.h.
+     *
+     * Every attribute channel is evaluated at pixel (x, y) as (offset + scaleY * y) + scaleX * x.
+     *
+     * \ingroup API
+     */
+    struct WeaverInterpolators
+    {
+        FLOAT4 phasesOffset,     phasesScaleX,     phasesScaleY;
+        FLOAT4 dxyOffset,        dxyScaleX,        dxyScaleY;
+        FLOAT2 screenPosOffset,  screenPosScaleX,  screenPosScaleY;
+        FLOAT2 weaverVarsOffset, weaverVarsScaleX, weaverVarsScaleY;
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+        /*!
+         * \brief Reads the interpolators of the calibrated weaver from FillInterpolators().
+         * \param textureRes Size of the back buffer
+         */
+        static WeaverInterpolators fromDimencoWeaver(const FLOAT2& textureRes);
+#endif
+    };
+
+    /*!
+     * \brief Structure-of-arrays destination for a row of weaver attributes.
+     *
+     * Each pointer receives one float per pixel. Channels that are not needed can be left nullptr and are skipped.
+     *
+     * \ingroup API
+     */
+    struct WeaverAttributeRow
+    {
+        float* phases[4]     = {}; //!< x, y, z and w channel of the phases attribute
+        float* dxy[4]        = {}; //!< x, y, z and w channel of the dxy attribute
+        float* screenPos[2]  = {}; //!< x and y channel of the ScreenPos attribute
+        float* weaverVars[2] = {}; //!< x and y channel of the WeaverVars attribute
+    };
+
+    /*!
+     * \brief Fills a row of weaver attributes, the batched equivalent of Dimenco::Weaver::FillAttributes().
+     *
+     * Uses the instruction set selected through SR::setSIMDLevel(), processing up to 16 pixels per instruction.
+     * The result is bit-exact identical for every instruction set.
+     *
+     * \param interpolators Interpolators to evaluate
+     * \param y Row to evaluate
+     * \param x First column to evaluate
+     * \param count Number of pixels to evaluate
+     * \param row Destination channels, each with room for \p count floats
+     */
+    void fillAttributeRow(const WeaverInterpolators& interpolators, int y, int x, int count, const WeaverAttributeRow& row);
+}
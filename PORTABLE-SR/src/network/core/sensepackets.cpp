@@ -0,0 +1,756 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/network/core/sensepackets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace SR {
+
+namespace {
+
+constexpr uint64_t eventHeaderSize = 2 * sizeof(uint64_t);
+constexpr uint64_t typeMask = 0xffffffff;
+constexpr double positionScale = 100.0;    // Fixed point steps per mm
+constexpr double orientationScale = 1e5;   // Fixed point steps per radian
+constexpr uint64_t notFinite = uint64_t(1) << 63; // Fixed point of NaN and infinity, beyond every clamped value
+constexpr uint8_t keyFrameFlag = 1;
+
+enum class Result {
+    Decoded,
+    Skipped,
+    Malformed,
+};
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t*& data, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && data != end; shift += 7) {
+        const uint8_t byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Small differences of either sign become small varints, in two's complement arithmetic on uint64_t
+uint64_t zigzag(uint64_t value)
+{
+    return (value << 1) ^ (0 - (value >> 63));
+}
+
+uint64_t unzigzag(uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+uint64_t toFixed(double value, double scale)
+{
+    if (!std::isfinite(value))
+        return notFinite;
+    const double limit = 4e18;
+    return static_cast<uint64_t>(std::llround(std::max(-limit, std::min(limit, value * scale))));
+}
+
+double fromFixed(uint64_t value, double scale)
+{
+    if (value == notFinite)
+        return std::numeric_limits<double>::quiet_NaN();
+    return static_cast<double>(static_cast<int64_t>(value)) / scale;
+}
+
+// Integers and fixed point values of one frame, in the order they are written
+struct Fields {
+    uint64_t integers[8] = {};
+    uint64_t values[63] = {};
+    int integerCount = 0;
+    int valueCount = 0;
+
+    void addInteger(uint64_t value) { integers[integerCount++] = value; }
+
+    void addPoints(const SR_point3d* points, int count, double scale)
+    {
+        for (int i = 0; i < count; i++)
+            for (double coordinate : points[i].p)
+                values[valueCount++] = toFixed(coordinate, scale);
+    }
+
+    uint64_t getInteger() { return integers[integerCount++]; }
+
+    void getPoints(SR_point3d* points, int count, double scale)
+    {
+        for (int i = 0; i < count; i++)
+            for (double& coordinate : points[i].p)
+                coordinate = fromFixed(values[valueCount++], scale);
+    }
+};
+
+// Number of integers and values of each frame type
+template <class Frame>
+struct Layout;
+
+template <>
+struct Layout<SR_eyePair> {
+    static constexpr int integers = 2;
+    static constexpr int values = 6;
+};
+
+template <>
+struct Layout<SR_head> {
+    static constexpr int integers = 8;
+    static constexpr int values = 18;
+};
+
+template <>
+struct Layout<SR_handPose> {
+    static constexpr int integers = 4;
+    static constexpr int values = 63;
+};
+
+void flatten(const SR_eyePair& frame, Fields& fields)
+{
+    fields.addInteger(frame.frameId);
+    fields.addInteger(frame.time);
+    fields.addPoints(frame.eyes, 2, positionScale);
+}
+
+void unflatten(Fields& fields, SR_eyePair& frame)
+{
+    frame.frameId = fields.getInteger();
+    frame.time = fields.getInteger();
+    fields.getPoints(frame.eyes, 2, positionScale);
+}
+
+void flatten(const SR_head& frame, Fields& fields)
+{
+    for (uint64_t value : { frame.frameId, frame.time, frame.headPose.frameId, frame.headPose.time, frame.eyes.frameId, frame.eyes.time,
+             frame.ears.frameId, frame.ears.time })
+        fields.addInteger(value);
+    fields.addPoints(&frame.headPose.position, 1, positionScale);
+    fields.addPoints(&frame.headPose.orientation, 1, orientationScale);
+    fields.addPoints(frame.eyes.eyes, 2, positionScale);
+    fields.addPoints(frame.ears.ears, 2, positionScale);
+}
+
+void unflatten(Fields& fields, SR_head& frame)
+{
+    for (uint64_t* value : { &frame.frameId, &frame.time, &frame.headPose.frameId, &frame.headPose.time, &frame.eyes.frameId,
+             &frame.eyes.time, &frame.ears.frameId, &frame.ears.time })
+        *value = fields.getInteger();
+    fields.getPoints(&frame.headPose.position, 1, positionScale);
+    fields.getPoints(&frame.headPose.orientation, 1, orientationScale);
+    fields.getPoints(frame.eyes.eyes, 2, positionScale);
+    fields.getPoints(frame.ears.ears, 2, positionScale);
+}
+
+void flatten(const SR_handPose& frame, Fields& fields)
+{
+    for (uint64_t value : { frame.frameId, frame.time, frame.handId, static_cast<uint64_t>(frame.side) })
+        fields.addInteger(value);
+    fields.addPoints(frame.joints, 21, positionScale);
+}
+
+void unflatten(Fields& fields, SR_handPose& frame)
+{
+    frame.frameId = fields.getInteger();
+    frame.time = fields.getInteger();
+    frame.handId = fields.getInteger();
+    frame.side = static_cast<SR_handSide>(fields.getInteger());
+    fields.getPoints(frame.joints, 21, positionScale);
+}
+
+// Previous frame of one stream, the encoder and the decoder keep the same
+struct Stream {
+    bool valid = false;
+    bool keyRequested = false;
+    uint64_t sequence = 0;
+    uint32_t sinceKey = 0; //!< Frames since the last key frame
+    Fields previous;
+};
+
+// Streams of every frame type, hand poses have one per side since both hands of a frame follow each other
+struct Streams {
+    Stream eyePair;
+    Stream head;
+    Stream hands[2];
+
+    Stream& get(const SR_eyePair&, size_t) { return eyePair; }
+    Stream& get(const SR_head&, size_t) { return head; }
+    Stream& get(const SR_handPose&, size_t index) { return hands[index]; }
+};
+
+size_t getStreamIndex(const SR_eyePair&) { return 0; }
+size_t getStreamIndex(const SR_head&) { return 0; }
+size_t getStreamIndex(const SR_handPose& frame) { return frame.side == RightHand ? 1 : 0; }
+
+// The header is the sequence number and a flags byte, with the key frame flag and the stream index above it
+class CompactEncoder {
+public:
+    explicit CompactEncoder(uint32_t keyFrameInterval) : keyFrameInterval(keyFrameInterval) {}
+
+    template <class Frame>
+    void encode(const Frame& frame, std::vector<uint8_t>& out)
+    {
+        const size_t index = getStreamIndex(frame);
+        Stream& stream = streams.get(frame, index);
+        Fields fields;
+        flatten(frame, fields);
+        const bool key = !stream.valid || stream.keyRequested || stream.sinceKey >= keyFrameInterval;
+        stream.sequence = stream.valid ? stream.sequence + 1 : 0;
+        out.clear();
+        putVarint(out, stream.sequence);
+        out.push_back(static_cast<uint8_t>((key ? keyFrameFlag : 0) | index << 1));
+        static const Fields zero;
+        const Fields& base = key ? zero : stream.previous;
+        for (int i = 0; i < fields.integerCount; i++)
+            putVarint(out, zigzag(fields.integers[i] - base.integers[i]));
+        for (int i = 0; i < fields.valueCount; i++)
+            putVarint(out, zigzag(fields.values[i] - base.values[i]));
+        stream.previous = fields;
+        stream.valid = true;
+        stream.keyRequested = false;
+        stream.sinceKey = key ? 1 : stream.sinceKey + 1;
+    }
+
+    void requestKeyFrame()
+    {
+        for (Stream* stream : { &streams.eyePair, &streams.head, &streams.hands[0], &streams.hands[1] })
+            stream->keyRequested = true;
+    }
+
+private:
+    const uint32_t keyFrameInterval;
+    Streams streams;
+};
+
+class CompactDecoder {
+public:
+    template <class Frame>
+    Result decode(const uint8_t* data, uint64_t size, Frame& frame)
+    {
+        const uint8_t* end = data + size;
+        uint64_t sequence = 0;
+        if (!getVarint(data, end, sequence) || data == end)
+            return Result::Malformed;
+        const uint8_t flags = *data++;
+        const size_t index = flags >> 1;
+        if (index >= (std::is_same<Frame, SR_handPose>::value ? 2 : 1))
+            return Result::Malformed;
+        Stream& stream = streams.get(frame, index);
+        const bool key = (flags & keyFrameFlag) != 0;
+        if (!key && (!stream.valid || sequence != stream.sequence + 1)) {
+            // A frame is missing, every delta until the next key frame would be wrong
+            stream.valid = false;
+            return Result::Skipped;
+        }
+
+        static const Fields zero;
+        const Fields& base = key ? zero : stream.previous;
+        Fields fields;
+        fields.integerCount = Layout<Frame>::integers;
+        fields.valueCount = Layout<Frame>::values;
+        uint64_t value = 0;
+        for (int i = 0; i < fields.integerCount; i++) {
+            if (!getVarint(data, end, value)) {
+                stream.valid = false;
+                return Result::Malformed;
+            }
+            fields.integers[i] = base.integers[i] + unzigzag(value);
+        }
+        for (int i = 0; i < fields.valueCount; i++) {
+            if (!getVarint(data, end, value)) {
+                stream.valid = false;
+                return Result::Malformed;
+            }
+            fields.values[i] = base.values[i] + unzigzag(value);
+        }
+        stream.previous = fields;
+        stream.sequence = sequence;
+        stream.valid = true;
+        fields.integerCount = fields.valueCount = 0;
+        unflatten(fields, frame);
+        return Result::Decoded;
+    }
+
+private:
+    Streams streams;
+};
+
+// Copies the frame out of the packet, the payload is only 8 byte aligned and may be longer than the frame
+template <class Frame>
+Result decodeRaw(const uint8_t* data, uint64_t size, Frame& frame)
+{
+    if (size < sizeof(Frame))
+        return Result::Malformed;
+    std::memcpy(&frame, data, sizeof(frame));
+    return Result::Decoded;
+}
+
+Result decodeRaw(const uint8_t* data, uint64_t size, SystemEvent& event)
+{
+    if (size < eventHeaderSize)
+        return Result::Malformed;
+    uint64_t header[2];
+    std::memcpy(header, data, eventHeaderSize);
+    event.time = header[0];
+    event.eventType = static_cast<SR_eventType>(header[1]);
+    event.message.assign(reinterpret_cast<const char*>(data) + eventHeaderSize, static_cast<size_t>(size - eventHeaderSize));
+    return Result::Decoded;
+}
+
+void encodeCompact(const SystemEvent& event, std::vector<uint8_t>& out)
+{
+    out.clear();
+    putVarint(out, event.time);
+    putVarint(out, static_cast<uint64_t>(event.eventType));
+    putVarint(out, event.message.size());
+    out.insert(out.end(), event.message.begin(), event.message.end());
+}
+
+Result decodeCompact(const uint8_t* data, uint64_t size, SystemEvent& event)
+{
+    const uint8_t* end = data + size;
+    uint64_t time = 0, type = 0, length = 0;
+    if (!getVarint(data, end, time) || !getVarint(data, end, type) || !getVarint(data, end, length) ||
+        length > static_cast<uint64_t>(end - data))
+        return Result::Malformed;
+    event.time = time;
+    event.eventType = static_cast<SR_eventType>(type);
+    event.message.assign(reinterpret_cast<const char*>(data), static_cast<size_t>(length));
+    return Result::Decoded;
+}
+
+template <class Listener>
+void removeFrom(std::vector<Listener*>& listeners, Listener* listener)
+{
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+}
+
+class SensePacketWriter::Encoder : public CompactEncoder {
+public:
+    using CompactEncoder::CompactEncoder;
+};
+
+class SensePacketReader::Decoder : public CompactDecoder {
+};
+
+SensePacketWriter::SensePacketWriter(Sink sink, SensePacketEncoding encoding, uint32_t keyFrameInterval)
+    : sink(std::move(sink)), encoding(encoding), encoder(new Encoder(keyFrameInterval))
+{
+    if (keyFrameInterval == 0)
+        throw std::invalid_argument("Key frame interval must be at least 1");
+    if (encoding != SensePacketEncoding::Raw && encoding != SensePacketEncoding::Compact)
+        throw std::invalid_argument("Unknown sense packet encoding");
+}
+
+SensePacketWriter::SensePacketWriter(NetworkInterface& network, SensePacketEncoding encoding, uint32_t keyFrameInterval)
+    : SensePacketWriter([&network](uint64_t destination, void* payload, uint64_t payloadSize) { network.send(destination, payload, payloadSize); },
+          encoding, keyFrameInterval)
+{
+}
+
+SensePacketWriter::~SensePacketWriter() = default;
+
+template <class Frame>
+void SensePacketWriter::write(SensePacketType type, const Frame& frame)
+{
+    const uint64_t destination = getSensePacketDestination(type, encoding);
+    if (encoding == SensePacketEncoding::Raw) {
+        sink(destination, const_cast<Frame*>(&frame), sizeof(frame));
+    } else {
+        std::lock_guard<std::mutex> lock(mutex);
+        encoder->encode(frame, buffer);
+        sink(destination, buffer.data(), buffer.size());
+    }
+    sent.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SensePacketWriter::accept(const SR_eyePair& frame)
+{
+    write(SensePacketType::EyePair, frame);
+}
+
+void SensePacketWriter::accept(const SR_head& frame)
+{
+    write(SensePacketType::Head, frame);
+}
+
+void SensePacketWriter::accept(const SR_handPose& frame)
+{
+    write(SensePacketType::HandPose, frame);
+}
+
+void SensePacketWriter::accept(const SystemEvent& frame)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (encoding == SensePacketEncoding::Raw) {
+        const uint64_t header[2] = { frame.time, static_cast<uint64_t>(frame.eventType) };
+        buffer.resize(eventHeaderSize + frame.message.size());
+        std::memcpy(buffer.data(), header, eventHeaderSize);
+        std::memcpy(buffer.data() + eventHeaderSize, frame.message.data(), frame.message.size());
+    } else {
+        encodeCompact(frame, buffer);
+    }
+    sink(getSensePacketDestination(SensePacketType::SystemEvent, encoding), buffer.data(), buffer.size());
+    sent.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SensePacketWriter::requestKeyFrame()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    encoder->requestKeyFrame();
+}
+
+SensePacketReader::SensePacketReader()
+    : decoder(new Decoder())
+{
+}
+
+SensePacketReader::~SensePacketReader() = default;
+
+void SensePacketReader::addListener(EyePairListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    eyePairListeners.push_back(listener);
+}
+
+void SensePacketReader::removeListener(EyePairListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    removeFrom(eyePairListeners, listener);
+}
+
+void SensePacketReader::addListener(HeadListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    headListeners.push_back(listener);
+}
+
+void SensePacketReader::removeListener(HeadListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    removeFrom(headListeners, listener);
+}
+
+void SensePacketReader::addListener(HandPoseListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    handPoseListeners.push_back(listener);
+}
+
+void SensePacketReader::removeListener(HandPoseListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    removeFrom(handPoseListeners, listener);
+}
+
+void SensePacketReader::addListener(SystemEventListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    systemEventListeners.push_back(listener);
+}
+
+void SensePacketReader::removeListener(SystemEventListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    removeFrom(systemEventListeners, listener);
+}
+
+namespace {
+
+template <class Frame, class Decoder, class Listener>
+Result dispatch(SensePacketEncoding encoding, Decoder& decoder, const uint8_t* data, uint64_t size, const std::vector<Listener*>& listeners)
+{
+    Frame frame{};
+    const Result result = encoding == SensePacketEncoding::Raw ? decodeRaw(data, size, frame) : decoder.decode(data, size, frame);
+    if (result == Result::Decoded)
+        for (Listener* listener : listeners)
+            listener->accept(frame);
+    return result;
+}
+
+template <class Decoder, class Listener>
+Result dispatch(SensePacketEncoding encoding, Decoder&, const uint8_t* data, uint64_t size, const std::vector<Listener*>& listeners, SystemEvent& event)
+{
+    const Result result = encoding == SensePacketEncoding::Raw ? decodeRaw(data, size, event) : decodeCompact(data, size, event);
+    if (result == Result::Decoded)
+        for (Listener* listener : listeners)
+            listener->accept(event);
+    return result;
+}
+
+}
+
+void SensePacketReader::receive(SR_packet& packet)
+{
+    const SensePacketEncoding packetEncoding = static_cast<SensePacketEncoding>(packet.destination >> 32);
+    const SensePacketType type = static_cast<SensePacketType>(packet.destination & typeMask);
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&packet.payload);
+    const uint64_t size = packet.size - SR_packet_headerSize;
+
+    if (packetEncoding != SensePacketEncoding::Raw && packetEncoding != SensePacketEncoding::Compact) {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (type == SensePacketType::Encoding) {
+        uint64_t chosen = 0;
+        if (packetEncoding == SensePacketEncoding::Raw && size >= sizeof(chosen)) {
+            std::memcpy(&chosen, data, sizeof(chosen));
+            encoding = static_cast<SensePacketEncoding>(chosen);
+        } else {
+            rejected.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    Result result = Result::Malformed;
+    switch (type) {
+    case SensePacketType::EyePair:
+        result = dispatch<SR_eyePair>(packetEncoding, *decoder, data, size, eyePairListeners);
+        break;
+    case SensePacketType::Head:
+        result = dispatch<SR_head>(packetEncoding, *decoder, data, size, headListeners);
+        break;
+    case SensePacketType::HandPose:
+        result = dispatch<SR_handPose>(packetEncoding, *decoder, data, size, handPoseListeners);
+        break;
+    case SensePacketType::SystemEvent: {
+        SystemEvent event;
+        result = dispatch(packetEncoding, *decoder, data, size, systemEventListeners, event);
+        break;
+    }
+    default:
+        break;
+    }
+    if (result == Result::Decoded)
+        decoded.fetch_add(1, std::memory_order_relaxed);
+    else if (result == Result::Skipped)
+        skipped.fetch_add(1, std::memory_order_relaxed);
+    else
+        rejected.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SensePacketReader::print(SR_packet& packet)
+{
+    SR_packet_print(packet);
+}
+
+void SensePacketReader::requestEncoding(NetworkInterface& network, SensePacketEncoding encoding)
+{
+    uint64_t requested = static_cast<uint64_t>(encoding);
+    network.send(getSensePacketDestination(SensePacketType::Encoding, SensePacketEncoding::Raw), &requested, sizeof(requested));
+}
+
+class SensePacketPublisher::Impl {
+public:
+    Impl(TCPServer& server, Receiver* receiver, SensePacketEncoding maximumEncoding, uint32_t keyFrameInterval)
+        : server(server), receiver(receiver), maximumEncoding(maximumEncoding),
+          raw([this](uint64_t destination, void* payload, uint64_t payloadSize) { send(SensePacketEncoding::Raw, destination, payload, payloadSize); }),
+          compact([this](uint64_t destination, void* payload, uint64_t payloadSize) { send(SensePacketEncoding::Compact, destination, payload, payloadSize); },
+              SensePacketEncoding::Compact, keyFrameInterval)
+    {
+    }
+
+    // Called on the network thread of the server for every accepted connection, which starts with raw frames
+    void add(const std::shared_ptr<TCPConnection>& connection)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        peers.push_back({ connection, SensePacketEncoding::Raw });
+    }
+
+    // Called on the thread that receives the packets of the connection
+    void negotiate(const std::shared_ptr<TCPConnection>& connection, uint64_t requested)
+    {
+        uint64_t chosen = std::min(requested, static_cast<uint64_t>(maximumEncoding));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (Peer& peer : peers) {
+                if (peer.connection.lock() == connection) {
+                    peer.encoding = static_cast<SensePacketEncoding>(chosen);
+                    compactPeers = countPeers(SensePacketEncoding::Compact);
+                }
+            }
+        }
+        // A client that joins gets key frames, until then it skips the deltas it has no reference for
+        if (chosen == static_cast<uint64_t>(SensePacketEncoding::Compact))
+            compact.requestKeyFrame();
+        connection->send(getSensePacketDestination(SensePacketType::Encoding, SensePacketEncoding::Raw), &chosen, sizeof(chosen));
+    }
+
+    template <class Frame>
+    void publish(const Frame& frame)
+    {
+        size_t rawPeers, compactCount;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            peers.erase(std::remove_if(peers.begin(), peers.end(), [](Peer& peer) {
+                const std::shared_ptr<TCPConnection> connection = peer.connection.lock();
+                return !connection || !connection->isActive();
+            }), peers.end());
+            compactPeers = compactCount = countPeers(SensePacketEncoding::Compact);
+            rawPeers = peers.size() - compactCount;
+        }
+        // Each encoding is encoded once, only if a client takes it
+        if (compactCount > 0)
+            compact.accept(frame);
+        if (rawPeers > 0 || compactCount == 0)
+            raw.accept(frame);
+        sent.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t getConnectionCount(SensePacketEncoding encoding)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = 0;
+        for (const Peer& peer : peers) {
+            const std::shared_ptr<TCPConnection> connection = peer.connection.lock();
+            count += peer.encoding == encoding && connection && connection->isActive();
+        }
+        return count;
+    }
+
+    TCPServer& server;
+    Receiver* const receiver;
+    std::atomic<uint64_t> sent{ 0 };
+
+private:
+    struct Peer {
+        std::weak_ptr<TCPConnection> connection;
+        SensePacketEncoding encoding;
+    };
+
+    // Called with the mutex held
+    size_t countPeers(SensePacketEncoding encoding) const
+    {
+        return static_cast<size_t>(std::count_if(peers.begin(), peers.end(), [encoding](const Peer& peer) { return peer.encoding == encoding; }));
+    }
+
+    // Sink of the writers. While every client takes raw frames they share one broadcast, and its batch when coalescing.
+    // TCP sends never wait for the client and shared memory sends at most SharedMemoryTransportSettings::sendTimeout, so
+    // one slow client does not hold up the others.
+    void send(SensePacketEncoding encoding, uint64_t destination, void* payload, uint64_t payloadSize)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (encoding == SensePacketEncoding::Raw && compactPeers == 0) {
+            lock.unlock();
+            server.broadcast(destination, payload, payloadSize);
+            return;
+        }
+        for (const Peer& peer : peers)
+            if (peer.encoding == encoding)
+                if (const std::shared_ptr<TCPConnection> connection = peer.connection.lock())
+                    connection->send(destination, payload, payloadSize);
+    }
+
+    const SensePacketEncoding maximumEncoding;
+    std::mutex mutex;
+    std::vector<Peer> peers;
+    size_t compactPeers = 0;
+    SensePacketWriter raw;
+    SensePacketWriter compact;
+};
+
+// Receiver of one connection of the server, takes its encoding requests and passes on the rest
+class SensePacketPublisher::Negotiator : public Receiver {
+public:
+    Negotiator(std::weak_ptr<Impl> publisher, std::weak_ptr<TCPConnection> connection)
+        : publisher(std::move(publisher)), connection(std::move(connection))
+    {
+    }
+
+    void receive(SR_packet& packet) override
+    {
+        const std::shared_ptr<Impl> impl = publisher.lock();
+        if (!impl)
+            return;
+        if (packet.destination != getSensePacketDestination(SensePacketType::Encoding, SensePacketEncoding::Raw)) {
+            if (impl->receiver != nullptr)
+                impl->receiver->receive(packet);
+            return;
+        }
+        uint64_t requested = 0;
+        const std::shared_ptr<TCPConnection> peer = connection.lock();
+        if (peer && packet.size - SR_packet_headerSize >= sizeof(requested)) {
+            std::memcpy(&requested, &packet.payload, sizeof(requested));
+            impl->negotiate(peer, requested);
+        }
+    }
+
+    void print(SR_packet& packet) override
+    {
+        SR_packet_print(packet);
+    }
+
+private:
+    const std::weak_ptr<Impl> publisher;
+    const std::weak_ptr<TCPConnection> connection;
+};
+
+SensePacketPublisher::SensePacketPublisher(TCPServer& server, Receiver* receiver, SensePacketEncoding maximumEncoding, uint32_t keyFrameInterval)
+    : pimpl(std::make_shared<Impl>(server, receiver, maximumEncoding, keyFrameInterval))
+{
+    const std::weak_ptr<Impl> publisher = pimpl;
+    server.setConnectionHandler([publisher](const std::shared_ptr<TCPConnection>& connection) {
+        if (const std::shared_ptr<Impl> impl = publisher.lock()) {
+            connection->setReceiver(std::make_shared<Negotiator>(publisher, connection));
+            impl->add(connection);
+        }
+    });
+}
+
+SensePacketPublisher::~SensePacketPublisher()
+{
+    pimpl->server.setConnectionHandler(TCPServer::ConnectionHandler());
+}
+
+void SensePacketPublisher::accept(const SR_eyePair& frame)
+{
+    pimpl->publish(frame);
+}
+
+void SensePacketPublisher::accept(const SR_head& frame)
+{
+    pimpl->publish(frame);
+}
+
+void SensePacketPublisher::accept(const SR_handPose& frame)
+{
+    pimpl->publish(frame);
+}
+
+void SensePacketPublisher::accept(const SystemEvent& frame)
+{
+    pimpl->publish(frame);
+}
+
+uint64_t SensePacketPublisher::getSentCount() const
+{
+    return pimpl->sent.load(std::memory_order_relaxed);
+}
+
+size_t SensePacketPublisher::getConnectionCount(SensePacketEncoding encoding)
+{
+    return pimpl->getConnectionCount(encoding);
+}
+
+}
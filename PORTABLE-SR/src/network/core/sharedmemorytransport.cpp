@@ -0,0 +1,332 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/network/core/sharedmemorytransport.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include "utility/sharedmemory.h"
+
+namespace SR {
+
+namespace {
+
+constexpr uint64_t segmentMagic = 0x31304d4853525350; // "PSRSHM01"
+constexpr size_t cacheLine = 64;
+constexpr size_t headerSize = SR_packet_headerSize;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory rings need lock-free 64-bit atomics");
+
+// One direction. head and tail count bytes since creation, so the ring is empty when they are equal and never ambiguous.
+struct Ring {
+    alignas(cacheLine) std::atomic<uint64_t> head;     //!< Written by the producer, end of the published records
+    alignas(cacheLine) std::atomic<uint64_t> tail;     //!< Written by the consumer, end of the released records
+    alignas(cacheLine) std::atomic<uint32_t> signal;   //!< Futex word the consumer sleeps on
+    std::atomic<uint32_t> sleeping;                    //!< Set while the consumer sleeps, send() only wakes it then
+};
+
+// Start of the shared memory, followed by the data of ring 0 and of ring 1
+struct Segment {
+    std::atomic<uint64_t> magic;                       //!< Written last by the creator
+    uint64_t ringSize;
+    std::atomic<uint32_t> closed[2];                   //!< Side 0 created the channel, side 1 opened it
+    Ring rings[2];                                     //!< Ring i carries the packets sent by side i
+};
+
+constexpr size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Each ring is followed by one spare cache line, so SR_packet::payload of an empty packet at the end lies in the memory
+size_t ringOffset(int index, size_t ringSize)
+{
+    return alignUp(sizeof(Segment), cacheLine) + static_cast<size_t>(index) * (ringSize + cacheLine);
+}
+
+}
+
+class SharedMemoryChannel::Impl {
+public:
+    Impl(Receiver& receiver, const SharedMemoryTransportSettings& settings)
+        : receiver(receiver), settings(settings)
+    {
+    }
+
+    ~Impl()
+    {
+        close();
+    }
+
+    bool create(const std::string& name)
+    {
+        const size_t ringSize = settings.ringSize;
+        if (ringSize < 4096 || (ringSize & (ringSize - 1)) != 0)
+            throw std::invalid_argument("Shared memory ring size must be a power of two of at least 4 KiB");
+        close();
+        if (!memory.create(name, ringOffset(2, ringSize)))
+            return false;
+        segment = new (memory.getData()) Segment();
+        segment->ringSize = ringSize;
+        if (!signals[0].create(name + ".0", &segment->rings[0].signal) || !signals[1].create(name + ".1", &segment->rings[1].signal)) {
+            close();
+            return false;
+        }
+        segment->magic.store(segmentMagic, std::memory_order_release);
+        start(0);
+        return true;
+    }
+
+    bool open(const std::string& name)
+    {
+        close();
+        if (!memory.open(name))
+            return false;
+        segment = reinterpret_cast<Segment*>(memory.getData());
+        const bool valid = memory.getSize() >= sizeof(Segment) && segment->magic.load(std::memory_order_acquire) == segmentMagic &&
+            segment->ringSize >= 4096 && (segment->ringSize & (segment->ringSize - 1)) == 0 &&
+            memory.getSize() >= ringOffset(2, static_cast<size_t>(segment->ringSize));
+        if (!valid || !signals[0].open(name + ".0", &segment->rings[0].signal) || !signals[1].open(name + ".1", &segment->rings[1].signal)) {
+            close();
+            return false;
+        }
+        start(1);
+        return true;
+    }
+
+    void close()
+    {
+        if (segment == nullptr)
+            return;
+        stopping = true;
+        if (thread.joinable()) {
+            segment->closed[side].store(1);
+            // Wakes the peer, which then sees the closed flag, and the own receive thread
+            signals[side].notify();
+            signals[1 - side].notify();
+            thread.join();
+        }
+
+        std::lock_guard<std::mutex> lock(sendMutex);
+        signals[0].close();
+        signals[1].close();
+        memory.close();
+        segment = nullptr;
+    }
+
+    void send(uint64_t destination, const void* payload, uint64_t payloadSize)
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        if (!isOpen())
+            return;
+        const uint64_t ringSize = segment->ringSize;
+        if (payloadSize > ringSize / 2 - headerSize)
+            throw std::invalid_argument("Packet is larger than half of the shared memory ring");
+
+        Ring& ring = segment->rings[side];
+        unsigned char* data = memory.getData() + ringOffset(side, static_cast<size_t>(ringSize));
+        const uint64_t length = alignUp(static_cast<size_t>(headerSize + payloadSize), 8);
+        const uint64_t head = ring.head.load(std::memory_order_relaxed);
+        uint64_t position = head & (ringSize - 1);
+        // A record never wraps, the rest of the ring is skipped with a zero size marker instead
+        const uint64_t required = position + length > ringSize ? ringSize - position + length : length;
+        // Waits for room while the channel is open, a peer that does not make room within the send timeout is stuck
+        std::chrono::steady_clock::time_point deadline;
+        bool waiting = false;
+        while (ringSize - (head - ring.tail.load(std::memory_order_acquire)) < required) {
+            if (!isOpen())
+                return;
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (!waiting) {
+                deadline = now + std::chrono::microseconds(settings.sendTimeout);
+                waiting = true;
+            } else if (settings.sendTimeout != 0 && now > deadline) {
+                markClosed();
+                return;
+            }
+            std::this_thread::yield();
+        }
+        if (required != length) {
+            const uint64_t marker = 0;
+            std::memcpy(data + position, &marker, sizeof(marker));
+            position = 0;
+        }
+        const uint64_t header[2] = { headerSize + payloadSize, destination };
+        std::memcpy(data + position, header, sizeof(header));
+        std::memcpy(data + position + headerSize, payload, static_cast<size_t>(payloadSize));
+
+        // Sequentially consistent with the check of sleeping, so either the consumer sees the packet or send() sees it sleep
+        ring.head.store(head + required, std::memory_order_seq_cst);
+        if (ring.sleeping.load(std::memory_order_seq_cst) != 0) {
+            signals[side].notify();
+            wakes.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool isActive()
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        return isOpen();
+    }
+
+    Receiver& receiver;
+    const SharedMemoryTransportSettings settings;
+    SharedMemory memory;
+    std::atomic<uint64_t> received{ 0 };
+    std::atomic<uint64_t> wakes{ 0 };
+
+private:
+    // Called with the send mutex held, close() only unmaps the memory while holding it
+    bool isOpen() const
+    {
+        return segment != nullptr && !stopping && segment->closed[0].load() == 0 && segment->closed[1].load() == 0;
+    }
+
+    void start(int index)
+    {
+        side = index;
+        stopping = false;
+        thread = std::thread([this] { receive(); });
+    }
+
+    // Receive thread, consumes the ring of the peer
+    void receive()
+    {
+        const int peer = 1 - side;
+        const uint64_t ringSize = segment->ringSize;
+        Ring& ring = segment->rings[peer];
+        unsigned char* data = memory.getData() + ringOffset(peer, static_cast<size_t>(ringSize));
+        uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+
+        while (!stopping) {
+            const uint64_t head = ring.head.load(std::memory_order_acquire);
+            if (head - tail > ringSize) {
+                markClosed();
+                return;
+            }
+            if (head == tail) {
+                if (segment->closed[peer].load() != 0)
+                    return;
+                waitForPackets(ring, signals[peer], tail);
+                continue;
+            }
+            while (tail != head && !stopping) {
+                const uint64_t position = tail & (ringSize - 1);
+                uint64_t size = 0;
+                std::memcpy(&size, data + position, sizeof(size));
+                // Sizes come from the peer, a record that leaves the published part of the ring closes the channel like a
+                // malformed TCP packet closes the connection
+                if (size == 0) {
+                    if (ringSize - position > head - tail) {
+                        markClosed();
+                        return;
+                    }
+                    tail += ringSize - position;
+                } else if (size < headerSize || size > ringSize - position || alignUp(static_cast<size_t>(size), 8) > head - tail) {
+                    markClosed();
+                    return;
+                } else {
+                    receiver.receive(*reinterpret_cast<SR_packet*>(data + position));
+                    received.fetch_add(1, std::memory_order_relaxed);
+                    tail += alignUp(static_cast<size_t>(size), 8);
+                }
+                // Released after every packet, so a waiting send() can go on while the rest is delivered
+                ring.tail.store(tail, std::memory_order_release);
+            }
+        }
+    }
+
+    // Both sides stop sending and the peer's receive thread wakes up and ends, called on the receive thread when the peer
+    // wrote a malformed record and by send() when the peer stopped consuming
+    void markClosed()
+    {
+        segment->closed[side].store(1);
+        signals[side].notify();
+    }
+
+    // Polls for settings.spinTime, then sleeps until send() wakes the thread. The timeout only guards against a peer that died.
+    void waitForPackets(Ring& ring, SharedSignal& signal, uint64_t tail)
+    {
+        const auto spinEnd = std::chrono::steady_clock::now() + std::chrono::microseconds(settings.spinTime);
+        while (ring.head.load(std::memory_order_acquire) == tail && !stopping) {
+            if (std::chrono::steady_clock::now() < spinEnd) {
+                std::this_thread::yield();
+                continue;
+            }
+            ring.sleeping.store(1, std::memory_order_seq_cst);
+            const uint32_t value = ring.signal.load(std::memory_order_seq_cst);
+            if (ring.head.load(std::memory_order_seq_cst) == tail && !stopping)
+                signal.wait(value, 100);
+            ring.sleeping.store(0, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    SharedSignal signals[2];
+    Segment* segment = nullptr;
+    int side = 0;
+    std::atomic<bool> stopping{ false };
+    std::mutex sendMutex;
+    std::thread thread;
+};
+
+SharedMemoryChannel::SharedMemoryChannel(Receiver& receiver, const SharedMemoryTransportSettings& settings)
+    : pimpl(new Impl(receiver, settings))
+{
+}
+
+SharedMemoryChannel::~SharedMemoryChannel() = default;
+
+bool SharedMemoryChannel::create(const std::string& name)
+{
+    return pimpl->create(name);
+}
+
+bool SharedMemoryChannel::open(const std::string& name)
+{
+    return pimpl->open(name);
+}
+
+void SharedMemoryChannel::unlink()
+{
+    pimpl->memory.unlink();
+}
+
+void SharedMemoryChannel::close()
+{
+    pimpl->close();
+}
+
+void SharedMemoryChannel::send(uint64_t destination, void* payload, uint64_t payloadSize)
+{
+    pimpl->send(destination, payload, payloadSize);
+}
+
+bool SharedMemoryChannel::isActive()
+{
+    return pimpl->isActive();
+}
+
+uint64_t SharedMemoryChannel::getReceivedCount() const
+{
+    return pimpl->received.load(std::memory_order_relaxed);
+}
+
+uint64_t SharedMemoryChannel::getWakeCount() const
+{
+    return pimpl->wakes.load(std::memory_order_relaxed);
+}
+
+std::string SharedMemoryChannel::makeUniqueName()
+{
+    return SharedMemory::makeUniqueName("srportable");
+}
+
+}
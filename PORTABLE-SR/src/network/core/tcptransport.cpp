@@ -0,0 +1,715 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/network/core/tcptransport.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <asio.hpp>
+
+#include "sr/network/core/sharedmemorytransport.h"
+
+namespace SR {
+
+namespace {
+
+struct PacketHeader {
+    uint64_t size;        //!< Bytes of header and payload, SR_packet::size
+    uint64_t destination;
+};
+static_assert(sizeof(PacketHeader) == SR_packet_headerSize, "Header must match SR_packet");
+
+// Destinations of the packets that switch a loopback connection to shared memory. Only a side with
+// TCPTransportSettings::sharedMemoryRingSize set takes them, otherwise they reach the receiver like any other packet.
+constexpr uint64_t sharedMemoryRequest = ~uint64_t(0);     //!< Client to server, the payload names the channel
+constexpr uint64_t sharedMemoryAccept = ~uint64_t(0) - 1;  //!< Server to client, the server opened the channel
+
+}
+
+// io_context and the thread that runs it, shared by the owner and by every connection that uses it
+class TCPConnection::Thread {
+public:
+    Thread() : work(asio::make_work_guard(context)), thread([this] { context.run(); }) {}
+
+    ~Thread()
+    {
+        shutdown();
+    }
+
+    // Lets run() return once the pending operations finished, closed sockets abort theirs
+    void shutdown()
+    {
+        work.reset();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    asio::io_context context;
+
+private:
+    asio::executor_work_guard<asio::io_context::executor_type> work;
+    std::thread thread;
+};
+
+class TCPConnection::Impl : public std::enable_shared_from_this<TCPConnection::Impl> {
+public:
+    Impl(std::shared_ptr<Thread> thread, Receiver& receiver, const TCPTransportSettings& settings)
+        : thread(std::move(thread)), socket(this->thread->context), receiver(&receiver), settings(settings),
+          flushTimer(this->thread->context)
+    {
+        // 64-bit words keep the packets 8 byte aligned, one more word is never filled so that SR_packet::payload of an
+        // empty packet at the end still lies within the buffer
+        buffer.resize((std::max<size_t>(settings.receiveBufferSize, sizeof(SR_packet)) + 7) / sizeof(uint64_t) + 1);
+        pending.reserve(settings.coalesceSize + sizeof(PacketHeader));
+    }
+
+    void start()
+    {
+        asio::error_code ignored;
+        if (settings.noDelay)
+            socket.set_option(asio::ip::tcp::no_delay(true), ignored);
+        // Sends write what the socket takes at once and queue the rest, they never wait for the peer
+        socket.non_blocking(true, ignored);
+        active = true;
+        read();
+    }
+
+    void close()
+    {
+        // The socket belongs to the network thread, it is closed there after a running send finished. Once the thread has
+        // stopped nothing else uses the socket, and a posted handler would never run.
+        if (thread->context.stopped()) {
+            closeSocket();
+            return;
+        }
+        std::shared_ptr<Impl> self = shared_from_this();
+        asio::post(thread->context, [self] { self->closeSocket(); });
+    }
+
+    void send(uint64_t destination, const void* payload, uint64_t payloadSize)
+    {
+        if (payloadSize > settings.maximumPacketSize - sizeof(PacketHeader))
+            throw std::invalid_argument("Packet is larger than the maximum packet size");
+        const PacketHeader header = { sizeof(PacketHeader) + payloadSize, destination };
+
+        std::lock_guard<std::mutex> lock(sendMutex);
+        if (!active)
+            return;
+        if (channelActive) {
+            channel->send(destination, const_cast<void*>(payload), payloadSize);
+            closeIfChannelClosed();
+            return;
+        }
+        if (settings.coalesceSize == 0) {
+            write(&header, sizeof(header), payload, static_cast<size_t>(payloadSize));
+            return;
+        }
+        append(pending, header, payload);
+        if (pending.size() >= settings.coalesceSize)
+            flushPending();
+        else
+            startFlushTimer();
+    }
+
+    // Writes pending packets followed by a batch of the server, which is shared by all its connections
+    void sendBatch(const void* batch, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        if (!active)
+            return;
+        if (!channelActive) {
+            write(pending.data(), pending.size(), batch, size);
+            return;
+        }
+        // Shared memory needs no batching, the packets are copied into the ring one by one
+        const uint8_t* bytes = static_cast<const uint8_t*>(batch);
+        for (size_t offset = 0; offset < size;) {
+            PacketHeader header;
+            std::memcpy(&header, bytes + offset, sizeof(header));
+            channel->send(header.destination, const_cast<uint8_t*>(bytes + offset + sizeof(header)), header.size - sizeof(header));
+            offset += static_cast<size_t>(header.size);
+        }
+        closeIfChannelClosed();
+    }
+
+    // Client side of the switch to shared memory, the channel receives at once but is sent on after the server accepted
+    void requestSharedMemory()
+    {
+        SharedMemoryTransportSettings channelSettings;
+        channelSettings.ringSize = settings.sharedMemoryRingSize;
+        auto created = std::make_shared<SharedMemoryChannel>(*receiver, channelSettings);
+        const std::string name = SharedMemoryChannel::makeUniqueName();
+        if (!created->create(name))
+            return;
+        std::lock_guard<std::mutex> lock(sendMutex);
+        setChannel(created);
+        const PacketHeader header = { sizeof(PacketHeader) + name.size(), sharedMemoryRequest };
+        write(&header, sizeof(header), name.data(), name.size());
+    }
+
+    bool isSharedMemory()
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        return channelActive;
+    }
+
+    uint64_t getReceivedCount()
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        return received.load(std::memory_order_relaxed) + (channel ? channel->getReceivedCount() : 0);
+    }
+
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        if (active)
+            flushPending();
+    }
+
+    static void append(std::vector<uint8_t>& packets, const PacketHeader& header, const void* payload)
+    {
+        const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+        const uint8_t* payloadBytes = static_cast<const uint8_t*>(payload);
+        packets.insert(packets.end(), headerBytes, headerBytes + sizeof(header));
+        packets.insert(packets.end(), payloadBytes, payloadBytes + (header.size - sizeof(header)));
+    }
+
+    std::shared_ptr<Thread> thread;
+    asio::ip::tcp::socket socket;
+    Receiver* receiver;
+    std::shared_ptr<Receiver> ownedReceiver; //!< Set by setReceiver(), outlives the channel that may call it
+    const TCPTransportSettings settings;
+    std::atomic<bool> active{ false };
+    std::atomic<uint64_t> received{ 0 };
+    std::atomic<size_t> bufferSize{ 0 };
+    std::atomic<uint64_t> writes{ 0 };
+
+private:
+    uint8_t* bytes() { return reinterpret_cast<uint8_t*>(buffer.data()); }
+
+    // Called with the send mutex held. One gather write of up to two buffers is one system call that takes what fits into
+    // the socket buffer, the rest is queued behind the packets already waiting and written by async_write on the network
+    // thread. A peer whose queue outgrows TCPTransportSettings::sendQueueSize is disconnected instead of stalling the sender.
+    void write(const void* first, size_t firstSize, const void* second, size_t secondSize)
+    {
+        size_t written = 0;
+        if (!writeNow(first, firstSize, second, secondSize, written))
+            return;
+        const size_t firstWritten = std::min(written, firstSize);
+        const uint8_t* firstBytes = static_cast<const uint8_t*>(first);
+        const uint8_t* secondBytes = static_cast<const uint8_t*>(second);
+        queued.insert(queued.end(), firstBytes + firstWritten, firstBytes + firstSize);
+        queued.insert(queued.end(), secondBytes + (written - firstWritten), secondBytes + secondSize);
+        pending.clear();
+        startQueuedWrite();
+    }
+
+    // Called with the send mutex held, also by the flush timer on the network thread. A batch the socket does not take
+    // becomes the queue itself, so the async_write owns it and nothing is copied.
+    void flushPending()
+    {
+        if (pending.empty())
+            return;
+        size_t written = 0;
+        if (!writeNow(pending.data(), pending.size(), nullptr, 0, written))
+            return;
+        if (written == 0 && queued.empty())
+            queued.swap(pending);
+        else
+            queued.insert(queued.end(), pending.begin() + static_cast<std::ptrdiff_t>(written), pending.end());
+        pending.clear();
+        startQueuedWrite();
+    }
+
+    // Called with the send mutex held, writes without blocking unless packets are queued, false if the connection failed
+    bool writeNow(const void* first, size_t firstSize, const void* second, size_t secondSize, size_t& written)
+    {
+        written = 0;
+        if (writeRunning)
+            return true;
+        const std::array<asio::const_buffer, 2> buffers = {
+            asio::buffer(first, firstSize),
+            asio::buffer(second, secondSize),
+        };
+        asio::error_code error;
+        written = socket.write_some(buffers, error);
+        writes.fetch_add(1, std::memory_order_relaxed);
+        if (error == asio::error::would_block || error == asio::error::try_again)
+            error.clear();
+        if (error) {
+            pending.clear();
+            disconnect();
+            return false;
+        }
+        return true;
+    }
+
+    // Called with the send mutex held
+    void startQueuedWrite()
+    {
+        if (queued.size() + writing.size() > settings.sendQueueSize) {
+            disconnect();
+            return;
+        }
+        if (!queued.empty() && !writeRunning) {
+            writeRunning = true;
+            std::shared_ptr<Impl> self = shared_from_this();
+            asio::post(thread->context, [self] {
+                std::lock_guard<std::mutex> lock(self->sendMutex);
+                self->writeQueued();
+            });
+        }
+    }
+
+    // Called on the network thread with the send mutex held, writes the queue until it is empty
+    void writeQueued()
+    {
+        if (queued.empty() || !active) {
+            writeRunning = false;
+            return;
+        }
+        writing.swap(queued);
+        std::shared_ptr<Impl> self = shared_from_this();
+        asio::async_write(socket, asio::buffer(writing), [self](const asio::error_code& error, size_t) {
+            std::lock_guard<std::mutex> lock(self->sendMutex);
+            self->writes.fetch_add(1, std::memory_order_relaxed);
+            self->writing.clear();
+            if (error) {
+                self->writeRunning = false;
+                self->disconnect();
+                return;
+            }
+            self->writeQueued();
+        });
+    }
+
+    // Called with the send mutex held, the socket is closed on the network thread
+    void disconnect()
+    {
+        if (!active)
+            return;
+        active = false;
+        std::shared_ptr<Impl> self = shared_from_this();
+        asio::post(thread->context, [self] { self->closeSocket(); });
+    }
+
+    // Called with the send mutex held, a channel that the peer or a full ring closed takes the connection with it
+    void closeIfChannelClosed()
+    {
+        if (!channel->isActive())
+            disconnect();
+    }
+
+    // Called with the send mutex held
+    void setChannel(const std::shared_ptr<SharedMemoryChannel>& switched)
+    {
+        std::lock_guard<std::mutex> lock(channelMutex);
+        channel = switched;
+    }
+
+    // Called with the send mutex held, a timer that is already running flushes the new packets as well
+    void startFlushTimer()
+    {
+        if (flushTimerRunning)
+            return;
+        flushTimerRunning = true;
+        flushTimer.expires_after(std::chrono::microseconds(settings.coalesceDelay));
+        std::shared_ptr<Impl> self = shared_from_this();
+        flushTimer.async_wait([self](const asio::error_code& error) {
+            if (error)
+                return;
+            std::lock_guard<std::mutex> lock(self->sendMutex);
+            self->flushTimerRunning = false;
+            if (self->active)
+                self->flushPending();
+        });
+    }
+
+    void closeSocket()
+    {
+        // The channel closes first and without the send mutex, a send that waits for room in a full ring holds it and
+        // returns once the channel is closed. The receive thread of the channel may also be in a receiver that sends.
+        std::shared_ptr<SharedMemoryChannel> closing;
+        {
+            std::lock_guard<std::mutex> lock(channelMutex);
+            closing = channel;
+        }
+        if (closing)
+            closing->close();
+
+        std::lock_guard<std::mutex> lock(sendMutex);
+        if (active)
+            flushPending();
+        active = false;
+        flushTimer.cancel();
+        asio::error_code ignored;
+        socket.close(ignored);
+        channelActive = false;
+    }
+
+    // Handles a packet of the switch to shared memory, on the network thread
+    void switchToSharedMemory(const SR_packet& packet)
+    {
+        if (packet.destination == sharedMemoryRequest) {
+            const std::string name(reinterpret_cast<const char*>(&packet.payload), static_cast<size_t>(packet.size - sizeof(PacketHeader)));
+            auto opened = std::make_shared<SharedMemoryChannel>(*receiver);
+            if (!opened->open(name))
+                return;
+            std::lock_guard<std::mutex> lock(sendMutex);
+            if (!active)
+                return;
+            flushPending();
+            const PacketHeader header = { sizeof(PacketHeader), sharedMemoryAccept };
+            write(&header, sizeof(header), nullptr, 0);
+            setChannel(opened);
+            channelActive = true;
+        } else {
+            std::lock_guard<std::mutex> lock(sendMutex);
+            if (!channel)
+                return;
+            flushPending();
+            channel->unlink();
+            channelActive = true;
+        }
+    }
+
+    void read()
+    {
+        const size_t capacity = (buffer.size() - 1) * sizeof(uint64_t);
+        bufferSize = capacity;
+        std::shared_ptr<Impl> self = shared_from_this();
+        socket.async_read_some(asio::buffer(bytes() + filled, capacity - filled), [self](const asio::error_code& error, size_t count) {
+            // The peer closed the connection or its process ended, which closes the shared memory channel as well
+            if (error) {
+                self->closeSocket();
+                return;
+            }
+            self->filled += count;
+            if (self->deliver())
+                self->read();
+        });
+    }
+
+    // Passes every complete packet to the receiver, false on a malformed packet
+    bool deliver()
+    {
+        size_t offset = 0;
+        while (filled - offset >= sizeof(PacketHeader)) {
+            PacketHeader header;
+            std::memcpy(&header, bytes() + offset, sizeof(header));
+            if (header.size < sizeof(PacketHeader) || header.size > settings.maximumPacketSize) {
+                closeSocket();
+                return false;
+            }
+            if (filled - offset < header.size)
+                break;
+            // Packets behind one with an odd size are moved to the aligned start of the buffer
+            if (offset % alignof(uint64_t) != 0) {
+                std::memmove(bytes(), bytes() + offset, filled - offset);
+                filled -= offset;
+                offset = 0;
+            }
+            SR_packet& packet = *reinterpret_cast<SR_packet*>(bytes() + offset);
+            if (header.destination >= sharedMemoryAccept && settings.sharedMemoryRingSize != 0) {
+                switchToSharedMemory(packet);
+            } else {
+                receiver->receive(packet);
+                received.fetch_add(1, std::memory_order_relaxed);
+            }
+            offset += static_cast<size_t>(header.size);
+        }
+
+        // The incomplete packet moves to the start, the buffer grows if it cannot hold it
+        if (offset > 0) {
+            std::memmove(bytes(), bytes() + offset, filled - offset);
+            filled -= offset;
+        }
+        if (filled >= sizeof(PacketHeader)) {
+            PacketHeader header;
+            std::memcpy(&header, bytes(), sizeof(header));
+            const size_t words = (static_cast<size_t>(header.size) + 7) / sizeof(uint64_t) + 1;
+            if (words > buffer.size())
+                buffer.resize(words);
+        }
+        return true;
+    }
+
+    std::mutex sendMutex;
+    std::vector<uint8_t> pending;       //!< Coalesced packets not written yet
+    std::vector<uint8_t> queued;        //!< Bytes the socket did not take at once, in the order they were sent
+    std::vector<uint8_t> writing;       //!< Bytes of the running async_write, swapped with the queue when it finished
+    bool writeRunning = false;
+    asio::steady_timer flushTimer;
+    bool flushTimerRunning = false;
+    std::mutex channelMutex;            //!< Guards channel as well, so that closeSocket() gets it without the send mutex
+    std::shared_ptr<SharedMemoryChannel> channel;
+    bool channelActive = false;         //!< Packets are sent through the channel instead of the socket
+
+    std::vector<uint64_t> buffer;
+    size_t filled = 0;
+};
+
+TCPConnection::TCPConnection(Receiver& receiver, const TCPTransportSettings& settings)
+    : ownThread(std::make_shared<Thread>())
+{
+    pimpl = std::make_shared<Impl>(ownThread, receiver, settings);
+}
+
+TCPConnection::TCPConnection(std::shared_ptr<Impl> impl)
+    : pimpl(std::move(impl))
+{
+}
+
+TCPConnection::~TCPConnection()
+{
+    close();
+    if (ownThread)
+        ownThread->shutdown();
+}
+
+bool TCPConnection::connect(const std::string& host, uint16_t port)
+{
+    if (!ownThread || pimpl->active)
+        return false;
+    asio::error_code error;
+    asio::ip::tcp::resolver resolver(ownThread->context);
+    const asio::ip::tcp::resolver::results_type endpoints = resolver.resolve(host, std::to_string(port), error);
+    if (error)
+        return false;
+    // Connected on this thread, the network thread has no operation on the socket yet
+    for (const asio::ip::tcp::resolver::results_type::value_type& entry : endpoints) {
+        asio::error_code ignored;
+        pimpl->socket.close(ignored);
+        pimpl->socket.connect(entry.endpoint(), error);
+        if (!error)
+            break;
+    }
+    if (error || endpoints.empty())
+        return false;
+    pimpl->start();
+    if (pimpl->settings.sharedMemoryRingSize != 0 && pimpl->socket.remote_endpoint(error).address().is_loopback())
+        pimpl->requestSharedMemory();
+    return true;
+}
+
+void TCPConnection::setReceiver(std::shared_ptr<Receiver> receiver)
+{
+    if (!receiver)
+        throw std::invalid_argument("Receiver must not be null");
+    pimpl->receiver = receiver.get();
+    pimpl->ownedReceiver = std::move(receiver);
+}
+
+void TCPConnection::close()
+{
+    pimpl->close();
+}
+
+void TCPConnection::send(uint64_t destination, void* payload, uint64_t payloadSize)
+{
+    pimpl->send(destination, payload, payloadSize);
+}
+
+void TCPConnection::flush()
+{
+    pimpl->flush();
+}
+
+bool TCPConnection::isActive()
+{
+    return pimpl->active;
+}
+
+uint64_t TCPConnection::getReceivedCount() const
+{
+    return pimpl->getReceivedCount();
+}
+
+size_t TCPConnection::getReceiveBufferSize() const
+{
+    return pimpl->bufferSize.load(std::memory_order_relaxed);
+}
+
+uint64_t TCPConnection::getWriteCount() const
+{
+    return pimpl->writes.load(std::memory_order_relaxed);
+}
+
+bool TCPConnection::isSharedMemory()
+{
+    return pimpl->isSharedMemory();
+}
+
+class TCPServer::Impl {
+public:
+    Impl(Receiver& receiver, const TCPTransportSettings& settings)
+        : thread(std::make_shared<TCPConnection::Thread>()), acceptor(thread->context), receiver(receiver), settings(settings),
+          flushTimer(thread->context)
+    {
+        batch.reserve(settings.coalesceSize + sizeof(PacketHeader));
+    }
+
+    void accept()
+    {
+        auto connection = std::make_shared<TCPConnection::Impl>(thread, receiver, settings);
+        acceptor.async_accept(connection->socket, [this, connection](const asio::error_code& error) {
+            if (error)
+                return;
+            std::shared_ptr<TCPConnection> accepted(new TCPConnection(connection));
+            connection->start();
+            ConnectionHandler handler;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                connections.push_back(accepted);
+                handler = connectionHandler;
+            }
+            if (handler)
+                handler(accepted);
+            accept();
+        });
+    }
+
+    // Called with the mutex held, the batch is encoded once and written to every connection
+    void flushBatch()
+    {
+        if (batch.empty())
+            return;
+        for (const std::shared_ptr<TCPConnection>& connection : connections)
+            connection->pimpl->sendBatch(batch.data(), batch.size());
+        batch.clear();
+    }
+
+    // Called with the mutex held
+    void startFlushTimer()
+    {
+        if (flushTimerRunning)
+            return;
+        flushTimerRunning = true;
+        flushTimer.expires_after(std::chrono::microseconds(settings.coalesceDelay));
+        flushTimer.async_wait([this](const asio::error_code& error) {
+            if (error)
+                return;
+            std::lock_guard<std::mutex> lock(mutex);
+            flushTimerRunning = false;
+            flushBatch();
+        });
+    }
+
+    std::shared_ptr<TCPConnection::Thread> thread;
+    asio::ip::tcp::acceptor acceptor;
+    Receiver& receiver;
+    const TCPTransportSettings settings;
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TCPConnection>> connections;
+    ConnectionHandler connectionHandler;
+    std::vector<uint8_t> batch;         //!< Coalesced broadcast packets not written yet
+    asio::steady_timer flushTimer;
+    bool flushTimerRunning = false;
+};
+
+TCPServer::TCPServer(Receiver& receiver, const TCPTransportSettings& settings)
+    : pimpl(new Impl(receiver, settings))
+{
+}
+
+TCPServer::~TCPServer()
+{
+    asio::post(pimpl->thread->context, [this] {
+        asio::error_code ignored;
+        pimpl->acceptor.close(ignored);
+    });
+    {
+        std::lock_guard<std::mutex> lock(pimpl->mutex);
+        pimpl->flushBatch();
+        pimpl->flushTimer.cancel();
+        for (const std::shared_ptr<TCPConnection>& connection : pimpl->connections)
+            connection->close();
+    }
+    pimpl->thread->shutdown();
+}
+
+bool TCPServer::listen(uint16_t port, const std::string& address)
+{
+    asio::error_code error;
+    const asio::ip::address ip = asio::ip::make_address(address, error);
+    if (error || pimpl->acceptor.is_open())
+        return false;
+    const asio::ip::tcp::endpoint endpoint(ip, port);
+    pimpl->acceptor.open(endpoint.protocol(), error);
+    if (!error)
+        pimpl->acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true), error);
+    if (!error)
+        pimpl->acceptor.bind(endpoint, error);
+    if (!error)
+        pimpl->acceptor.listen(asio::socket_base::max_listen_connections, error);
+    if (error) {
+        asio::error_code ignored;
+        pimpl->acceptor.close(ignored);
+        return false;
+    }
+    // The first accept is started on the network thread, which owns the acceptor from then on
+    asio::post(pimpl->thread->context, [this] { pimpl->accept(); });
+    return true;
+}
+
+uint16_t TCPServer::getPort() const
+{
+    asio::error_code error;
+    const asio::ip::tcp::endpoint endpoint = pimpl->acceptor.local_endpoint(error);
+    return error ? 0 : endpoint.port();
+}
+
+void TCPServer::setConnectionHandler(ConnectionHandler handler)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    pimpl->connectionHandler = std::move(handler);
+}
+
+void TCPServer::broadcast(uint64_t destination, void* payload, uint64_t payloadSize)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    auto& connections = pimpl->connections;
+    connections.erase(std::remove_if(connections.begin(), connections.end(),
+        [](const std::shared_ptr<TCPConnection>& connection) { return !connection->isActive(); }), connections.end());
+    if (pimpl->settings.coalesceSize == 0) {
+        for (const std::shared_ptr<TCPConnection>& connection : connections)
+            connection->send(destination, payload, payloadSize);
+        return;
+    }
+
+    if (payloadSize > pimpl->settings.maximumPacketSize - sizeof(PacketHeader))
+        throw std::invalid_argument("Packet is larger than the maximum packet size");
+    const PacketHeader header = { sizeof(PacketHeader) + payloadSize, destination };
+    TCPConnection::Impl::append(pimpl->batch, header, payload);
+    if (pimpl->batch.size() >= pimpl->settings.coalesceSize)
+        pimpl->flushBatch();
+    else
+        pimpl->startFlushTimer();
+}
+
+void TCPServer::flush()
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    pimpl->flushBatch();
+    for (const std::shared_ptr<TCPConnection>& connection : pimpl->connections)
+        connection->flush();
+}
+
+size_t TCPServer::getConnectionCount()
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    return static_cast<size_t>(std::count_if(pimpl->connections.begin(), pimpl->connections.end(),
+        [](const std::shared_ptr<TCPConnection>& connection) { return connection->isActive(); }));
+}
+
+}
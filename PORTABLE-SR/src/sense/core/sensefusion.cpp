@@ -0,0 +1,265 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/sense/core/sensefusion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace SR {
+
+namespace {
+
+// Lookups that are further ahead of the previous one than this many frames use a binary search
+constexpr size_t maximumWalk = 4;
+
+void blend(const SR_point3d* from, const SR_point3d* to, double fraction, SR_point3d* output, int count)
+{
+    for (int i = 0; i < count; i++)
+        for (int c = 0; c < 3; c++)
+            output[i].p[c] = from[i].p[c] + (to[i].p[c] - from[i].p[c]) * fraction;
+}
+
+// Blends angles in radians along their shortest difference, so the result stays in [-pi, pi] across the wrap
+void blendAngles(const SR_point3d& from, const SR_point3d& to, double fraction, SR_point3d& output)
+{
+    constexpr double turn = 6.283185307179586;
+    for (int c = 0; c < 3; c++)
+        output.p[c] = std::remainder(from.p[c] + std::remainder(to.p[c] - from.p[c], turn) * fraction, turn);
+}
+
+void interpolate(const SR_eyePair& from, const SR_eyePair& to, double fraction, SR_eyePair& output)
+{
+    blend(from.eyes, to.eyes, fraction, output.eyes, 2);
+}
+
+void interpolate(const SR_head& from, const SR_head& to, double fraction, SR_head& output)
+{
+    blend(&from.headPose.position, &to.headPose.position, fraction, &output.headPose.position, 1);
+    blendAngles(from.headPose.orientation, to.headPose.orientation, fraction, output.headPose.orientation);
+    blend(from.eyes.eyes, to.eyes.eyes, fraction, output.eyes.eyes, 2);
+    blend(from.ears.ears, to.ears.ears, fraction, output.ears.ears, 2);
+}
+
+void interpolate(const SR_handPose& from, const SR_handPose& to, double fraction, SR_handPose& output)
+{
+    blend(from.joints, to.joints, fraction, output.joints, 21);
+}
+
+// Interpolated streams need strictly increasing times, gestures are events that may share one
+template <class Frame>
+bool follows(const Frame& frame, const Frame& previous)
+{
+    return frame.time > previous.time;
+}
+
+bool follows(const SR_gesture& frame, const SR_gesture& previous)
+{
+    return frame.time >= previous.time;
+}
+
+void setTime(SR_eyePair& frame, uint64_t time)
+{
+    frame.time = time;
+}
+
+void setTime(SR_head& frame, uint64_t time)
+{
+    frame.time = time;
+    frame.headPose.time = time;
+    frame.eyes.time = time;
+    frame.ears.time = time;
+}
+
+void setTime(SR_handPose& frame, uint64_t time)
+{
+    frame.time = time;
+}
+
+// Newest frames of one stream in time order, addressed by their sequence number since the last reset
+template <class Frame>
+class TimedRing {
+public:
+    explicit TimedRing(size_t capacity) : frames(capacity) {}
+
+    void push(const Frame& frame)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (total > 0 && !follows(frame, at(total - 1)))
+            return;
+        frames[total % frames.size()] = frame;
+        total++;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        total = 0;
+        cursor = 0;
+    }
+
+    // Interpolates or extrapolates to time, false if the stream has no frames around it
+    bool sample(uint64_t time, const SenseFusionSettings& settings, Frame& output) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (total == 0 || time < at(getFirst()).time)
+            return false;
+        const Frame& newest = at(total - 1);
+        if (time > newest.time && time - newest.time > settings.timeout)
+            return false;
+
+        if (time >= newest.time) {
+            output = newest;
+            if (total - getFirst() >= 2) {
+                const Frame& previous = at(total - 2);
+                const uint64_t horizon = std::min(time - newest.time, settings.maximumExtrapolation);
+                interpolate(previous, newest, 1.0 + static_cast<double>(horizon) / static_cast<double>(newest.time - previous.time), output);
+            }
+        } else {
+            const size_t index = find(time);
+            const Frame& from = at(index);
+            const Frame& to = at(index + 1);
+            output = from;
+            interpolate(from, to, static_cast<double>(time - from.time) / static_cast<double>(to.time - from.time), output);
+        }
+        setTime(output, time);
+        return true;
+    }
+
+    // Newest frame at or before time that is at most timeout older, without interpolation
+    bool latest(uint64_t time, uint64_t timeout, Frame& output) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (total == 0 || time < at(getFirst()).time)
+            return false;
+        const Frame& frame = time >= at(total - 1).time ? at(total - 1) : at(find(time));
+        if (time - frame.time > timeout)
+            return false;
+        output = frame;
+        return true;
+    }
+
+private:
+    size_t getFirst() const
+    {
+        return total > frames.size() ? total - frames.size() : 0;
+    }
+
+    const Frame& at(size_t sequence) const
+    {
+        return frames[sequence % frames.size()];
+    }
+
+    // Sequence number of the last frame at or before time, which has to lie in [oldest, newest)
+    size_t find(uint64_t time) const
+    {
+        const size_t first = getFirst();
+        size_t index = std::max(cursor, first);
+        bool found = false;
+        if (index + 1 < total && at(index).time <= time) {
+            for (size_t step = 0; step <= maximumWalk && index + 1 < total; step++, index++) {
+                if (time < at(index + 1).time) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (!found) {
+            size_t low = first, high = total - 1;
+            while (high - low > 1) {
+                const size_t middle = low + (high - low) / 2;
+                if (at(middle).time <= time)
+                    low = middle;
+                else
+                    high = middle;
+            }
+            index = low;
+        }
+        cursor = index;
+        return index;
+    }
+
+    std::vector<Frame> frames;
+    size_t total = 0;
+    mutable size_t cursor = 0;
+    mutable std::mutex mutex;
+};
+
+}
+
+class SenseFusion::Impl {
+public:
+    explicit Impl(const SenseFusionSettings& settings)
+        : settings(settings), eyePairs(settings.capacity), heads(settings.capacity),
+          hands{ TimedRing<SR_handPose>(settings.capacity), TimedRing<SR_handPose>(settings.capacity) }, gestures(settings.capacity)
+    {
+    }
+
+    SenseFusionSettings settings;
+    TimedRing<SR_eyePair> eyePairs;
+    TimedRing<SR_head> heads;
+    TimedRing<SR_handPose> hands[2];
+    TimedRing<SR_gesture> gestures;
+};
+
+SenseFusion::SenseFusion(const SenseFusionSettings& settings)
+{
+    if (settings.capacity < 2)
+        throw std::invalid_argument("Sense fusion keeps at least two frames per stream");
+    pimpl.reset(new Impl(settings));
+}
+
+SenseFusion::~SenseFusion() = default;
+
+void SenseFusion::accept(const SR_eyePair& frame)
+{
+    pimpl->eyePairs.push(frame);
+}
+
+void SenseFusion::accept(const SR_head& frame)
+{
+    pimpl->heads.push(frame);
+}
+
+void SenseFusion::accept(const SR_handPose& frame)
+{
+    if (frame.side == LeftHand || frame.side == RightHand)
+        pimpl->hands[frame.side].push(frame);
+}
+
+void SenseFusion::accept(const SR_gesture& frame)
+{
+    pimpl->gestures.push(frame);
+}
+
+SenseSnapshot SenseFusion::getSnapshot(uint64_t time) const
+{
+    SenseSnapshot snapshot;
+    snapshot.time = time;
+    snapshot.hasEyePair = pimpl->eyePairs.sample(time, pimpl->settings, snapshot.eyePair);
+    snapshot.hasHead = pimpl->heads.sample(time, pimpl->settings, snapshot.head);
+    for (int side = 0; side < 2; side++)
+        snapshot.hasHand[side] = pimpl->hands[side].sample(time, pimpl->settings, snapshot.hands[side]);
+    snapshot.hasGesture = pimpl->gestures.latest(time, pimpl->settings.timeout, snapshot.gesture);
+    return snapshot;
+}
+
+void SenseFusion::reset()
+{
+    pimpl->eyePairs.clear();
+    pimpl->heads.clear();
+    for (TimedRing<SR_handPose>& hand : pimpl->hands)
+        hand.clear();
+    pimpl->gestures.clear();
+}
+
+const SenseFusionSettings& SenseFusion::getSettings() const
+{
+    return pimpl->settings;
+}
+
+}
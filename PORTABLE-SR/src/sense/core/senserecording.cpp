@@ -0,0 +1,238 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/sense/core/senserecording.h"
+
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include "utility/mappedfile.h"
+
+namespace SR {
+
+namespace {
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t type;
+    uint32_t recordSize;
+    uint32_t headerSize;
+    uint8_t reserved[40];
+};
+static_assert(sizeof(FileHeader) == 64, "Records start 64 bytes into the file, which keeps them aligned");
+
+const char fileMagic[8] = { 'S', 'R', 'R', 'E', 'C', 'O', 'R', 'D' };
+const uint32_t fileVersion = 1;
+
+// Records are copied into this buffer and written in blocks
+const size_t writeBufferSize = 1 << 16;
+
+// Every frame struct starts with frameId and time
+const size_t timeOffset = 8;
+
+bool isValid(const FileHeader& header)
+{
+    return std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) == 0 && header.version == fileVersion &&
+        header.headerSize == sizeof(FileHeader) && header.recordSize != 0 &&
+        header.recordSize == getSenseRecordSize(static_cast<SenseRecordType>(header.type));
+}
+
+uint64_t readTime(const unsigned char* record)
+{
+    uint64_t time;
+    std::memcpy(&time, record + timeOffset, sizeof(time));
+    return time;
+}
+
+}
+
+size_t getSenseRecordSize(SenseRecordType type)
+{
+    switch (type) {
+    case SenseRecordType::EyePair:        return sizeof(SR_eyePair);
+    case SenseRecordType::Head:           return sizeof(SR_head);
+    case SenseRecordType::HeadPose:       return sizeof(SR_headPose);
+    case SenseRecordType::WeaverPosition: return sizeof(SR_weaverPosition);
+    }
+    return 0;
+}
+
+SenseRecordWriter::~SenseRecordWriter()
+{
+    close();
+}
+
+bool SenseRecordWriter::open(const std::string& path, SenseRecordType recordType, bool append)
+{
+    close();
+    type = recordType;
+    recordSize = getSenseRecordSize(type);
+    lastTime = 0;
+    if (recordSize == 0)
+        return false;
+
+    std::error_code error;
+    const uint64_t existingSize = append ? std::filesystem::file_size(path, error) : 0;
+    if (append && !error && existingSize > 0) {
+        // Continue after the last complete record, a partial record of an interrupted recording is cut off
+        uint64_t count = 0;
+        {
+            MappedFile existing;
+            FileHeader header;
+            if (!existing.open(path) || existing.getSize() < sizeof(header))
+                return false;
+            std::memcpy(&header, existing.getData(), sizeof(header));
+            if (!isValid(header) || header.type != static_cast<uint32_t>(type))
+                return false;
+            count = (existing.getSize() - sizeof(header)) / recordSize;
+            if (count > 0)
+                lastTime = readTime(existing.getData() + sizeof(header) + (count - 1) * recordSize);
+        }
+
+        std::filesystem::resize_file(path, sizeof(FileHeader) + count * recordSize, error);
+        if (error)
+            return false;
+        file = std::fopen(path.c_str(), "ab");
+    } else {
+        file = std::fopen(path.c_str(), "wb");
+        if (file) {
+            FileHeader header = {};
+            std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+            header.version = fileVersion;
+            header.type = static_cast<uint32_t>(type);
+            header.recordSize = static_cast<uint32_t>(recordSize);
+            header.headerSize = sizeof(FileHeader);
+            if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+                std::fclose(file);
+                file = nullptr;
+            }
+        }
+    }
+    if (!file)
+        return false;
+
+    buffer.reset(new char[writeBufferSize]);
+    std::setvbuf(file, buffer.get(), _IOFBF, writeBufferSize);
+    return true;
+}
+
+void SenseRecordWriter::close()
+{
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    buffer.reset();
+}
+
+bool SenseRecordWriter::flush()
+{
+    return file && std::fflush(file) == 0;
+}
+
+bool SenseRecordWriter::writeRecord(const void* record, uint64_t time)
+{
+    if (!file || time < lastTime)
+        return false;
+    if (std::fwrite(record, recordSize, 1, file) != 1)
+        return false;
+    lastTime = time;
+    return true;
+}
+
+class SenseRecording::Impl {
+public:
+    MappedFile file;
+    SenseRecordType type = SenseRecordType::EyePair;
+    size_t recordSize = 0;
+    size_t count = 0;
+    const unsigned char* records = nullptr;
+};
+
+SenseRecording::SenseRecording()
+    : pimpl(new Impl())
+{
+}
+
+SenseRecording::~SenseRecording() = default;
+SenseRecording::SenseRecording(SenseRecording&& other) noexcept = default;
+SenseRecording& SenseRecording::operator=(SenseRecording&& other) noexcept = default;
+
+bool SenseRecording::open(const std::string& path)
+{
+    close();
+    if (!pimpl->file.open(path))
+        return false;
+
+    FileHeader header;
+    if (pimpl->file.getSize() < sizeof(header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, pimpl->file.getData(), sizeof(header));
+    if (!isValid(header)) {
+        close();
+        return false;
+    }
+
+    pimpl->type = static_cast<SenseRecordType>(header.type);
+    pimpl->recordSize = header.recordSize;
+    pimpl->count = (pimpl->file.getSize() - sizeof(header)) / header.recordSize;
+    pimpl->records = pimpl->file.getData() + sizeof(header);
+    return true;
+}
+
+void SenseRecording::close()
+{
+    if (!pimpl)
+        pimpl.reset(new Impl());
+    pimpl->file.close();
+    pimpl->count = 0;
+    pimpl->records = nullptr;
+}
+
+bool SenseRecording::isOpen() const
+{
+    return pimpl && pimpl->records != nullptr;
+}
+
+SenseRecordType SenseRecording::getType() const
+{
+    return pimpl ? pimpl->type : SenseRecordType::EyePair;
+}
+
+size_t SenseRecording::size() const
+{
+    return pimpl ? pimpl->count : 0;
+}
+
+uint64_t SenseRecording::getTime(size_t index) const
+{
+    return readTime(pimpl->records + index * pimpl->recordSize);
+}
+
+size_t SenseRecording::seek(uint64_t time) const
+{
+    size_t first = 0;
+    size_t count = size();
+    while (count > 0) {
+        const size_t step = count / 2;
+        if (getTime(first + step) < time) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+const void* SenseRecording::getRecord(size_t index) const
+{
+    return pimpl->records + index * pimpl->recordSize;
+}
+
+}
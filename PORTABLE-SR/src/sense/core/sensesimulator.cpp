@@ -0,0 +1,400 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/sense/core/sensesimulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace SR {
+
+namespace {
+
+uint64_t toMicroseconds(double seconds)
+{
+    return static_cast<uint64_t>(std::llround(seconds * 1.0e6));
+}
+
+template <class Listener>
+void removeFrom(std::vector<Listener*>& listeners, Listener* listener)
+{
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+void setPoint(SR_point3d& point, const float position[3], float xOffset)
+{
+    point.x = position[0] + xOffset;
+    point.y = position[1];
+    point.z = position[2];
+}
+
+}
+
+SenseSimulator::SenseSimulator(EyeTrajectory source, const SenseSimulatorSettings& simulatorSettings)
+    : settings(simulatorSettings), trajectory(std::move(source))
+{
+    if (trajectory.getKeyframes().empty() || !(settings.rate > 0.0))
+        throw std::invalid_argument("A simulated sense needs a trajectory and a positive rate");
+    sourceDuration = toMicroseconds(trajectory.getDuration());
+    time = settings.startTime;
+}
+
+SenseSimulator::SenseSimulator(SenseRecording source, const SenseSimulatorSettings& simulatorSettings)
+    : settings(simulatorSettings), recording(std::move(source)), fromRecording(true)
+{
+    const SenseRecordType type = recording.getType();
+    if (recording.size() == 0 || (type != SenseRecordType::EyePair && type != SenseRecordType::Head))
+        throw std::invalid_argument("A simulated sense needs an eye pair or head recording");
+
+    // A loop lasts the recording plus one mean frame interval, so the last and the first frame do not coincide
+    const size_t count = recording.size();
+    const uint64_t span = recording.getTime(count - 1) - recording.getTime(0);
+    sourceDuration = span + (count > 1 ? span / (count - 1) : toMicroseconds(1.0 / settings.rate));
+    time = settings.startTime;
+}
+
+SenseSimulator::~SenseSimulator()
+{
+    stop();
+}
+
+void SenseSimulator::addListener(EyePairListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    eyePairListeners.push_back(listener);
+}
+
+void SenseSimulator::removeListener(EyePairListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    removeFrom(eyePairListeners, listener);
+}
+
+void SenseSimulator::addListener(HeadListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    headListeners.push_back(listener);
+}
+
+void SenseSimulator::removeListener(HeadListener* listener)
+{
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    removeFrom(headListeners, listener);
+}
+
+void SenseSimulator::start()
+{
+    if (settings.simulatedClock || thread.joinable())
+        return;
+    stopping = false;
+    running = true;
+    thread = std::thread(&SenseSimulator::run, this);
+}
+
+void SenseSimulator::stop()
+{
+    if (!thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(threadMutex);
+        stopping = true;
+    }
+    stopCondition.notify_all();
+    thread.join();
+}
+
+void SenseSimulator::wait()
+{
+    std::unique_lock<std::mutex> lock(threadMutex);
+    stopCondition.wait(lock, [this] { return !running; });
+}
+
+bool SenseSimulator::advance(uint64_t microseconds)
+{
+    if (!settings.simulatedClock)
+        throw std::logic_error("advance() needs the simulated clock");
+
+    const uint64_t now = time + microseconds;
+    uint64_t offset;
+    while (getFrameOffset(nextFrame, offset) && settings.startTime + offset <= now) {
+        emit(nextFrame, settings.startTime + offset);
+        nextFrame++;
+    }
+    time = now;
+    return getFrameOffset(nextFrame, offset);
+}
+
+uint64_t SenseSimulator::getTime() const
+{
+    return time;
+}
+
+uint64_t SenseSimulator::getFrameCount() const
+{
+    return frameCount;
+}
+
+bool SenseSimulator::getFrameOffset(uint64_t index, uint64_t& offset) const
+{
+    if (fromRecording) {
+        const uint64_t count = recording.size();
+        if (!settings.loop && index >= count)
+            return false;
+        offset = (index / count) * sourceDuration + recording.getTime(index % count) - recording.getTime(0);
+        return true;
+    }
+
+    offset = toMicroseconds(static_cast<double>(index) / settings.rate);
+    return settings.loop || offset <= sourceDuration;
+}
+
+void SenseSimulator::makeFrame(uint64_t index, uint64_t frameTime, SR_eyePair& pair, SR_head& head) const
+{
+    float center[3];
+    if (fromRecording && recording.getType() == SenseRecordType::Head) {
+        head = recording.get<SR_head>(index % recording.size());
+        pair = head.eyes;
+    } else {
+        if (fromRecording) {
+            pair = recording.get<SR_eyePair>(index % recording.size());
+            for (int c = 0; c < 3; c++)
+                center[c] = static_cast<float>(0.5 * (pair.left.p[c] + pair.right.p[c]));
+        } else {
+            uint64_t offset = 0;
+            getFrameOffset(index, offset);
+            const double duration = trajectory.getDuration();
+            double seconds = static_cast<double>(offset) * 1.0e-6;
+            if (settings.loop && duration > 0.0)
+                seconds = std::fmod(seconds, duration);
+            trajectory.evaluate(seconds, center);
+            setPoint(pair.left, center, -0.5f * settings.eyeDistance);
+            setPoint(pair.right, center, 0.5f * settings.eyeDistance);
+        }
+
+        head = SR_head{};
+        setPoint(head.headPose.position, center, 0.0f);
+        head.eyes = pair;
+        setPoint(head.ears.left, center, -0.5f * settings.earDistance);
+        setPoint(head.ears.right, center, 0.5f * settings.earDistance);
+    }
+
+    pair.frameId = head.frameId = head.headPose.frameId = head.eyes.frameId = head.ears.frameId = index;
+    pair.time = head.time = head.headPose.time = head.eyes.time = head.ears.time = frameTime;
+}
+
+void SenseSimulator::emit(uint64_t index, uint64_t frameTime)
+{
+    SR_eyePair pair;
+    SR_head head;
+    makeFrame(index, frameTime, pair, head);
+    {
+        std::lock_guard<std::mutex> lock(listenerMutex);
+        for (EyePairListener* listener : eyePairListeners)
+            listener->accept(pair);
+        for (HeadListener* listener : headListeners)
+            listener->accept(head);
+    }
+    time = frameTime;
+    frameCount++;
+}
+
+void SenseSimulator::run()
+{
+    using Clock = std::chrono::steady_clock;
+    uint64_t startOffset = 0;
+    if (getFrameOffset(nextFrame, startOffset)) {
+        // Frames continue after a restart, their times follow the wall clock from now on
+        const Clock::time_point start = Clock::now();
+        const uint64_t base = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        uint64_t offset;
+        while (getFrameOffset(nextFrame, offset)) {
+            const uint64_t elapsed = offset - startOffset;
+            {
+                std::unique_lock<std::mutex> lock(threadMutex);
+                if (stopCondition.wait_until(lock, start + std::chrono::microseconds(elapsed), [this] { return stopping; }))
+                    break;
+            }
+            emit(nextFrame, base + elapsed);
+            nextFrame++;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(threadMutex);
+    running = false;
+    stopCondition.notify_all();
+}
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+
+// Passes the frames of the simulator to one stream
+class SimulatedEyeTracker::Forwarder : public EyePairListener {
+public:
+    explicit Forwarder(EyePairStream* stream) : stream(stream) {}
+
+    void accept(const SR_eyePair& frame) override
+    {
+        stream->update(frame);
+    }
+
+    EyePairStream* const stream;
+};
+
+SimulatedEyeTracker* SimulatedEyeTracker::create(SRContext& context, SenseSimulator& simulator)
+{
+    SimulatedEyeTracker* tracker = new SimulatedEyeTracker(simulator);
+    context.addSense("EyeTracker", tracker);
+    return tracker;
+}
+
+SimulatedEyeTracker::SimulatedEyeTracker(SenseSimulator& simulator)
+    : simulator(simulator)
+{
+}
+
+SimulatedEyeTracker::~SimulatedEyeTracker()
+{
+    // Streams call streamClosed() when closed, so they are closed after releasing the list
+    std::vector<std::unique_ptr<Forwarder>> closing;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing.swap(forwarders);
+    }
+    for (const std::unique_ptr<Forwarder>& forwarder : closing) {
+        simulator.removeListener(forwarder.get());
+        forwarder->stream->close();
+    }
+}
+
+std::string SimulatedEyeTracker::getName()
+{
+    return "SimulatedEyeTracker";
+}
+
+std::string SimulatedEyeTracker::getDescription()
+{
+    return "Eye tracker emitting the frames of a trajectory or recording";
+}
+
+void SimulatedEyeTracker::start()
+{
+    simulator.start();
+}
+
+void SimulatedEyeTracker::stop()
+{
+    simulator.stop();
+}
+
+std::shared_ptr<EyePairStream> SimulatedEyeTracker::openEyePairStream(EyePairListener* listener)
+{
+    std::shared_ptr<EyePairStream> stream = std::make_shared<EyePairStream>(this, listener);
+    std::unique_ptr<Forwarder> forwarder(new Forwarder(stream.get()));
+    simulator.addListener(forwarder.get());
+    std::lock_guard<std::mutex> lock(mutex);
+    forwarders.push_back(std::move(forwarder));
+    return stream;
+}
+
+void SimulatedEyeTracker::streamClosed(EyePairStream* stream)
+{
+    std::unique_ptr<Forwarder> closed;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = std::find_if(forwarders.begin(), forwarders.end(), [&](const std::unique_ptr<Forwarder>& f) { return f->stream == stream; });
+        if (found == forwarders.end())
+            return;
+        closed = std::move(*found);
+        forwarders.erase(found);
+    }
+    simulator.removeListener(closed.get());
+}
+
+class SimulatedHeadTracker::Forwarder : public HeadListener {
+public:
+    explicit Forwarder(HeadStream* stream) : stream(stream) {}
+
+    void accept(const SR_head& frame) override
+    {
+        SR_head copy = frame;
+        stream->update(copy);
+    }
+
+    HeadStream* const stream;
+};
+
+SimulatedHeadTracker* SimulatedHeadTracker::create(SRContext& context, SenseSimulator& simulator)
+{
+    SimulatedHeadTracker* tracker = new SimulatedHeadTracker(simulator);
+    context.addSense("HeadTracker", tracker);
+    return tracker;
+}
+
+SimulatedHeadTracker::SimulatedHeadTracker(SenseSimulator& simulator)
+    : simulator(simulator)
+{
+}
+
+SimulatedHeadTracker::~SimulatedHeadTracker()
+{
+    std::vector<std::unique_ptr<Forwarder>> closing;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing.swap(forwarders);
+    }
+    for (const std::unique_ptr<Forwarder>& forwarder : closing) {
+        simulator.removeListener(forwarder.get());
+        forwarder->stream->close();
+    }
+}
+
+std::string SimulatedHeadTracker::getName()
+{
+    return "SimulatedHeadTracker";
+}
+
+std::string SimulatedHeadTracker::getDescription()
+{
+    return "Head tracker emitting the frames of a trajectory or recording";
+}
+
+void SimulatedHeadTracker::start()
+{
+    simulator.start();
+}
+
+void SimulatedHeadTracker::stop()
+{
+    simulator.stop();
+}
+
+std::shared_ptr<HeadStream> SimulatedHeadTracker::openHeadStream(HeadListener* listener)
+{
+    std::shared_ptr<HeadStream> stream = std::make_shared<HeadStream>(this, listener);
+    std::unique_ptr<Forwarder> forwarder(new Forwarder(stream.get()));
+    simulator.addListener(forwarder.get());
+    std::lock_guard<std::mutex> lock(mutex);
+    forwarders.push_back(std::move(forwarder));
+    return stream;
+}
+
+void SimulatedHeadTracker::streamClosed(HeadStream* stream)
+{
+    std::unique_ptr<Forwarder> closed;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = std::find_if(forwarders.begin(), forwarders.end(), [&](const std::unique_ptr<Forwarder>& f) { return f->stream == stream; });
+        if (found == forwarders.end())
+            return;
+        closed = std::move(*found);
+        forwarders.erase(found);
+    }
+    simulator.removeListener(closed.get());
+}
+
+#endif
+
+}
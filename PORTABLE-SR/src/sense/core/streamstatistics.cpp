@@ -0,0 +1,231 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/sense/core/streamstatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+#include "sr/utility/logging.h"
+#endif
+
+namespace SR {
+
+namespace {
+
+// Durations below 8 ns have a bucket each, above that every power of two is split into 8 buckets
+int getBucket(uint64_t nanoseconds)
+{
+    if (nanoseconds < 8)
+        return static_cast<int>(nanoseconds);
+    int octave = 63;
+    while ((nanoseconds >> octave) == 0)
+        octave--;
+    return (octave - 2) * 8 + static_cast<int>((nanoseconds >> (octave - 3)) & 7);
+}
+
+// Center of a bucket in nanoseconds
+double getBucketCenter(int bucket)
+{
+    if (bucket < 8)
+        return static_cast<double>(bucket);
+    const int octave = bucket / 8 + 2;
+    const double lower = std::ldexp(static_cast<double>(8 + bucket % 8), octave - 3);
+    return lower + std::ldexp(0.5, octave - 3);
+}
+
+void add(std::atomic<double>& total, double value)
+{
+    double previous = total.load(std::memory_order_relaxed);
+    while (!total.compare_exchange_weak(previous, previous + value, std::memory_order_relaxed)) {
+    }
+}
+
+}
+
+DurationHistogram::DurationHistogram()
+{
+    for (std::atomic<uint64_t>& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+void DurationHistogram::record(uint64_t nanoseconds)
+{
+    buckets[getBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+    uint64_t previous = maximum.load(std::memory_order_relaxed);
+    while (nanoseconds > previous && !maximum.compare_exchange_weak(previous, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+DurationHistogram::Summary DurationHistogram::getSummary() const
+{
+    uint64_t counts[bucketCount];
+    Summary summary;
+    for (int i = 0; i < bucketCount; i++) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        summary.count += counts[i];
+    }
+    if (summary.count == 0)
+        return summary;
+
+    const double fractions[3] = { 0.5, 0.9, 0.99 };
+    double* percentiles[3] = { &summary.p50, &summary.p90, &summary.p99 };
+    uint64_t seen = 0;
+    int next = 0;
+    for (int i = 0; i < bucketCount && next < 3; i++) {
+        seen += counts[i];
+        while (next < 3 && static_cast<double>(seen) >= fractions[next] * static_cast<double>(summary.count)) {
+            *percentiles[next] = getBucketCenter(i) * 1.0e-3;
+            next++;
+        }
+    }
+    summary.mean = static_cast<double>(sum.load(std::memory_order_relaxed)) / static_cast<double>(summary.count) * 1.0e-3;
+    summary.maximum = static_cast<double>(maximum.load(std::memory_order_relaxed)) * 1.0e-3;
+    // Percentiles of the bucket centers may exceed the exact maximum
+    summary.p50 = std::min(summary.p50, summary.maximum);
+    summary.p90 = std::min(summary.p90, summary.maximum);
+    summary.p99 = std::min(summary.p99, summary.maximum);
+    return summary;
+}
+
+void DurationHistogram::reset()
+{
+    for (std::atomic<uint64_t>& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+}
+
+void StreamInstrumentation::record(uint64_t frameId, uint64_t captureTime, uint64_t dispatchTime,
+    std::chrono::steady_clock::time_point dispatchClock, uint64_t listenerNanoseconds)
+{
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(dispatchClock.time_since_epoch()).count();
+    const int64_t previousDispatch = lastDispatch.exchange(now, std::memory_order_relaxed);
+    const uint64_t previousFrameId = lastFrameId.exchange(frameId, std::memory_order_relaxed);
+    if (previousDispatch != 0) {
+        if (frameId > previousFrameId + 1)
+            dropped.fetch_add(frameId - previousFrameId - 1, std::memory_order_relaxed);
+        if (now > previousDispatch) {
+            const uint64_t elapsed = static_cast<uint64_t>(now - previousDispatch);
+            interval.record(elapsed);
+            const double nanoseconds = static_cast<double>(elapsed);
+            add(intervalSquares, nanoseconds * nanoseconds);
+        }
+    }
+    // Frames stamped ahead of this clock count as no latency
+    latency.record(dispatchTime > captureTime ? (dispatchTime - captureTime) * 1000 : 0);
+    listenerTime.record(listenerNanoseconds);
+    frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+StreamStatistics StreamInstrumentation::getStatistics() const
+{
+    StreamStatistics statistics;
+    statistics.frames = frames.load(std::memory_order_relaxed);
+    statistics.dropped = dropped.load(std::memory_order_relaxed);
+    statistics.latency = latency.getSummary();
+    statistics.interval = interval.getSummary();
+    statistics.listener = listenerTime.getSummary();
+    if (statistics.interval.count > 1) {
+        // The squares and the mean are of the same exact nanoseconds, a constant interval has no jitter
+        const double meanSquares = intervalSquares.load(std::memory_order_relaxed) / static_cast<double>(statistics.interval.count);
+        const double mean = statistics.interval.mean * 1.0e3;
+        statistics.jitter = std::sqrt(std::max(0.0, meanSquares - mean * mean)) * 1.0e-3;
+    }
+    return statistics;
+}
+
+void StreamInstrumentation::resetStatistics()
+{
+    frames.store(0, std::memory_order_relaxed);
+    dropped.store(0, std::memory_order_relaxed);
+    intervalSquares.store(0.0, std::memory_order_relaxed);
+    latency.reset();
+    interval.reset();
+    listenerTime.reset();
+}
+
+std::string StreamInstrumentation::format(const std::string& name, const StreamStatistics& statistics)
+{
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(2);
+    line << name << ": " << statistics.frames << " frames, " << statistics.dropped << " dropped"
+         << ", latency ms mean " << statistics.latency.mean * 1.0e-3 << " p50 " << statistics.latency.p50 * 1.0e-3
+         << " p99 " << statistics.latency.p99 * 1.0e-3 << " max " << statistics.latency.maximum * 1.0e-3
+         << ", interval ms mean " << statistics.interval.mean * 1.0e-3 << " jitter " << statistics.jitter * 1.0e-3
+         << " max " << statistics.interval.maximum * 1.0e-3
+         << ", listener us p50 " << statistics.listener.p50 << " p99 " << statistics.listener.p99 << " max " << statistics.listener.maximum;
+    return line.str();
+}
+
+StreamStatisticsReporter::StreamStatisticsReporter(std::chrono::milliseconds period, Sink sink)
+    : period(period), sink(std::move(sink))
+{
+    if (period.count() <= 0)
+        throw std::invalid_argument("Statistics report period must be positive");
+    if (!this->sink) {
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+        this->sink = [](const std::string& line) { Log::info(line); };
+#else
+        this->sink = [](const std::string& line) { std::clog << line << std::endl; };
+#endif
+    }
+    nextReport = std::chrono::steady_clock::now() + period;
+    thread = std::thread(&StreamStatisticsReporter::run, this);
+}
+
+StreamStatisticsReporter::~StreamStatisticsReporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_one();
+    thread.join();
+}
+
+void StreamStatisticsReporter::add(const std::string& name, StreamInstrumentation& instrumentation)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({ name, &instrumentation });
+}
+
+void StreamStatisticsReporter::remove(StreamInstrumentation& instrumentation)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.instrumentation == &instrumentation; }),
+        entries.end());
+}
+
+void StreamStatisticsReporter::report()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Entry& entry : entries) {
+        sink(StreamInstrumentation::format(entry.name, entry.instrumentation->getStatistics()));
+        entry.instrumentation->resetStatistics();
+    }
+    nextReport = std::chrono::steady_clock::now() + period;
+}
+
+void StreamStatisticsReporter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (condition.wait_until(lock, nextReport, [this] { return stopping; }))
+            break;
+        if (std::chrono::steady_clock::now() < nextReport)
+            continue;
+        lock.unlock();
+        report();
+        lock.lock();
+    }
+}
+
+}
@@ -0,0 +1,315 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/sense/eyetracker/eyepredictor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "sr/sense/eyetracker/eyepairhistory.h"
+
+namespace SR {
+
+namespace {
+
+// Both eyes, x y and z each
+constexpr int coordinates = 6;
+
+double& coordinate(SR_eyePair& pair, int index)
+{
+    return pair.eyes[index / 3].p[index % 3];
+}
+
+double coordinate(const SR_eyePair& pair, int index)
+{
+    return pair.eyes[index / 3].p[index % 3];
+}
+
+// Bookkeeping shared by all models: the newest sample time and the polynomial in the horizon that every model
+// leaves after accept(), so predictions at any number of times only evaluate it
+class PredictorBase : public EyePredictor {
+public:
+    explicit PredictorBase(const EyePredictorSettings& settings) : settings(settings) {}
+
+    const EyePredictorSettings& getSettings() const override { return settings; }
+
+    bool predict(uint64_t time, SR_eyePair& output) const override
+    {
+        return predict(&time, 1, &output);
+    }
+
+    bool predict(const uint64_t* times, size_t count, SR_eyePair* outputs) const override
+    {
+        if (!hasSample)
+            return false;
+        for (size_t i = 0; i < count; i++) {
+            const double horizon = getHorizon(times[i]);
+            // Horner over the coefficient rows, the inner loops run over the contiguous coordinates and vectorize
+            double values[coordinates];
+            for (int c = 0; c < coordinates; c++)
+                values[c] = coefficients[order - 1][c];
+            for (int k = order - 2; k >= 0; k--)
+                for (int c = 0; c < coordinates; c++)
+                    values[c] = values[c] * horizon + coefficients[k][c];
+            for (int c = 0; c < coordinates; c++)
+                coordinate(outputs[i], c) = values[c];
+            outputs[i].frameId = newestFrameId;
+            outputs[i].time = times[i];
+        }
+        return true;
+    }
+
+protected:
+    // False if frame is not newer than the previous sample, otherwise stores its time and returns the seconds since the previous sample
+    bool advance(const SR_eyePair& frame, double& elapsed)
+    {
+        if (hasSample && frame.time <= newestTime)
+            return false;
+        elapsed = hasSample ? static_cast<double>(frame.time - newestTime) * 1.0e-6 : 0.0;
+        newestTime = frame.time;
+        newestFrameId = frame.frameId;
+        hasSample = true;
+        return true;
+    }
+
+    void forget()
+    {
+        hasSample = false;
+    }
+
+    // Seconds from the newest sample to time, clamped to [0, maximumHorizon]
+    double getHorizon(uint64_t time) const
+    {
+        if (time <= newestTime)
+            return 0.0;
+        return static_cast<double>(std::min(time - newestTime, settings.maximumHorizon)) * 1.0e-6;
+    }
+
+    EyePredictorSettings settings;
+    bool hasSample = false;
+    uint64_t newestTime = 0;
+    uint64_t newestFrameId = 0;
+
+    // Position, velocity and half the acceleration at the newest sample, the first order rows are used
+    double coefficients[3][coordinates] = {};
+    int order = 1;
+};
+
+// Least squares polynomial through the newest window samples, evaluated at the prediction time
+class PolynomialPredictor final : public PredictorBase {
+public:
+    PolynomialPredictor(const EyePredictorSettings& settings, int degree) : PredictorBase(settings), degree(degree) {}
+
+    void accept(const SR_eyePair& frame) override
+    {
+        double elapsed;
+        if (!advance(frame, elapsed))
+            return;
+        history.push(frame);
+
+        const SR_eyePair& newest = history.newest();
+        const int count = static_cast<int>(std::min(history.size(), settings.window));
+        order = std::min(degree, count - 1) + 1;
+
+        // Normal equations of all coordinates at once, times in seconds relative to the newest sample
+        double moments[5] = {};
+        double system[3][3 + coordinates] = {};
+        for (int i = 0; i < count; i++) {
+            const SR_eyePair& sample = history[i];
+            const double t = -static_cast<double>(newest.time - sample.time) * 1.0e-6;
+            double power = 1.0;
+            for (int k = 0; k < 2 * order - 1; k++) {
+                moments[k] += power;
+                if (k < order)
+                    for (int c = 0; c < coordinates; c++)
+                        system[k][3 + c] += power * coordinate(sample, c);
+                power *= t;
+            }
+        }
+        for (int row = 0; row < order; row++)
+            for (int column = 0; column < order; column++)
+                system[row][column] = moments[row + column];
+
+        if (!solve(system, order, coefficients)) {
+            order = 1;
+            for (int c = 0; c < coordinates; c++)
+                coefficients[0][c] = coordinate(newest, c);
+        }
+    }
+
+    void reset() override
+    {
+        history.clear();
+        forget();
+    }
+
+private:
+    // Gaussian elimination with partial pivoting, false if the samples do not determine the polynomial
+    static bool solve(double (&system)[3][3 + coordinates], int order, double (&coefficients)[3][coordinates])
+    {
+        for (int pivot = 0; pivot < order; pivot++) {
+            int best = pivot;
+            for (int row = pivot + 1; row < order; row++)
+                if (std::abs(system[row][pivot]) > std::abs(system[best][pivot]))
+                    best = row;
+            if (!(std::abs(system[best][pivot]) > 1.0e-30))
+                return false;
+            if (best != pivot)
+                std::swap(system[best], system[pivot]);
+            for (int row = pivot + 1; row < order; row++) {
+                const double factor = system[row][pivot] / system[pivot][pivot];
+                for (int column = pivot; column < 3 + coordinates; column++)
+                    system[row][column] -= factor * system[pivot][column];
+            }
+        }
+        for (int c = 0; c < coordinates; c++) {
+            for (int row = order - 1; row >= 0; row--) {
+                double value = system[row][3 + c];
+                for (int column = row + 1; column < order; column++)
+                    value -= system[row][column] * coefficients[column][c];
+                coefficients[row][c] = value / system[row][row];
+            }
+        }
+        return true;
+    }
+
+    int degree;
+    EyePairHistory<EyePredictorSettings::maximumWindow> history;
+};
+
+// Constant velocity Kalman filter per coordinate, driven by white acceleration noise
+class KalmanPredictor final : public PredictorBase {
+public:
+    using PredictorBase::PredictorBase;
+
+    void accept(const SR_eyePair& frame) override
+    {
+        const bool first = !hasSample;
+        double elapsed;
+        if (!advance(frame, elapsed))
+            return;
+
+        const double q = settings.processNoise;
+        const double r = settings.measurementNoise * settings.measurementNoise;
+        for (int c = 0; c < coordinates; c++) {
+            State& s = states[c];
+            const double measurement = coordinate(frame, c);
+            if (first) {
+                s = State{ measurement, 0.0, r, 0.0, initialVelocityVariance };
+            } else {
+                const double dt = elapsed;
+                s.position += s.velocity * dt;
+                s.p00 += dt * (2.0 * s.p01 + dt * s.p11) + q * dt * dt * dt / 3.0;
+                s.p01 += dt * s.p11 + q * dt * dt / 2.0;
+                s.p11 += q * dt;
+
+                const double innovation = s.p00 + r;
+                const double k0 = s.p00 / innovation;
+                const double k1 = s.p01 / innovation;
+                const double residual = measurement - s.position;
+                s.position += k0 * residual;
+                s.velocity += k1 * residual;
+                s.p11 -= k1 * s.p01;
+                s.p00 -= k0 * s.p00;
+                s.p01 -= k0 * s.p01;
+            }
+            coefficients[0][c] = s.position;
+            coefficients[1][c] = s.velocity;
+        }
+        order = 2;
+    }
+
+    void reset() override
+    {
+        forget();
+    }
+
+private:
+    // Variance of the unknown velocity at the first sample, (1 m/s)^2
+    static constexpr double initialVelocityVariance = 1.0e6;
+
+    struct State {
+        double position;
+        double velocity;
+        double p00, p01, p11; // Symmetric covariance of position and velocity
+    };
+
+    State states[coordinates] = {};
+};
+
+// One-Euro filter per coordinate, the filtered velocity extrapolates to the prediction time
+class OneEuroPredictor final : public PredictorBase {
+public:
+    using PredictorBase::PredictorBase;
+
+    void accept(const SR_eyePair& frame) override
+    {
+        const bool first = !hasSample;
+        double elapsed;
+        if (!advance(frame, elapsed))
+            return;
+
+        for (int c = 0; c < coordinates; c++) {
+            State& s = states[c];
+            const double measurement = coordinate(frame, c);
+            if (first) {
+                s = State{ measurement, 0.0 };
+            } else {
+                const double rawVelocity = (measurement - s.position) / elapsed;
+                s.velocity += smoothing(settings.derivativeCutoff, elapsed) * (rawVelocity - s.velocity);
+                const double cutoff = settings.minimumCutoff + settings.beta * std::abs(s.velocity);
+                s.position += smoothing(cutoff, elapsed) * (measurement - s.position);
+            }
+            coefficients[0][c] = s.position;
+            coefficients[1][c] = s.velocity;
+        }
+        order = 2;
+    }
+
+    void reset() override
+    {
+        forget();
+    }
+
+private:
+    static double smoothing(double cutoff, double elapsed)
+    {
+        const double pi = 3.14159265358979323846;
+        return 1.0 / (1.0 + 1.0 / (2.0 * pi * cutoff * elapsed));
+    }
+
+    struct State {
+        double position;
+        double velocity;
+    };
+
+    State states[coordinates] = {};
+};
+
+}
+
+std::unique_ptr<EyePredictor> createEyePredictor(const EyePredictorSettings& settings)
+{
+    switch (settings.model) {
+    case EyePredictorModel::ConstantVelocity:
+    case EyePredictorModel::ConstantAcceleration: {
+        const int degree = settings.model == EyePredictorModel::ConstantVelocity ? 1 : 2;
+        if (settings.window < static_cast<size_t>(degree) + 1 || settings.window > EyePredictorSettings::maximumWindow)
+            throw std::invalid_argument("Eye predictor window does not fit the model");
+        return std::make_unique<PolynomialPredictor>(settings, degree);
+    }
+    case EyePredictorModel::Kalman:
+        if (!(settings.processNoise > 0.0) || !(settings.measurementNoise > 0.0))
+            throw std::invalid_argument("Kalman noise must be positive");
+        return std::make_unique<KalmanPredictor>(settings);
+    case EyePredictorModel::OneEuro:
+        if (!(settings.minimumCutoff > 0.0) || !(settings.beta >= 0.0) || !(settings.derivativeCutoff > 0.0))
+            throw std::invalid_argument("One-Euro cutoffs must be positive");
+        return std::make_unique<OneEuroPredictor>(settings);
+    }
+    throw std::invalid_argument("Unknown eye predictor model");
+}
+
+}
@@ -0,0 +1,101 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/sense/eyetracker/fallbackanimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace SR {
+
+namespace {
+
+// Stiffness of EasingCurve::CriticallyDamped, the spring covers 98% of the way by t = 1 before scaling
+constexpr double springRate = 8.0;
+
+double springStep(double t)
+{
+    return 1.0 - (1.0 + springRate * t) * std::exp(-springRate * t);
+}
+
+}
+
+double FallbackAnimator::evaluate(EasingCurve curve, double progress)
+{
+    const double t = std::min(std::max(progress, 0.0), 1.0);
+    switch (curve) {
+    case EasingCurve::Linear:
+        return t;
+    case EasingCurve::SmoothStep:
+        return t * t * (3.0 - 2.0 * t);
+    case EasingCurve::SmootherStep:
+        return t * t * t * (t * (6.0 * t - 15.0) + 10.0);
+    case EasingCurve::EaseOutCubic:
+        return 1.0 - (1.0 - t) * (1.0 - t) * (1.0 - t);
+    case EasingCurve::CriticallyDamped:
+        return springStep(t) / springStep(1.0);
+    }
+    return t;
+}
+
+FallbackAnimator::FallbackAnimator(const FallbackAnimatorSettings& settings)
+    : settings(settings)
+{
+    if (settings.tableSize < 2)
+        throw std::invalid_argument("Fallback animator tables need at least two samples");
+
+    const EasingCurve curves[2] = { settings.fallbackCurve, settings.reacquireCurve };
+    for (int i = 0; i < 2; i++) {
+        // One extra sample, so the lookup at progress 1 interpolates without a bounds check
+        tables[i].resize(settings.tableSize + 1);
+        for (size_t j = 0; j <= settings.tableSize; j++)
+            tables[i][j] = static_cast<float>(evaluate(curves[i], static_cast<double>(j) / static_cast<double>(settings.tableSize)));
+    }
+    for (int c = 0; c < 3; c++) {
+        defaultEyes[0].p[c] = settings.defaultLeft[c];
+        defaultEyes[1].p[c] = settings.defaultRight[c];
+    }
+    std::copy(defaultEyes, defaultEyes + 2, from);
+    std::copy(defaultEyes, defaultEyes + 2, current);
+}
+
+void FallbackAnimator::setTracking(bool value, uint64_t time)
+{
+    if (value == tracking)
+        return;
+    tracking = value;
+    std::copy(current, current + 2, from);
+    start = tracking ? time : time + settings.lostDelay;
+    const uint64_t duration = tracking ? settings.reacquireDuration : settings.fallbackDuration;
+    // A zero duration becomes a jump within a microsecond
+    inverseDuration = 1.0 / static_cast<double>(std::max<uint64_t>(duration, 1));
+}
+
+bool FallbackAnimator::isSettled(uint64_t time) const
+{
+    return static_cast<double>(time > start ? time - start : 0) * inverseDuration >= 1.0;
+}
+
+void FallbackAnimator::update(uint64_t time, const SR_eyePair& tracked, SR_eyePair& output)
+{
+    // Progress clamps to [0, 1] with min and max, the table index cannot reach past the extra sample
+    const double elapsed = static_cast<double>(static_cast<int64_t>(time - start));
+    const double progress = std::min(std::max(elapsed * inverseDuration, 0.0), 1.0);
+    const double position = progress * static_cast<double>(settings.tableSize);
+    const size_t index = std::min(static_cast<size_t>(position), settings.tableSize - 1);
+    const float* table = tables[tracking ? 1 : 0].data();
+    const double weight = table[index] + (table[index + 1] - table[index]) * (position - static_cast<double>(index));
+
+    const SR_point3d* target = tracking ? tracked.eyes : defaultEyes;
+    for (int e = 0; e < 2; e++)
+        for (int c = 0; c < 3; c++)
+            current[e].p[c] = from[e].p[c] + (target[e].p[c] - from[e].p[c]) * weight;
+
+    std::copy(current, current + 2, output.eyes);
+    output.frameId = tracked.frameId;
+    output.time = time;
+}
+
+}
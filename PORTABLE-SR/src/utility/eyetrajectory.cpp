@@ -0,0 +1,143 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/utility/eyetrajectory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace SR {
+
+namespace {
+
+bool isSorted(const std::vector<EyeTrajectory::Keyframe>& keyframes)
+{
+    return std::is_sorted(keyframes.begin(), keyframes.end(),
+        [](const EyeTrajectory::Keyframe& a, const EyeTrajectory::Keyframe& b) { return a.time < b.time; });
+}
+
+}
+
+EyeTrajectory::EyeTrajectory(std::vector<Keyframe> frames)
+    : keyframes(std::move(frames))
+{
+    if (keyframes.empty() || !isSorted(keyframes))
+        throw std::invalid_argument("Eye trajectory keyframes must be sorted by time");
+}
+
+EyeTrajectory EyeTrajectory::sway(const float center[3], float amplitude, double frequency, double duration)
+{
+    const double pi = 3.14159265358979323846;
+    const int count = std::max(1, static_cast<int>(std::ceil(duration * 1000.0)));
+    std::vector<Keyframe> frames(static_cast<size_t>(count) + 1);
+    for (int i = 0; i <= count; i++) {
+        Keyframe& frame = frames[i];
+        frame.time = duration * i / count;
+        frame.position[0] = center[0] + amplitude * static_cast<float>(std::sin(2.0 * pi * frequency * frame.time));
+        frame.position[1] = center[1];
+        frame.position[2] = center[2];
+    }
+    return EyeTrajectory(std::move(frames));
+}
+
+EyeTrajectory EyeTrajectory::randomWalk(const float center[3], float deviation, double duration, uint32_t seed)
+{
+    // The velocity is a random process that decorrelates over half a second, the position drifts back to the center over
+    // two seconds. The stationary variance of the position is velocity variance / (pull * (pull + velocityDecay)).
+    const double interval = 0.001;
+    const double pull = 1.0 / 2.0;
+    const double velocityDecay = 1.0 / 0.5;
+    const double velocityDeviation = deviation * std::sqrt(pull * (pull + velocityDecay));
+    const double decay = std::exp(-interval * velocityDecay);
+    const double spread = velocityDeviation * std::sqrt(1.0 - decay * decay);
+    const int count = std::max(1, static_cast<int>(std::ceil(duration * 1000.0)));
+
+    std::mt19937 random(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    double offset[3] = {};
+    double velocity[3] = {};
+    std::vector<Keyframe> frames(static_cast<size_t>(count) + 1);
+    for (int i = 0; i <= count; i++) {
+        Keyframe& frame = frames[i];
+        frame.time = duration * i / count;
+        for (int c = 0; c < 3; c++) {
+            if (i > 0) {
+                velocity[c] = decay * velocity[c] + spread * normal(random);
+                offset[c] += (velocity[c] - pull * offset[c]) * interval;
+            }
+            frame.position[c] = center[c] + static_cast<float>(offset[c]);
+        }
+    }
+    return EyeTrajectory(std::move(frames));
+}
+
+EyeTrajectory EyeTrajectory::step(const float from[3], const float to[3], double stepTime, double duration)
+{
+    // Two keyframes at stepTime, evaluate() returns the second one from stepTime on
+    std::vector<Keyframe> frames(4);
+    frames[0].time = 0.0;
+    frames[1].time = std::max(stepTime, 0.0);
+    frames[2].time = frames[1].time;
+    frames[3].time = std::max(duration, frames[1].time);
+    for (int c = 0; c < 3; c++) {
+        frames[0].position[c] = frames[1].position[c] = from[c];
+        frames[2].position[c] = frames[3].position[c] = to[c];
+    }
+    return EyeTrajectory(std::move(frames));
+}
+
+bool EyeTrajectory::load(const std::string& path, EyeTrajectory& trajectory)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    std::vector<Keyframe> frames;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream stream(line);
+        Keyframe frame;
+        if (!(stream >> frame.time >> frame.position[0] >> frame.position[1] >> frame.position[2]))
+            return false;
+        frames.push_back(frame);
+    }
+    if (frames.empty() || !isSorted(frames))
+        return false;
+    trajectory = EyeTrajectory(std::move(frames));
+    return true;
+}
+
+void EyeTrajectory::evaluate(double time, float position[3]) const
+{
+    if (keyframes.empty()) {
+        std::fill(position, position + 3, 0.0f);
+        return;
+    }
+
+    auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+        [](double t, const Keyframe& frame) { return t < frame.time; });
+    if (next == keyframes.begin() || next == keyframes.end()) {
+        const Keyframe& frame = next == keyframes.begin() ? keyframes.front() : keyframes.back();
+        std::copy(frame.position, frame.position + 3, position);
+        return;
+    }
+
+    const Keyframe& previous = *(next - 1);
+    const float blend = static_cast<float>((time - previous.time) / (next->time - previous.time));
+    for (int i = 0; i < 3; i++)
+        position[i] = previous.position[i] + blend * (next->position[i] - previous.position[i]);
+}
+
+double EyeTrajectory::getDuration() const
+{
+    return keyframes.empty() ? 0.0 : keyframes.back().time;
+}
+
+}
@@ -0,0 +1,59 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace SR {
+
+/*!
+ * \brief Read-only memory mapping of a whole file
+ *
+ * The mapping is shared, so every process that maps the same file uses the same physical pages.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /*!
+     * \brief Maps path, replacing the current mapping
+     * \return false if the file cannot be opened or mapped, the object is empty in that case
+     */
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const unsigned char* getData() const { return data; }
+    size_t getSize() const { return size; }
+
+    /*!
+     * \brief Size of a memory page, mapped offsets aligned to it can be handed out without copying
+     */
+    static size_t getPageSize();
+
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    void* mapping = nullptr;
+#endif
+};
+
+/*!
+ * \brief Replaces path with content in one step, so readers either see the old or the complete new file
+ *
+ * The content is written to a temporary file next to path, unique per call, that is then renamed over it.
+ * \return false if the file could not be written
+ */
+bool writeFileAtomically(const std::string& path, const void* header, size_t headerSize, const void* payload, size_t payloadSize);
+
+}
@@ -0,0 +1,260 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "utility/sharedmemory.h"
+
+#include <chrono>
+#include <thread>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace SR {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+    "Shared words must be plain lock-free integers");
+
+SharedMemory::~SharedMemory()
+{
+    close();
+}
+
+std::string SharedMemory::makeUniqueName(const std::string& prefix)
+{
+    static std::atomic<uint64_t> counter{ 0 };
+#if defined(_WIN32)
+    const uint64_t process = GetCurrentProcessId();
+#else
+    const uint64_t process = static_cast<uint64_t>(getpid());
+#endif
+    // The time keeps names apart when a process id is reused after a crash left a name behind
+    const uint64_t time = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return prefix + "-" + std::to_string(process) + "-" + std::to_string(counter++) + "-" + std::to_string(time % 1000000007);
+}
+
+#if defined(_WIN32)
+
+bool SharedMemory::create(const std::string& name, size_t size)
+{
+    close();
+    const uint64_t size64 = size;
+    mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32),
+        static_cast<DWORD>(size64), ("Local\\" + name).c_str());
+    if (mapping != nullptr && GetLastError() == ERROR_ALREADY_EXISTS) {
+        CloseHandle(mapping);
+        mapping = nullptr;
+    }
+    if (mapping == nullptr)
+        return false;
+    data = static_cast<unsigned char*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    if (data == nullptr) {
+        close();
+        return false;
+    }
+    this->size = size;
+    this->name = name;
+    return true;
+}
+
+bool SharedMemory::open(const std::string& name)
+{
+    close();
+    mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, ("Local\\" + name).c_str());
+    if (mapping == nullptr)
+        return false;
+    data = static_cast<unsigned char*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    MEMORY_BASIC_INFORMATION info;
+    if (data == nullptr || VirtualQuery(data, &info, sizeof(info)) == 0) {
+        close();
+        return false;
+    }
+    size = static_cast<size_t>(info.RegionSize);
+    this->name = name;
+    return true;
+}
+
+void SharedMemory::close()
+{
+    if (data != nullptr)
+        UnmapViewOfFile(data);
+    if (mapping != nullptr)
+        CloseHandle(mapping);
+    data = nullptr;
+    mapping = nullptr;
+    size = 0;
+    name.clear();
+}
+
+void SharedMemory::unlink()
+{
+}
+
+SharedSignal::~SharedSignal()
+{
+    close();
+}
+
+bool SharedSignal::create(const std::string& name, std::atomic<uint32_t>* word)
+{
+    close();
+    event = CreateEventA(nullptr, FALSE, FALSE, ("Local\\" + name).c_str());
+    this->word = word;
+    return event != nullptr;
+}
+
+bool SharedSignal::open(const std::string& name, std::atomic<uint32_t>* word)
+{
+    close();
+    event = OpenEventA(EVENT_MODIFY_STATE | SYNCHRONIZE, FALSE, ("Local\\" + name).c_str());
+    this->word = word;
+    return event != nullptr;
+}
+
+void SharedSignal::close()
+{
+    if (event != nullptr)
+        CloseHandle(event);
+    event = nullptr;
+    word = nullptr;
+}
+
+void SharedSignal::wait(uint32_t expected, uint32_t timeoutMilliseconds)
+{
+    if (word->load() == expected)
+        WaitForSingleObject(event, timeoutMilliseconds);
+}
+
+void SharedSignal::notify()
+{
+    word->fetch_add(1);
+    SetEvent(event);
+}
+
+#else
+
+bool SharedMemory::create(const std::string& name, size_t size)
+{
+    close();
+    const std::string path = "/" + name;
+    const int file = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (file < 0)
+        return false;
+    void* address = MAP_FAILED;
+    if (ftruncate(file, static_cast<off_t>(size)) == 0)
+        address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    ::close(file);
+    if (address == MAP_FAILED) {
+        shm_unlink(path.c_str());
+        return false;
+    }
+    data = static_cast<unsigned char*>(address);
+    this->size = size;
+    this->name = name;
+    return true;
+}
+
+bool SharedMemory::open(const std::string& name)
+{
+    close();
+    const int file = shm_open(("/" + name).c_str(), O_RDWR, 0600);
+    if (file < 0)
+        return false;
+    struct stat status;
+    void* address = MAP_FAILED;
+    if (fstat(file, &status) == 0 && status.st_size > 0)
+        address = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    ::close(file);
+    if (address == MAP_FAILED)
+        return false;
+    data = static_cast<unsigned char*>(address);
+    size = static_cast<size_t>(status.st_size);
+    return true;
+}
+
+void SharedMemory::close()
+{
+    unlink();
+    if (data != nullptr)
+        munmap(data, size);
+    data = nullptr;
+    size = 0;
+}
+
+void SharedMemory::unlink()
+{
+    // Only the creating process knows the name, it unlinks once
+    if (!name.empty())
+        shm_unlink(("/" + name).c_str());
+    name.clear();
+}
+
+SharedSignal::~SharedSignal()
+{
+    close();
+}
+
+bool SharedSignal::create(const std::string&, std::atomic<uint32_t>* word)
+{
+    this->word = word;
+    return true;
+}
+
+bool SharedSignal::open(const std::string&, std::atomic<uint32_t>* word)
+{
+    this->word = word;
+    return true;
+}
+
+void SharedSignal::close()
+{
+    word = nullptr;
+}
+
+#if defined(__linux__)
+
+// Without FUTEX_PRIVATE_FLAG, so the futex works across processes that map the word at different addresses
+void SharedSignal::wait(uint32_t expected, uint32_t timeoutMilliseconds)
+{
+    const timespec timeout = { static_cast<time_t>(timeoutMilliseconds / 1000), static_cast<long>(timeoutMilliseconds % 1000) * 1000000 };
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+void SharedSignal::notify()
+{
+    word->fetch_add(1);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+#else
+
+void SharedSignal::wait(uint32_t expected, uint32_t timeoutMilliseconds)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+    while (word->load() == expected && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+void SharedSignal::notify()
+{
+    word->fetch_add(1);
+}
+
+#endif
+
+#endif
+
+}
@@ -0,0 +1,103 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace SR {
+
+/*!
+ * \brief Named read-write memory shared between processes on the same host
+ *
+ * POSIX shared memory on Linux and macOS, a pagefile backed file mapping on Windows. The memory is zero filled when created.
+ */
+class SharedMemory {
+public:
+    SharedMemory() = default;
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    /*!
+     * \return false if the name exists already or the memory cannot be mapped
+     */
+    bool create(const std::string& name, size_t size);
+
+    /*!
+     * \brief Maps memory created by another process
+     * \return false if there is no memory with this name
+     */
+    bool open(const std::string& name);
+
+    void close();
+
+    /*!
+     * \brief Removes the name, so the memory is released with the last mapping even if a process crashes
+     *
+     * Processes that mapped it keep using it. On Windows the name lives as long as the mapping, this does nothing.
+     */
+    void unlink();
+
+    bool isOpen() const { return data != nullptr; }
+    unsigned char* getData() const { return data; }
+    size_t getSize() const { return size; }
+
+    /*!
+     * \brief Name starting with \p prefix that no other process on this host creates, from the process id, a counter and the time
+     */
+    static std::string makeUniqueName(const std::string& prefix);
+
+private:
+    unsigned char* data = nullptr;
+    size_t size = 0;
+    std::string name;
+#if defined(_WIN32)
+    void* mapping = nullptr;
+#endif
+};
+
+/*!
+ * \brief Wakes a thread of another process that waits for a 32-bit word in shared memory to change
+ *
+ * A futex on Linux and a named auto-reset event on Windows. Other systems poll the word every 100 microseconds.
+ */
+class SharedSignal {
+public:
+    SharedSignal() = default;
+    ~SharedSignal();
+
+    SharedSignal(const SharedSignal&) = delete;
+    SharedSignal& operator=(const SharedSignal&) = delete;
+
+    /*!
+     * \param name Names the event on Windows, the process that creates the shared memory creates the signal as well
+     * \param word Lies in shared memory, notify() changes it
+     */
+    bool create(const std::string& name, std::atomic<uint32_t>* word);
+    bool open(const std::string& name, std::atomic<uint32_t>* word);
+    void close();
+
+    /*!
+     * \brief Returns when the word no longer holds \p expected, on notify() or after the timeout, may return spuriously
+     */
+    void wait(uint32_t expected, uint32_t timeoutMilliseconds);
+
+    /*!
+     * \brief Changes the word and wakes the waiting thread
+     */
+    void notify();
+
+private:
+    std::atomic<uint32_t>* word = nullptr;
+#if defined(_WIN32)
+    void* event = nullptr;
+#endif
+};
+
+}
@@ -0,0 +1,118 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/utility/simd.h"
+
+#include <atomic>
+
+#if defined(SRPORTABLE_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace SR {
+
+namespace {
+
+#if defined(SRPORTABLE_SIMD_X86)
+bool cpuSupportsAVX2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool cpuSupportsAVX512()
+{
+#if defined(_MSC_VER)
+    if (!cpuSupportsAVX2() || (_xgetbv(0) & 0xe6) != 0xe6)
+        return false;
+    int info[4];
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 16)) != 0;
+#else
+    return __builtin_cpu_supports("avx512f");
+#endif
+}
+#endif
+
+SIMDLevel detectSIMDLevel()
+{
+#if defined(SRPORTABLE_SIMD_X86)
+    if (cpuSupportsAVX512())
+        return SIMDLevel::AVX512;
+    if (cpuSupportsAVX2())
+        return SIMDLevel::AVX2;
+    return SIMDLevel::SSE2;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    return SIMDLevel::NEON;
+#else
+    return SIMDLevel::Scalar;
+#endif
+}
+
+std::atomic<SIMDLevel>& activeLevel()
+{
+    static std::atomic<SIMDLevel> level(getSupportedSIMDLevel());
+    return level;
+}
+
+}
+
+SIMDLevel getSupportedSIMDLevel()
+{
+    static const SIMDLevel supported = detectSIMDLevel();
+    return supported;
+}
+
+SIMDLevel getSIMDLevel()
+{
+    return activeLevel().load(std::memory_order_relaxed);
+}
+
+bool isSIMDLevelSupported(SIMDLevel level)
+{
+    const SIMDLevel supported = getSupportedSIMDLevel();
+    switch (level) {
+    case SIMDLevel::Scalar:
+        return true;
+    case SIMDLevel::SSE2:
+    case SIMDLevel::AVX2:
+    case SIMDLevel::AVX512:
+        return supported != SIMDLevel::NEON && supported != SIMDLevel::Scalar && level <= supported;
+    case SIMDLevel::NEON:
+        return supported == SIMDLevel::NEON;
+    }
+    return false;
+}
+
+bool setSIMDLevel(SIMDLevel level)
+{
+    if (!isSIMDLevelSupported(level))
+        return false;
+    activeLevel().store(level, std::memory_order_relaxed);
+    return true;
+}
+
+const char* getSIMDLevelName(SIMDLevel level)
+{
+    switch (level) {
+    case SIMDLevel::Scalar: return "scalar";
+    case SIMDLevel::SSE2:   return "sse2";
+    case SIMDLevel::AVX2:   return "avx2";
+    case SIMDLevel::AVX512: return "avx512";
+    case SIMDLevel::NEON:   return "neon";
+    }
+    return "unknown";
+}
+
+}
@@ -0,0 +1,154 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace SR {
+
+/*!
+ * \brief Thin float vector wrappers used to write a kernel once and instantiate it per instruction set
+ *
+ * Every wrapper performs exactly one IEEE operation per element for add, sub, mul, div and sqrt,
+ * so a kernel instantiated for any of them gives bit-exact identical results as long as it is compiled
+ * without floating point contraction. min and max follow the x86 convention of returning the second
+ * operand when the comparison fails, which only matters for signed zeros and NaNs.
+ *
+ * The wrappers live in an unnamed namespace: every translation unit is compiled for its own instruction set
+ * and must not share inline copies with translation units built for another one.
+ */
+namespace SIMD {
+namespace {
+
+struct Scalar {
+    using Float = float;
+    static constexpr int width = 1;
+
+    static Float set(float value) { return value; }
+    static Float load(const float* p) { return *p; }
+    static void store(float* p, Float v) { *p = v; }
+    static Float index(int32_t first) { return static_cast<float>(first); }
+    static Float add(Float a, Float b) { return a + b; }
+    static Float sub(Float a, Float b) { return a - b; }
+    static Float mul(Float a, Float b) { return a * b; }
+    static Float div(Float a, Float b) { return a / b; }
+    static Float sqrt(Float a) { return sqrtf(a); }
+    static Float floor(Float a) { return floorf(a); }
+    static Float abs(Float a) { return fabsf(a); }
+    static Float min(Float a, Float b) { return a < b ? a : b; }
+    static Float max(Float a, Float b) { return a > b ? a : b; }
+};
+
+#if defined(__SSE2__) || defined(_M_X64)
+struct SSE2 {
+    using Float = __m128;
+    static constexpr int width = 4;
+
+    static Float set(float value) { return _mm_set1_ps(value); }
+    static Float load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, Float v) { _mm_storeu_ps(p, v); }
+    static Float index(int32_t first) { return _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(first), _mm_setr_epi32(0, 1, 2, 3))); }
+    static Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm_div_ps(a, b); }
+    static Float sqrt(Float a) { return _mm_sqrt_ps(a); }
+    static Float floor(Float a)
+    {
+        // SSE2 has no rounding instruction, truncate and correct negative values (exact below 2^31)
+        const Float truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+        return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a), _mm_set1_ps(1.0f)));
+    }
+    static Float abs(Float a) { return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff))); }
+    static Float min(Float a, Float b) { return _mm_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm_max_ps(a, b); }
+};
+#endif
+
+#if defined(__AVX2__)
+struct AVX2 {
+    using Float = __m256;
+    static constexpr int width = 8;
+
+    static Float set(float value) { return _mm256_set1_ps(value); }
+    static Float load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Float v) { _mm256_storeu_ps(p, v); }
+    static Float index(int32_t first) { return _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(first), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))); }
+    static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm256_div_ps(a, b); }
+    static Float sqrt(Float a) { return _mm256_sqrt_ps(a); }
+    static Float floor(Float a) { return _mm256_floor_ps(a); }
+    static Float abs(Float a) { return _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff))); }
+    static Float min(Float a, Float b) { return _mm256_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm256_max_ps(a, b); }
+};
+#endif
+
+#if defined(__AVX512F__)
+struct AVX512 {
+    using Float = __m512;
+    static constexpr int width = 16;
+
+    static Float set(float value) { return _mm512_set1_ps(value); }
+    static Float load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, Float v) { _mm512_storeu_ps(p, v); }
+    static Float index(int32_t first)
+    {
+        return _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(first), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+    }
+    static Float add(Float a, Float b) { return _mm512_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm512_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm512_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm512_div_ps(a, b); }
+    static Float sqrt(Float a) { return _mm512_sqrt_ps(a); }
+    static Float floor(Float a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+    static Float abs(Float a) { return _mm512_abs_ps(a); }
+    static Float min(Float a, Float b) { return _mm512_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm512_max_ps(a, b); }
+};
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+struct NEON {
+    using Float = float32x4_t;
+    static constexpr int width = 4;
+
+    static Float set(float value) { return vdupq_n_f32(value); }
+    static Float load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, Float v) { vst1q_f32(p, v); }
+    static Float index(int32_t first)
+    {
+        static const int32_t offsets[4] = { 0, 1, 2, 3 };
+        return vcvtq_f32_s32(vaddq_s32(vdupq_n_s32(first), vld1q_s32(offsets)));
+    }
+    static Float add(Float a, Float b) { return vaddq_f32(a, b); }
+    static Float sub(Float a, Float b) { return vsubq_f32(a, b); }
+    static Float mul(Float a, Float b) { return vmulq_f32(a, b); }
+    static Float div(Float a, Float b) { return vdivq_f32(a, b); }
+    static Float sqrt(Float a) { return vsqrtq_f32(a); }
+    static Float floor(Float a) { return vrndmq_f32(a); }
+    static Float abs(Float a) { return vabsq_f32(a); }
+    static Float min(Float a, Float b) { return vbslq_f32(vcltq_f32(a, b), a, b); }
+    static Float max(Float a, Float b) { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+};
+#endif
+
+}
+}
+
+}
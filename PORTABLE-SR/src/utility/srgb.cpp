@@ -0,0 +1,179 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/utility/srgb.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#include "sr/utility/half.h"
+#include "sr/utility/simd.h"
+#include "utility/srgbtables.h"
+
+namespace SR {
+
+namespace {
+
+float decodeReference(float value)
+{
+    if (value <= 0.04045f)
+        return value / 12.92f;
+    return std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float encodeReference(float value)
+{
+    if (value <= 0.0031308f)
+        return value * 12.92f;
+    return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+float fromBits(uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::unique_ptr<SRGBTables> buildTables()
+{
+    std::unique_ptr<SRGBTables> tables(new SRGBTables());
+    for (int i = 0; i < 256; i++) {
+        tables->decode[i] = decodeReference(static_cast<float>(i) / 255.0f);
+        tables->decodeHalf[i] = floatToHalf(tables->decode[i]);
+    }
+
+    // The encoding is monotonic in the float bits of [0, 1], so every threshold is found by bisection
+    const uint32_t oneBits = 0x3f800000u;
+    tables->thresholds[0] = 0.0f;
+    for (int code = 1; code < 256; code++) {
+        uint32_t low = 0;
+        uint32_t high = oneBits + 1;
+        while (low < high) {
+            const uint32_t middle = low + (high - low) / 2;
+            if (encodeSRGBReference(fromBits(middle)) >= code)
+                high = middle;
+            else
+                low = middle + 1;
+        }
+        tables->thresholds[code] = low <= oneBits ? fromBits(low) : std::numeric_limits<float>::infinity();
+    }
+    tables->thresholds[256] = std::numeric_limits<float>::infinity();
+
+    // A bucket spans 1/128 of an octave, that is far below the distance between two thresholds
+    for (size_t bucket = 0; bucket < SRGBTables::encodeBucketCount; bucket++) {
+        const float lowest = fromBits(static_cast<uint32_t>(bucket << SRGBTables::encodeBucketShift));
+        tables->encodeBucket[bucket] = static_cast<uint8_t>(std::upper_bound(tables->thresholds + 1, tables->thresholds + 256, lowest) - (tables->thresholds + 1));
+    }
+    std::fill(tables->encodeBucket + SRGBTables::encodeBucketCount, tables->encodeBucket + SRGBTables::encodeBucketCount + 3, uint8_t(0));
+
+    for (uint32_t half = 0; half < 65536; half++)
+        tables->encodeHalf[half] = encodeSRGB(*tables, halfToFloat(static_cast<uint16_t>(half)));
+    return tables;
+}
+
+void decodeRowScalar(const SRGBTables& tables, const uint8_t* in, float* out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = tables.decode[in[i]];
+}
+
+void encodeRowScalar(const SRGBTables& tables, const float* in, uint8_t* out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = encodeSRGB(tables, in[i]);
+}
+
+const SRGBRowKernels scalarKernels = { &decodeRowScalar, &encodeRowScalar };
+
+const SRGBRowKernels& getRowKernels()
+{
+    const SRGBRowKernels* kernels = nullptr;
+    switch (getSIMDLevel()) {
+    case SIMDLevel::AVX512: kernels = getAVX512SRGBRowKernels(); break;
+    case SIMDLevel::AVX2:   kernels = getAVX2SRGBRowKernels(); break;
+    // Neither has a gather, the scalar table lookup is as fast as it gets there
+    case SIMDLevel::SSE2:
+    case SIMDLevel::NEON:
+    case SIMDLevel::Scalar: break;
+    }
+    return kernels != nullptr ? *kernels : scalarKernels;
+}
+
+}
+
+#if !defined(SRPORTABLE_SIMD_X86)
+const SRGBRowKernels* getAVX2SRGBRowKernels()
+{
+    return nullptr;
+}
+
+const SRGBRowKernels* getAVX512SRGBRowKernels()
+{
+    return nullptr;
+}
+#endif
+
+uint8_t encodeSRGBReference(float value)
+{
+    const float clamped = value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+    const float encoded = encodeReference(clamped);
+    const float quantized = encoded > 0.0f ? (encoded < 1.0f ? encoded : 1.0f) : 0.0f;
+    return static_cast<uint8_t>(quantized * 255.0f + 0.5f);
+}
+
+const SRGBTables& getSRGBTables()
+{
+    static const std::unique_ptr<SRGBTables> tables = buildTables();
+    return *tables;
+}
+
+float srgbToLinear(uint8_t value)
+{
+    return getSRGBTables().decode[value];
+}
+
+uint8_t linearToSrgb(float value)
+{
+    return encodeSRGB(getSRGBTables(), value);
+}
+
+uint16_t srgbToLinearHalf(uint8_t value)
+{
+    return getSRGBTables().decodeHalf[value];
+}
+
+uint8_t linearHalfToSrgb(uint16_t value)
+{
+    return getSRGBTables().encodeHalf[value];
+}
+
+void srgbToLinearRow(const uint8_t* in, float* out, size_t count)
+{
+    getRowKernels().decodeRow(getSRGBTables(), in, out, count);
+}
+
+void linearToSrgbRow(const float* in, uint8_t* out, size_t count)
+{
+    getRowKernels().encodeRow(getSRGBTables(), in, out, count);
+}
+
+void srgbToLinearHalfRow(const uint8_t* in, uint16_t* out, size_t count)
+{
+    const SRGBTables& tables = getSRGBTables();
+    for (size_t i = 0; i < count; i++)
+        out[i] = tables.decodeHalf[in[i]];
+}
+
+void linearHalfToSrgbRow(const uint16_t* in, uint8_t* out, size_t count)
+{
+    const SRGBTables& tables = getSRGBTables();
+    for (size_t i = 0; i < count; i++)
+        out[i] = tables.encodeHalf[in[i]];
+}
+
+}
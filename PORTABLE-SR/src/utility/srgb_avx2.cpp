@@ -0,0 +1,58 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+// Compiled with AVX2 enabled, only called after runtime detection
+#include <immintrin.h>
+
+#include "utility/srgbtables.h"
+
+namespace SR {
+
+namespace {
+
+void decodeRow(const SRGBTables& tables, const uint8_t* in, float* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_ps(out + i, _mm256_i32gather_ps(tables.decode, index, 4));
+    }
+    for (; i < count; i++)
+        out[i] = tables.decode[in[i]];
+}
+
+void encodeRow(const SRGBTables& tables, const float* in, uint8_t* out, size_t count)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256i byteMask = _mm256_set1_epi32(0xff);
+    const __m256i increment = _mm256_set1_epi32(1);
+    const int* buckets = reinterpret_cast<const int*>(tables.encodeBucket);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // max returns its second operand for NaN, so NaN becomes 0 like in encodeSRGB()
+        const __m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(in + i), zero), one);
+        const __m256i bucket = _mm256_srli_epi32(_mm256_castps_si256(value), SRGBTables::encodeBucketShift);
+        const __m256i code = _mm256_and_si256(_mm256_i32gather_epi32(buckets, bucket, 1), byteMask);
+        const __m256 threshold = _mm256_i32gather_ps(tables.thresholds, _mm256_add_epi32(code, increment), 4);
+        const __m256i above = _mm256_castps_si256(_mm256_cmp_ps(value, threshold, _CMP_GE_OQ));
+        const __m256i result = _mm256_sub_epi32(code, above);
+
+        const __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(words, words));
+    }
+    for (; i < count; i++)
+        out[i] = encodeSRGB(tables, in[i]);
+}
+
+const SRGBRowKernels kernels = { &decodeRow, &encodeRow };
+
+}
+
+const SRGBRowKernels* getAVX2SRGBRowKernels()
+{
+    return &kernels;
+}
+
+}
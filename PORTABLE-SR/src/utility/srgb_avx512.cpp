@@ -0,0 +1,55 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+// Compiled with AVX-512F enabled, only called after runtime detection
+#include <immintrin.h>
+
+#include "utility/srgbtables.h"
+
+namespace SR {
+
+namespace {
+
+void decodeRow(const SRGBTables& tables, const uint8_t* in, float* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512i index = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm512_storeu_ps(out + i, _mm512_i32gather_ps(index, tables.decode, 4));
+    }
+    for (; i < count; i++)
+        out[i] = tables.decode[in[i]];
+}
+
+void encodeRow(const SRGBTables& tables, const float* in, uint8_t* out, size_t count)
+{
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512i byteMask = _mm512_set1_epi32(0xff);
+    const __m512i increment = _mm512_set1_epi32(1);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        // max returns its second operand for NaN, so NaN becomes 0 like in encodeSRGB()
+        const __m512 value = _mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(in + i), zero), one);
+        const __m512i bucket = _mm512_srli_epi32(_mm512_castps_si512(value), SRGBTables::encodeBucketShift);
+        const __m512i code = _mm512_and_si512(_mm512_i32gather_epi32(bucket, tables.encodeBucket, 1), byteMask);
+        const __m512 threshold = _mm512_i32gather_ps(_mm512_add_epi32(code, increment), tables.thresholds, 4);
+        const __mmask16 above = _mm512_cmp_ps_mask(value, threshold, _CMP_GE_OQ);
+        const __m512i result = _mm512_mask_add_epi32(code, above, code, increment);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm512_cvtepi32_epi8(result));
+    }
+    for (; i < count; i++)
+        out[i] = encodeSRGB(tables, in[i]);
+}
+
+const SRGBRowKernels kernels = { &decodeRow, &encodeRow };
+
+}
+
+const SRGBRowKernels* getAVX512SRGBRowKernels()
+{
+    return &kernels;
+}
+
+}
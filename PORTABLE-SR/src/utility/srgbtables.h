@@ -0,0 +1,57 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace SR {
+
+/*!
+ * \brief Lookup tables behind sr/utility/srgb.h
+ *
+ * A linear value v in [0, 1] encodes to the number of thresholds that are <= v. encodeBucket, indexed by the float bits
+ * of v shifted right by encodeBucketShift, holds the code of the lowest value of the bucket. Every bucket spans at most
+ * one threshold, so code = encodeBucket[bits >> shift] + (v >= thresholds[code + 1]) is exact.
+ */
+struct SRGBTables {
+    static constexpr int encodeBucketShift = 16;
+    static constexpr size_t encodeBucketCount = (0x3f800000u >> encodeBucketShift) + 1;
+
+    float decode[256];
+    uint16_t decodeHalf[256];
+    float thresholds[257];                 //!< thresholds[k] is the smallest value that encodes to k, thresholds[256] is infinity
+    uint8_t encodeBucket[encodeBucketCount + 3]; //!< Padded so 32-bit gathers of the last entry stay inside the table
+    uint8_t encodeHalf[65536];
+};
+
+const SRGBTables& getSRGBTables();
+
+/*!
+ * \brief Exact reference conversion the tables are built from
+ */
+uint8_t encodeSRGBReference(float value);
+
+struct SRGBRowKernels {
+    void (*decodeRow)(const SRGBTables& tables, const uint8_t* in, float* out, size_t count);
+    void (*encodeRow)(const SRGBTables& tables, const float* in, uint8_t* out, size_t count);
+};
+
+const SRGBRowKernels* getAVX2SRGBRowKernels();
+const SRGBRowKernels* getAVX512SRGBRowKernels();
+
+inline uint8_t encodeSRGB(const SRGBTables& tables, float value)
+{
+    // Written so NaN ends up as 0
+    const float clamped = value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+    uint32_t bits;
+    static_assert(sizeof(bits) == sizeof(clamped), "float must be 32 bits");
+    std::memcpy(&bits, &clamped, sizeof(bits));
+    const unsigned int code = tables.encodeBucket[bits >> SRGBTables::encodeBucketShift];
+    return static_cast<uint8_t>(code + (clamped >= tables.thresholds[code + 1] ? 1 : 0));
+}
+
+}
@@ -0,0 +1,166 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "utility/workstealingpool.h"
+
+#include <algorithm>
+
+namespace SR {
+
+namespace {
+
+uint64_t pack(uint32_t begin, uint32_t end)
+{
+    return (static_cast<uint64_t>(begin) << 32) | end;
+}
+
+uint32_t beginOf(uint64_t bounds)
+{
+    return static_cast<uint32_t>(bounds >> 32);
+}
+
+uint32_t endOf(uint64_t bounds)
+{
+    return static_cast<uint32_t>(bounds);
+}
+
+}
+
+WorkStealingPool::WorkStealingPool(unsigned int threadCount)
+    : ranges(new Range[std::max(1u, threadCount)]), threadCount(std::max(1u, threadCount))
+{
+    threads.reserve(this->threadCount - 1);
+    for (unsigned int worker = 1; worker < this->threadCount; worker++)
+        threads.emplace_back([this, worker]() { workerLoop(worker); });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    startCondition.notify_all();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+unsigned int WorkStealingPool::getThreadCount() const
+{
+    return threadCount;
+}
+
+void WorkStealingPool::run(uint32_t count, const Task& task)
+{
+    if (count == 0)
+        return;
+
+    if (threadCount == 1 || count == 1) {
+        for (uint32_t index = 0; index < count; index++)
+            task(index, 0);
+        return;
+    }
+
+    // Workers are idle between batches, so the ranges can be reset without synchronizing with thieves
+    for (unsigned int worker = 0; worker < threadCount; worker++) {
+        const uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(count) * worker / threadCount);
+        const uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(count) * (worker + 1) / threadCount);
+        ranges[worker].bounds.store(pack(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = &task;
+        busyWorkers = threadCount - 1;
+        generation++;
+    }
+    startCondition.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this]() { return busyWorkers == 0; });
+    currentTask = nullptr;
+}
+
+void WorkStealingPool::workerLoop(unsigned int worker)
+{
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCondition.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+            if (stopping)
+                return;
+            seenGeneration = generation;
+        }
+
+        drain(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+        doneCondition.notify_one();
+    }
+}
+
+void WorkStealingPool::drain(unsigned int worker)
+{
+    const Task& task = *currentTask;
+    uint32_t index = 0;
+    while (takeOwn(worker, index) || steal(worker, index))
+        task(index, worker);
+}
+
+bool WorkStealingPool::takeOwn(unsigned int worker, uint32_t& index)
+{
+    std::atomic<uint64_t>& bounds = ranges[worker].bounds;
+    uint64_t current = bounds.load(std::memory_order_acquire);
+    for (;;) {
+        const uint32_t begin = beginOf(current);
+        const uint32_t end = endOf(current);
+        if (begin >= end)
+            return false;
+        if (bounds.compare_exchange_weak(current, pack(begin + 1, end), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            index = begin;
+            return true;
+        }
+    }
+}
+
+bool WorkStealingPool::steal(unsigned int worker, uint32_t& index)
+{
+    for (;;) {
+        // Steal from the worker with the most work left, that keeps the number of steals logarithmic
+        unsigned int victim = worker;
+        uint64_t victimBounds = 0;
+        uint32_t victimSize = 0;
+        for (unsigned int offset = 1; offset < threadCount; offset++) {
+            const unsigned int candidate = (worker + offset) % threadCount;
+            const uint64_t bounds = ranges[candidate].bounds.load(std::memory_order_acquire);
+            const uint32_t size = beginOf(bounds) < endOf(bounds) ? endOf(bounds) - beginOf(bounds) : 0;
+            if (size > victimSize) {
+                victim = candidate;
+                victimBounds = bounds;
+                victimSize = size;
+            }
+        }
+        if (victimSize == 0)
+            return false;
+
+        const uint32_t begin = beginOf(victimBounds);
+        const uint32_t end = endOf(victimBounds);
+        const uint32_t middle = end - (victimSize + 1) / 2;
+        if (!ranges[victim].bounds.compare_exchange_strong(victimBounds, pack(begin, middle), std::memory_order_acq_rel, std::memory_order_acquire))
+            continue;
+
+        // The own range is empty, so nobody else can modify it until the stolen work is published
+        index = middle;
+        ranges[worker].bounds.store(pack(middle + 1, end), std::memory_order_release);
+        return true;
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SR {
+
+/*!
+ * \brief Persistent thread pool that runs an indexed batch of tasks with work stealing
+ *
+ * The indices of a batch are split into one contiguous range per worker so neighbouring tasks, e.g. adjacent tiles,
+ * run on the same core. A worker that runs out of work steals the upper half of the largest remaining range of
+ * another worker. Ranges are packed into a single atomic word, so taking and stealing work never blocks or allocates.
+ */
+class WorkStealingPool {
+public:
+    /*!
+     * \brief Task of a batch, called with the task index and the index of the worker running it
+     *
+     * Worker indices are in [0, getThreadCount()) and can be used to address per-worker scratch memory.
+     * Tasks must not throw.
+     */
+    using Task = std::function<void(uint32_t index, unsigned int worker)>;
+
+    /*!
+     * \param threadCount Number of workers including the calling thread, at least 1
+     */
+    explicit WorkStealingPool(unsigned int threadCount);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned int getThreadCount() const;
+
+    /*!
+     * \brief Runs task(index, worker) for every index in [0, count) and returns when all of them finished
+     *
+     * The calling thread participates as worker 0. Not reentrant, one batch runs at a time.
+     */
+    void run(uint32_t count, const Task& task);
+
+private:
+    struct alignas(64) Range {
+        std::atomic<uint64_t> bounds{ 0 };
+    };
+
+    void workerLoop(unsigned int worker);
+    void drain(unsigned int worker);
+    bool takeOwn(unsigned int worker, uint32_t& index);
+    bool steal(unsigned int worker, uint32_t& index);
+
+    std::unique_ptr<Range[]> ranges;
+    std::vector<std::thread> threads;
+    const unsigned int threadCount;
+
+    std::mutex mutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+    uint64_t generation = 0;
+    unsigned int busyWorkers = 0;
+    bool stopping = false;
+    const Task* currentTask = nullptr;
+};
+
+}
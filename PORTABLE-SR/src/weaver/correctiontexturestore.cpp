@@ -0,0 +1,311 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/weaver/correctiontexturestore.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "utility/mappedfile.h"
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+#include "sr/weaver/Weaver.h"
+#endif
+
+namespace SR
+{
+    namespace
+    {
+        // Files are written in the byte order of the machine, all supported targets are little-endian
+        struct FileHeader
+        {
+            char     magic[8];
+            uint32_t version;
+            uint32_t type;
+            uint64_t key;
+            uint32_t flipVertical;
+            int32_t  width;
+            int32_t  height;
+            int32_t  channels;
+            int32_t  bitsPerPixel;
+            uint32_t compression;
+            uint64_t payloadOffset;
+            uint64_t payloadSize;
+            uint64_t decodedSize;
+            uint64_t checksum;
+        };
+
+        const char fileMagic[8] = { 'S', 'R', 'C', 'O', 'R', 'T', 'E', 'X' };
+        const uint32_t fileVersion = 1;
+        const size_t minimumPayloadAlignment = 4096;
+
+        uint64_t fnv1a(const unsigned char* data, size_t size)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < size; i++)
+                hash = (hash ^ data[i]) * 1099511628211ull;
+            return hash;
+        }
+
+        /*
+         * Delta encoding: every byte is replaced by its difference to the same byte of the previous pixel, which turns the
+         * smooth correction gradients into long runs. The runs are stored with PackBits: a control byte n < 128 is followed
+         * by n + 1 literal bytes, a control byte n >= 128 by one byte that is repeated n - 126 times.
+         */
+        std::vector<unsigned char> encodeDelta(const unsigned char* data, size_t size, size_t bytesPerPixel)
+        {
+            std::vector<unsigned char> delta(data, data + size);
+            for (size_t i = size; i-- > bytesPerPixel;)
+                delta[i] = static_cast<unsigned char>(data[i] - data[i - bytesPerPixel]);
+
+            std::vector<unsigned char> encoded;
+            encoded.reserve(size / 4 + 16);
+            size_t i = 0;
+            while (i < size)
+            {
+                size_t run = 1;
+                while (i + run < size && run < 129 && delta[i + run] == delta[i])
+                    run++;
+                if (run >= 2)
+                {
+                    encoded.push_back(static_cast<unsigned char>(run + 126));
+                    encoded.push_back(delta[i]);
+                    i += run;
+                    continue;
+                }
+
+                size_t literal = 1;
+                while (i + literal < size && literal < 128 &&
+                    !(i + literal + 1 < size && delta[i + literal] == delta[i + literal + 1]))
+                    literal++;
+                encoded.push_back(static_cast<unsigned char>(literal - 1));
+                encoded.insert(encoded.end(), delta.begin() + i, delta.begin() + i + literal);
+                i += literal;
+            }
+            return encoded;
+        }
+
+        bool decodeDelta(const unsigned char* encoded, size_t encodedSize, unsigned char* out, size_t size, size_t bytesPerPixel)
+        {
+            size_t in = 0;
+            size_t written = 0;
+            while (written < size)
+            {
+                if (in >= encodedSize)
+                    return false;
+                const unsigned int control = encoded[in++];
+                if (control < 128)
+                {
+                    const size_t literal = control + 1;
+                    if (in + literal > encodedSize || written + literal > size)
+                        return false;
+                    std::memcpy(out + written, encoded + in, literal);
+                    in += literal;
+                    written += literal;
+                }
+                else
+                {
+                    const size_t run = control - 126;
+                    if (in >= encodedSize || written + run > size)
+                        return false;
+                    std::memset(out + written, encoded[in++], run);
+                    written += run;
+                }
+            }
+            for (size_t i = bytesPerPixel; i < size; i++)
+                out[i] = static_cast<unsigned char>(out[i] + out[i - bytesPerPixel]);
+            return in == encodedSize;
+        }
+    }
+
+    class CorrectionTexture::Impl
+    {
+    public:
+        MappedFile file;
+        std::vector<unsigned char> decoded;
+        const unsigned char* data = nullptr;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        int bitsPerPixel = 0;
+        size_t size = 0;
+    };
+
+    CorrectionTexture::CorrectionTexture()
+        : pimpl(new Impl())
+    {
+    }
+
+    CorrectionTexture::~CorrectionTexture() = default;
+    CorrectionTexture::CorrectionTexture(CorrectionTexture&& other) noexcept = default;
+    CorrectionTexture& CorrectionTexture::operator=(CorrectionTexture&& other) noexcept = default;
+
+    const unsigned char* CorrectionTexture::getData() const
+    {
+        return pimpl ? pimpl->data : nullptr;
+    }
+
+    int CorrectionTexture::getWidth() const
+    {
+        return pimpl ? pimpl->width : 0;
+    }
+
+    int CorrectionTexture::getHeight() const
+    {
+        return pimpl ? pimpl->height : 0;
+    }
+
+    int CorrectionTexture::getChannels() const
+    {
+        return pimpl ? pimpl->channels : 0;
+    }
+
+    int CorrectionTexture::getBitsPerPixel() const
+    {
+        return pimpl ? pimpl->bitsPerPixel : 0;
+    }
+
+    size_t CorrectionTexture::getSize() const
+    {
+        return pimpl ? pimpl->size : 0;
+    }
+
+    bool CorrectionTexture::isShared() const
+    {
+        return pimpl && pimpl->data != nullptr && pimpl->decoded.empty();
+    }
+
+    CorrectionTextureStore::CorrectionTextureStore(std::string directory)
+        : directory(std::move(directory))
+    {
+    }
+
+    std::string CorrectionTextureStore::getPath(WeaverTextureType type, uint64_t key, bool flipVertical) const
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "correction%c-%016llx%s.srtex", type == CorrectionA ? 'A' : 'B',
+            static_cast<unsigned long long>(key), flipVertical ? "-flipped" : "");
+        if (directory.empty())
+            return name;
+        const char last = directory.back();
+        return (last == '/' || last == '\\') ? directory + name : directory + "/" + name;
+    }
+
+    WeaverErrorCode CorrectionTextureStore::store(WeaverTextureType type, uint64_t key, bool flipVertical, const unsigned char* texture,
+        int width, int height, int channels, int bitsPerPixel, CorrectionTextureCompression compression) const
+    {
+        if (texture == nullptr || width <= 0 || height <= 0 || channels <= 0 || bitsPerPixel <= 0 || bitsPerPixel % 8 != 0)
+            return WeaverTextureUnknownPixelFormat;
+
+        const size_t bytesPerPixel = static_cast<size_t>(bitsPerPixel / 8);
+        const size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * bytesPerPixel;
+
+        std::vector<unsigned char> encoded;
+        const unsigned char* payload = texture;
+        size_t payloadSize = size;
+        if (compression == CorrectionTextureCompression::Delta)
+        {
+            encoded = encodeDelta(texture, size, bytesPerPixel);
+            payload = encoded.data();
+            payloadSize = encoded.size();
+        }
+
+        // The header is padded to a page so the payload of uncompressed files can be used in place
+        const size_t payloadOffset = std::max(minimumPayloadAlignment, MappedFile::getPageSize());
+        std::vector<unsigned char> header(payloadOffset, 0);
+        FileHeader fields;
+        std::memcpy(fields.magic, fileMagic, sizeof(fileMagic));
+        fields.version       = fileVersion;
+        fields.type          = static_cast<uint32_t>(type);
+        fields.key           = key;
+        fields.flipVertical  = flipVertical ? 1 : 0;
+        fields.width         = width;
+        fields.height        = height;
+        fields.channels      = channels;
+        fields.bitsPerPixel  = bitsPerPixel;
+        fields.compression   = static_cast<uint32_t>(compression);
+        fields.payloadOffset = payloadOffset;
+        fields.payloadSize   = payloadSize;
+        fields.decodedSize   = size;
+        fields.checksum      = fnv1a(texture, size);
+        std::memcpy(header.data(), &fields, sizeof(fields));
+
+        if (!writeFileAtomically(getPath(type, key, flipVertical), header.data(), header.size(), payload, payloadSize))
+            return WeaverTextureFailedToLoad;
+        return WeaverSuccess;
+    }
+
+    WeaverErrorCode CorrectionTextureStore::load(WeaverTextureType type, uint64_t key, bool flipVertical, CorrectionTexture& texture) const
+    {
+        MappedFile file;
+        if (!file.open(getPath(type, key, flipVertical)))
+            return WeaverTextureNotFound;
+
+        FileHeader fields;
+        if (file.getSize() < sizeof(fields))
+            return WeaverTextureFailedToLoad;
+        std::memcpy(&fields, file.getData(), sizeof(fields));
+
+        const bool headerValid = std::memcmp(fields.magic, fileMagic, sizeof(fileMagic)) == 0 && fields.version == fileVersion &&
+            fields.type == static_cast<uint32_t>(type) && fields.key == key && fields.flipVertical == (flipVertical ? 1u : 0u) &&
+            fields.width > 0 && fields.height > 0 && fields.channels > 0 && fields.bitsPerPixel > 0 && fields.bitsPerPixel % 8 == 0 &&
+            fields.decodedSize == static_cast<uint64_t>(fields.width) * static_cast<uint64_t>(fields.height) * static_cast<uint64_t>(fields.bitsPerPixel / 8) &&
+            fields.payloadOffset >= sizeof(fields) && fields.payloadOffset <= file.getSize() &&
+            fields.payloadSize <= file.getSize() - fields.payloadOffset;
+        if (!headerValid)
+            return WeaverTextureFailedToLoad;
+
+        std::unique_ptr<CorrectionTexture::Impl> impl(new CorrectionTexture::Impl());
+        const unsigned char* payload = file.getData() + fields.payloadOffset;
+        switch (static_cast<CorrectionTextureCompression>(fields.compression))
+        {
+        case CorrectionTextureCompression::None:
+            if (fields.payloadSize != fields.decodedSize || fnv1a(payload, static_cast<size_t>(fields.payloadSize)) != fields.checksum)
+                return WeaverTextureFailedToLoad;
+            impl->data = payload;
+            break;
+        case CorrectionTextureCompression::Delta:
+            impl->decoded.resize(static_cast<size_t>(fields.decodedSize));
+            if (!decodeDelta(payload, static_cast<size_t>(fields.payloadSize), impl->decoded.data(), impl->decoded.size(), static_cast<size_t>(fields.bitsPerPixel / 8)) ||
+                fnv1a(impl->decoded.data(), impl->decoded.size()) != fields.checksum)
+                return WeaverTextureFailedToLoad;
+            impl->data = impl->decoded.data();
+            file.close();
+            break;
+        default:
+            return WeaverTextureFailedToLoad;
+        }
+
+        impl->file = std::move(file);
+        impl->width = fields.width;
+        impl->height = fields.height;
+        impl->channels = fields.channels;
+        impl->bitsPerPixel = fields.bitsPerPixel;
+        impl->size = static_cast<size_t>(fields.decodedSize);
+        texture.pimpl = std::move(impl);
+        return WeaverSuccess;
+    }
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+    WeaverErrorCode CorrectionTextureStore::loadOrDecode(WeaverTextureType type, uint64_t key, bool flipVertical, CorrectionTexture& texture,
+        CorrectionTextureCompression compression) const
+    {
+        WeaverErrorCode result = load(type, key, flipVertical, texture);
+        if (result == WeaverSuccess)
+            return result;
+
+        unsigned char* decoded = nullptr;
+        int width = 0, height = 0, channels = 0, bitsPerPixel = 0;
+        result = Dimenco::Weaver::LoadTexture(type, &decoded, &width, &height, &channels, &bitsPerPixel, flipVertical);
+        if (result != WeaverSuccess)
+            return result;
+        result = store(type, key, flipVertical, decoded, width, height, channels, bitsPerPixel, compression);
+        Dimenco::Weaver::UnLoadCorrectionTexture(&decoded);
+        if (result != WeaverSuccess)
+            return result;
+        return load(type, key, flipVertical, texture);
+    }
+#endif
+}
@@ -0,0 +1,388 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/weaver/cpuweaver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "utility/workstealingpool.h"
+#include "weaver/lensphase.h"
+#include "weaver/phasekernels.h"
+#include "weaver/phasemap.h"
+#include "weaver/weavepipeline.h"
+
+namespace SR
+{
+    namespace
+    {
+        struct PixelBuffer
+        {
+            uint8_t* data = nullptr;
+            int width = 0;
+            int height = 0;
+            int rowPitch = 0;
+            CPUPixelFormat format = CPUPixelFormat::RGBA8;
+        };
+
+        PixelBuffer describeBuffer(const void* data, int width, int height, int rowPitch, CPUPixelFormat format, int minimumWidth)
+        {
+            if (data == nullptr || width < minimumWidth || height <= 0 || rowPitch < width * getCPUPixelSize(format))
+                throw std::invalid_argument("Invalid CPU weaver buffer description");
+            return { static_cast<uint8_t*>(const_cast<void*>(data)), width, height, rowPitch, format };
+        }
+    }
+
+    class CPUWeaver final : public ICPUWeaver1
+    {
+    public:
+        CPUWeaver(const WeaverLensParameters& lens, const WeaverDisplayGeometry& display)
+            : model(lens, display), displayIdentifier(display.identifier)
+        {
+        }
+
+        // Inherited via IDestroyable
+        void destroy() override
+        {
+            delete this;
+        }
+
+        // Inherited via IWeaverBase1
+        void setWindowHandle(HWND handle) override
+        {
+            window = handle;
+        }
+
+        void weave() override
+        {
+            weave(static_cast<unsigned int>(output.width), static_cast<unsigned int>(output.height), 0, 0);
+        }
+
+        void enableLateLatching(bool enable) override
+        {
+            lateLatching = enable;
+        }
+
+        bool isLateLatchingEnabled() const override
+        {
+            return lateLatching;
+        }
+
+        void setShaderSRGBConversion(bool read, bool write) override
+        {
+            srgbRead = read;
+            srgbWrite = write;
+        }
+
+        void setLatencyInFrames(uint64_t latencyInFrames) override
+        {
+            latencyFrames = latencyInFrames;
+            latencyOverride = false;
+        }
+
+        void setLatency(uint64_t latency) override
+        {
+            latencyMicroseconds = latency;
+            latencyOverride = true;
+        }
+
+        uint64_t getLatency() const override
+        {
+            if (latencyOverride)
+                return latencyMicroseconds;
+            return static_cast<uint64_t>(std::llround(static_cast<double>(latencyFrames) * 1000000.0 / refreshRate));
+        }
+
+        void getPredictedEyePositions(float left[3], float right[3]) override
+        {
+            std::copy(leftEye, leftEye + 3, left);
+            std::copy(rightEye, rightEye + 3, right);
+        }
+
+        // Inherited via ICPUWeaver1
+        void setInputViewBuffer(const void* data, int width, int height, int rowPitch, CPUPixelFormat format) override
+        {
+            input = describeBuffer(data, width, height, rowPitch, format, 2);
+        }
+
+        void setOutputBuffer(void* data, int width, int height, int rowPitch, CPUPixelFormat format) override
+        {
+            output = describeBuffer(data, width, height, rowPitch, format, 1);
+        }
+
+        void setScreenRect(int x, int y) override
+        {
+            screenX = x;
+            screenY = y;
+        }
+
+        void setDisplayLocation(const SR_recti& location) override
+        {
+            std::copy(location.p, location.p + 4, displayLocation);
+        }
+
+        void setEyePositions(const float left[3], const float right[3]) override
+        {
+            std::copy(left, left + 3, leftEye);
+            std::copy(right, right + 3, rightEye);
+        }
+
+        void setRefreshRate(double rate) override
+        {
+            if (rate > 0.0)
+                refreshRate = rate;
+        }
+
+        void setThreadCount(unsigned int count) override
+        {
+            threadCount = count;
+        }
+
+        void setACTMode(WeaverACTMode mode) override
+        {
+            crosstalk.mode = mode;
+        }
+
+        WeaverACTMode getACTMode() const override
+        {
+            return crosstalk.mode;
+        }
+
+        void setCrosstalkStaticFactor(float factor) override
+        {
+            crosstalk.staticFactor = factor;
+            crosstalk = clampCrosstalkParameters(crosstalk);
+        }
+
+        float getCrosstalkStaticFactor() const override
+        {
+            return crosstalk.staticFactor;
+        }
+
+        void setCrosstalkDynamicFactor(float factor) override
+        {
+            crosstalk.dynamicFactor = factor;
+            crosstalk = clampCrosstalkParameters(crosstalk);
+        }
+
+        float getCrosstalkDynamicFactor() const override
+        {
+            return crosstalk.dynamicFactor;
+        }
+
+        void setContrast(float value) override
+        {
+            // Written so NaN ends up as 0
+            contrast = value > 0.0f ? std::min(value, 1.0f) : 0.0f;
+        }
+
+        float getContrast() const override
+        {
+            return contrast;
+        }
+
+        void setBehaviorWhenNotTracking(BehaviorWhenNotTracking value) override
+        {
+            behaviorWhenNotTracking = value;
+        }
+
+        BehaviorWhenNotTracking getBehaviorWhenNotTracking() const override
+        {
+            return behaviorWhenNotTracking;
+        }
+
+        void setTracking(bool value) override
+        {
+            tracking = value;
+        }
+
+        bool canWeave(unsigned int width, unsigned int height) override
+        {
+            return canWeave(width, height, 0, 0);
+        }
+
+        bool canWeave(unsigned int width, unsigned int height, unsigned int xOffset, unsigned int yOffset) override
+        {
+            return input.data != nullptr && output.data != nullptr && width > 0 && height > 0 &&
+                static_cast<uint64_t>(xOffset) + width <= static_cast<uint64_t>(output.width) &&
+                static_cast<uint64_t>(yOffset) + height <= static_cast<uint64_t>(output.height);
+        }
+
+        void weave(unsigned int width, unsigned int height) override
+        {
+            weave(width, height, 0, 0);
+        }
+
+        void weave(unsigned int width, unsigned int height, unsigned int xOffset, unsigned int yOffset) override
+        {
+            if (!canWeave(width, height, xOffset, yOffset))
+                return;
+
+            const Region region = { width, height, xOffset, yOffset };
+            const float eye[3] = {
+                0.5f * (leftEye[0] + rightEye[0]),
+                0.5f * (leftEye[1] + rightEye[1]),
+                0.5f * (leftEye[2] + rightEye[2]),
+            };
+
+            WeaveOptions options;
+            options.inputFormat = input.format;
+            options.outputFormat = output.format;
+            options.srgbRead = srgbRead;
+            options.srgbWrite = srgbWrite;
+            options.crosstalk = crosstalk;
+            options.contrast = contrast;
+            options.behavior = tracking ? BehaviorWhenNotTracking::Default : behaviorWhenNotTracking;
+            const WeavePipeline pipeline = createWeavePipeline(options);
+
+            PhaseMapKey key;
+            key.width = static_cast<int>(width);
+            key.height = static_cast<int>(height);
+            key.panelX = screenX + static_cast<int>(xOffset);
+            key.panelY = screenY + static_cast<int>(yOffset);
+            key.displayIdentifier = displayIdentifier;
+            std::copy(displayLocation, displayLocation + 4, key.displayLocation);
+            PhaseMap& phaseMap = phaseMaps.get(model, key);
+            if (pipeline.usesWeights)
+                phaseMap.update(model, getPhaseKernels(), eye);
+
+            const unsigned int tilesX = (width + tileSize - 1) / tileSize;
+            const unsigned int tilesY = (height + tileSize - 1) / tileSize;
+            WorkStealingPool& workers = getPool();
+            workers.run(tilesX * tilesY, [&](uint32_t tile, unsigned int worker) {
+                const unsigned int column = (tile % tilesX) * tileSize;
+                const unsigned int row = (tile / tilesX) * tileSize;
+                weaveTile(region, pipeline, phaseMap, column, std::min(width, column + tileSize), row, std::min(height, row + tileSize), scratch[worker]);
+            });
+        }
+
+    protected:
+        // Inherited via IQueryInterface
+        void* queryInterface(std::type_index type) override
+        {
+            if (type == typeid(IWeaverBase1))
+                return static_cast<IWeaverBase1*>(this);
+            if (type == typeid(ICPUWeaver1))
+                return static_cast<ICPUWeaver1*>(this);
+            return nullptr;
+        }
+
+    private:
+        struct Region
+        {
+            unsigned int width;
+            unsigned int height;
+            unsigned int xOffset;
+            unsigned int yOffset;
+        };
+
+        // Per worker buffers for one row of a tile, samples are interleaved RGB
+        struct TileScratch
+        {
+            explicit TileScratch(unsigned int size)
+                : weights(3 * size), left(3 * size), right(3 * size), columns(size)
+            {
+            }
+
+            std::vector<float> weights;
+            std::vector<float> left;
+            std::vector<float> right;
+            std::vector<uint32_t> columns;
+        };
+
+        WorkStealingPool& getPool()
+        {
+            const unsigned int threads = threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+            if (!pool || pool->getThreadCount() != threads)
+            {
+                pool.reset(new WorkStealingPool(threads));
+                scratch.assign(threads, TileScratch(tileSize));
+            }
+            return *pool;
+        }
+
+        void weaveTile(const Region& region, const WeavePipeline& pipeline, const PhaseMap& phaseMap, unsigned int columnBegin,
+            unsigned int columnEnd, unsigned int rowBegin, unsigned int rowEnd, TileScratch& tileScratch) const
+        {
+            const PhaseKernels& kernels = getPhaseKernels();
+            const int count = static_cast<int>(columnEnd - columnBegin);
+            const float* columnTerm = phaseMap.getColumnTerm() + columnBegin;
+            float* weights[3] = { tileScratch.weights.data(), tileScratch.weights.data() + count, tileScratch.weights.data() + 2 * count };
+
+            const uint64_t viewWidth = static_cast<uint64_t>(input.width / 2);
+            for (unsigned int column = columnBegin; column < columnEnd; column++)
+                tileScratch.columns[column - columnBegin] = static_cast<uint32_t>((2 * static_cast<uint64_t>(column) + 1) * viewWidth / (2 * static_cast<uint64_t>(region.width)));
+
+            WeaveRow weaveRow;
+            weaveRow.columns = tileScratch.columns.data();
+            std::copy(weights, weights + 3, weaveRow.weights);
+            weaveRow.count = count;
+            weaveRow.leftSamples = tileScratch.left.data();
+            weaveRow.rightSamples = tileScratch.right.data();
+
+            const uint64_t inputPixelSize = static_cast<uint64_t>(getCPUPixelSize(input.format));
+            const uint64_t outputPixelSize = static_cast<uint64_t>(getCPUPixelSize(output.format));
+            for (unsigned int row = rowBegin; row < rowEnd; row++)
+            {
+                const uint64_t sourceY = (2 * static_cast<uint64_t>(row) + 1) * static_cast<uint64_t>(input.height) / (2 * static_cast<uint64_t>(region.height));
+                weaveRow.left = input.data + sourceY * static_cast<uint64_t>(input.rowPitch);
+                weaveRow.right = weaveRow.left + viewWidth * inputPixelSize;
+                weaveRow.output = output.data + static_cast<uint64_t>(region.yOffset + row) * static_cast<uint64_t>(output.rowPitch) +
+                    (static_cast<uint64_t>(region.xOffset) + columnBegin) * outputPixelSize;
+
+                if (pipeline.usesWeights)
+                    for (int c = 0; c < 3; c++)
+                        kernels.leftWeightRow(model, phaseMap.getRowTerm(c)[row], columnTerm, count, weights[c]);
+                pipeline.weaveRow(pipeline, weaveRow);
+            }
+        }
+
+        // A 64x64 tile touches 32 KiB of source views and 16 KiB of output at 1:1 scale, which stays in L2
+        static constexpr unsigned int tileSize = 64;
+
+        LensPhaseModel model;
+        uint64_t displayIdentifier;
+        int64_t displayLocation[4] = {};
+        PhaseMapCache phaseMaps;
+
+        PixelBuffer input;
+        PixelBuffer output;
+        int screenX = 0;
+        int screenY = 0;
+
+        HWND window = nullptr;
+        bool lateLatching = false;
+        bool srgbRead = false;
+        bool srgbWrite = false;
+        CrosstalkParameters crosstalk;
+        float contrast = 1.0f;
+        BehaviorWhenNotTracking behaviorWhenNotTracking = BehaviorWhenNotTracking::Default;
+        bool tracking = true;
+
+        uint64_t latencyFrames = 1;
+        uint64_t latencyMicroseconds = 0;
+        bool latencyOverride = false;
+        double refreshRate = 60.0;
+
+        // Default viewing position of the SR system
+        float leftEye[3] = { -31.5f, 100.0f, 600.0f };
+        float rightEye[3] = { 31.5f, 100.0f, 600.0f };
+
+        unsigned int threadCount = 0;
+        std::unique_ptr<WorkStealingPool> pool;
+        std::vector<TileScratch> scratch;
+    };
+
+    WeaverErrorCode CreateCPUWeaver(const WeaverLensParameters& lens, const WeaverDisplayGeometry& display, ICPUWeaver1** weaver)
+    {
+        if (!lens.isValid() || !display.isValid())
+            throw std::invalid_argument("Invalid lens or display parameters for the CPU weaver");
+        *weaver = new CPUWeaver(lens, display);
+        return WeaverSuccess;
+    }
+}
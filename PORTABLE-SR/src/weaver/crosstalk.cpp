@@ -0,0 +1,93 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/weaver/crosstalk.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "weaver/crosstalkkernels.h"
+#include "weaver/pixelrow.h"
+
+namespace SR
+{
+    namespace
+    {
+        float clampFactor(float factor)
+        {
+            // Written so NaN ends up as 0
+            return factor > 0.0f ? std::min(factor, CrosstalkParameters::maximumFactor) : 0.0f;
+        }
+    }
+
+    CrosstalkParameters clampCrosstalkParameters(const CrosstalkParameters& parameters)
+    {
+        CrosstalkParameters clamped = parameters;
+        clamped.staticFactor = clampFactor(parameters.staticFactor);
+        clamped.dynamicFactor = clampFactor(parameters.dynamicFactor);
+        return clamped;
+    }
+
+    void compensateCrosstalkRow(const CrosstalkKernels& kernels, const CrosstalkParameters& clamped, int count, float* left, float* right)
+    {
+        switch (clamped.mode)
+        {
+        case WeaverACTMode::Static:
+            kernels.staticRow(clamped.staticFactor, 1.0f / (1.0f - clamped.staticFactor), count, left, right);
+            break;
+        case WeaverACTMode::Dynamic:
+            kernels.dynamicRow(clamped.staticFactor, clamped.dynamicFactor, count, left, right);
+            break;
+        case WeaverACTMode::Off:
+            break;
+        }
+    }
+
+    void compensateCrosstalk(const CrosstalkParameters& parameters, const void* input, int width, int height, int inputRowPitch,
+        void* output, int outputRowPitch, CPUPixelFormat format, bool srgb)
+    {
+        const int pixelSize = getCPUPixelSize(format);
+        if (input == nullptr || output == nullptr || width < 2 || height <= 0 || inputRowPitch < width * pixelSize || outputRowPitch < width * pixelSize)
+            throw std::invalid_argument("Invalid crosstalk buffer description");
+
+        const CrosstalkParameters clamped = clampCrosstalkParameters(parameters);
+        const CrosstalkKernels& kernels = getCrosstalkKernels();
+        const int viewWidth = width / 2;
+        const size_t viewBytes = static_cast<size_t>(viewWidth) * static_cast<size_t>(pixelSize);
+        std::vector<float> left(3 * static_cast<size_t>(viewWidth));
+        std::vector<float> right(3 * static_cast<size_t>(viewWidth));
+
+        withPixelCodec(format, srgb, getSRGBTables(), [&](auto codec) {
+            constexpr size_t pixelSize = decltype(codec)::pixelSize;
+            for (int y = 0; y < height; y++)
+            {
+                const uint8_t* inputRow = static_cast<const uint8_t*>(input) + static_cast<size_t>(y) * static_cast<size_t>(inputRowPitch);
+                uint8_t* outputRow = static_cast<uint8_t*>(output) + static_cast<size_t>(y) * static_cast<size_t>(outputRowPitch);
+                for (int x = 0; x < viewWidth; x++)
+                {
+                    codec.read(inputRow + x * pixelSize, left.data() + 3 * x);
+                    codec.read(inputRow + viewBytes + x * pixelSize, right.data() + 3 * x);
+                }
+                compensateCrosstalkRow(kernels, clamped, 3 * viewWidth, left.data(), right.data());
+                for (int x = 0; x < viewWidth; x++)
+                {
+                    // Alpha is read before the pixel is written, so output may equal input
+                    const size_t offset = x * pixelSize;
+                    uint8_t alpha[2][pixelSize];
+                    std::copy(inputRow + offset, inputRow + offset + pixelSize, alpha[0]);
+                    std::copy(inputRow + viewBytes + offset, inputRow + viewBytes + offset + pixelSize, alpha[1]);
+                    codec.write(left.data() + 3 * x, outputRow + offset);
+                    codec.write(right.data() + 3 * x, outputRow + viewBytes + offset);
+                    codec.copyAlpha(alpha[0], outputRow + offset);
+                    codec.copyAlpha(alpha[1], outputRow + viewBytes + offset);
+                }
+
+                // An odd last column belongs to neither view
+                if (width % 2 != 0 && outputRow != inputRow)
+                    std::copy(inputRow + 2 * viewBytes, inputRow + 2 * viewBytes + pixelSize, outputRow + 2 * viewBytes);
+            }
+        });
+    }
+}
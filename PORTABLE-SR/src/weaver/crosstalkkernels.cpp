@@ -0,0 +1,58 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "weaver/crosstalkkernels.h"
+#include "weaver/crosstalkkernelsimpl.h"
+
+namespace SR
+{
+    const CrosstalkKernels& getScalarCrosstalkKernels()
+    {
+        return CrosstalkKernelTable<SIMD::Scalar>::get(SIMDLevel::Scalar);
+    }
+
+    const CrosstalkKernels* getSSE2CrosstalkKernels()
+    {
+#if defined(__SSE2__) || defined(_M_X64)
+        return &CrosstalkKernelTable<SIMD::SSE2>::get(SIMDLevel::SSE2);
+#else
+        return nullptr;
+#endif
+    }
+
+    const CrosstalkKernels* getNEONCrosstalkKernels()
+    {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return &CrosstalkKernelTable<SIMD::NEON>::get(SIMDLevel::NEON);
+#else
+        return nullptr;
+#endif
+    }
+
+#if !defined(SRPORTABLE_SIMD_X86)
+    const CrosstalkKernels* getAVX2CrosstalkKernels()
+    {
+        return nullptr;
+    }
+
+    const CrosstalkKernels* getAVX512CrosstalkKernels()
+    {
+        return nullptr;
+    }
+#endif
+
+    const CrosstalkKernels& getCrosstalkKernels()
+    {
+        const CrosstalkKernels* kernels = nullptr;
+        switch (getSIMDLevel())
+        {
+        case SIMDLevel::SSE2:   kernels = getSSE2CrosstalkKernels(); break;
+        case SIMDLevel::AVX2:   kernels = getAVX2CrosstalkKernels(); break;
+        case SIMDLevel::AVX512: kernels = getAVX512CrosstalkKernels(); break;
+        case SIMDLevel::NEON:   kernels = getNEONCrosstalkKernels(); break;
+        case SIMDLevel::Scalar: break;
+        }
+        return kernels != nullptr ? *kernels : getScalarCrosstalkKernels();
+    }
+}
@@ -0,0 +1,55 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include "sr/utility/simd.h"
+#include "sr/weaver/crosstalk.h"
+
+namespace SR
+{
+    /*!
+     * \brief Anti-crosstalk row kernels behind the CPU weaver and compensateCrosstalk(), instantiated once per instruction set.
+     *
+     * Both kernels work element by element on \p count floats, so interleaved RGB samples can be passed directly.
+     * The factors must already be clamped, see clampCrosstalkParameters().
+     */
+    struct CrosstalkKernels
+    {
+        SIMDLevel level;
+
+        /*!
+         * \brief left[i], right[i] = max((left[i] - k * right[i]) * scale, 0), max((right[i] - k * left[i]) * scale, 0)
+         *
+         * With k = staticFactor and scale = 1 / (1 - k), computed once by the caller.
+         */
+        void (*staticRow)(float staticFactor, float scale, int count, float* left, float* right);
+
+        /*!
+         * \brief As staticRow with k = min(staticFactor + dynamicFactor * |left[i] - right[i]|, maximumFactor) per element
+         */
+        void (*dynamicRow)(float staticFactor, float dynamicFactor, int count, float* left, float* right);
+    };
+
+    /*!
+     * \brief Returns \p parameters with both factors clamped to [0, CrosstalkParameters::maximumFactor], NaN becomes 0
+     */
+    CrosstalkParameters clampCrosstalkParameters(const CrosstalkParameters& parameters);
+
+    /*!
+     * \brief Compensates \p count interleaved samples of both views in place, nothing happens for WeaverACTMode::Off
+     */
+    void compensateCrosstalkRow(const CrosstalkKernels& kernels, const CrosstalkParameters& clamped, int count, float* left, float* right);
+
+    /*!
+     * \brief Returns the kernels of the instruction set selected through setSIMDLevel()
+     */
+    const CrosstalkKernels& getCrosstalkKernels();
+
+    const CrosstalkKernels& getScalarCrosstalkKernels();
+    const CrosstalkKernels* getSSE2CrosstalkKernels();
+    const CrosstalkKernels* getAVX2CrosstalkKernels();
+    const CrosstalkKernels* getAVX512CrosstalkKernels();
+    const CrosstalkKernels* getNEONCrosstalkKernels();
+}
@@ -0,0 +1,15 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+// Compiled with AVX2 enabled, only called after runtime detection
+#include "weaver/crosstalkkernels.h"
+#include "weaver/crosstalkkernelsimpl.h"
+
+namespace SR
+{
+    const CrosstalkKernels* getAVX2CrosstalkKernels()
+    {
+        return &CrosstalkKernelTable<SIMD::AVX2>::get(SIMDLevel::AVX2);
+    }
+}
@@ -0,0 +1,15 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+// Compiled with AVX-512F enabled, only called after runtime detection
+#include "weaver/crosstalkkernels.h"
+#include "weaver/crosstalkkernelsimpl.h"
+
+namespace SR
+{
+    const CrosstalkKernels* getAVX512CrosstalkKernels()
+    {
+        return &CrosstalkKernelTable<SIMD::AVX512>::get(SIMDLevel::AVX512);
+    }
+}
@@ -0,0 +1,85 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include "utility/simdvector.h"
+#include "weaver/crosstalkkernels.h"
+
+namespace SR
+{
+namespace
+{
+    /*!
+     * \brief Kernel bodies shared by all instruction sets, see PhaseKernelBodies.
+     */
+    template <class V>
+    struct CrosstalkKernelBodies
+    {
+        static int staticRow(float staticFactor, float scale, int count, float* left, float* right)
+        {
+            const typename V::Float k = V::set(staticFactor);
+            const typename V::Float s = V::set(scale);
+            const typename V::Float zero = V::set(0.0f);
+            int i = 0;
+            for (; i + V::width <= count; i += V::width)
+            {
+                const typename V::Float l = V::load(left + i);
+                const typename V::Float r = V::load(right + i);
+                V::store(left + i, V::max(V::mul(V::sub(l, V::mul(k, r)), s), zero));
+                V::store(right + i, V::max(V::mul(V::sub(r, V::mul(k, l)), s), zero));
+            }
+            return i;
+        }
+
+        static int dynamicRow(float staticFactor, float dynamicFactor, int count, float* left, float* right)
+        {
+            const typename V::Float base = V::set(staticFactor);
+            const typename V::Float gain = V::set(dynamicFactor);
+            const typename V::Float limit = V::set(CrosstalkParameters::maximumFactor);
+            const typename V::Float zero = V::set(0.0f);
+            const typename V::Float one = V::set(1.0f);
+            int i = 0;
+            for (; i + V::width <= count; i += V::width)
+            {
+                const typename V::Float l = V::load(left + i);
+                const typename V::Float r = V::load(right + i);
+                const typename V::Float k = V::min(V::add(base, V::mul(gain, V::abs(V::sub(l, r)))), limit);
+                const typename V::Float d = V::sub(one, k);
+                V::store(left + i, V::max(V::div(V::sub(l, V::mul(k, r)), d), zero));
+                V::store(right + i, V::max(V::div(V::sub(r, V::mul(k, l)), d), zero));
+            }
+            return i;
+        }
+    };
+
+    /*!
+     * \brief Builds the kernel table of instruction set V
+     */
+    template <class V>
+    struct CrosstalkKernelTable
+    {
+        using Body = CrosstalkKernelBodies<V>;
+        using Tail = CrosstalkKernelBodies<SIMD::Scalar>;
+
+        static void staticRow(float staticFactor, float scale, int count, float* left, float* right)
+        {
+            const int done = Body::staticRow(staticFactor, scale, count, left, right);
+            Tail::staticRow(staticFactor, scale, count - done, left + done, right + done);
+        }
+
+        static void dynamicRow(float staticFactor, float dynamicFactor, int count, float* left, float* right)
+        {
+            const int done = Body::dynamicRow(staticFactor, dynamicFactor, count, left, right);
+            Tail::dynamicRow(staticFactor, dynamicFactor, count - done, left + done, right + done);
+        }
+
+        static const CrosstalkKernels& get(SIMDLevel level)
+        {
+            static const CrosstalkKernels kernels = { level, &staticRow, &dynamicRow };
+            return kernels;
+        }
+    };
+}
+}
@@ -0,0 +1,143 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/weaver/latencysimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace SR
+{
+    namespace
+    {
+        constexpr double interpupillaryDistance = 63.0;
+
+        uint64_t toMicroseconds(double time)
+        {
+            return static_cast<uint64_t>(std::llround(time * 1.0e6));
+        }
+
+        // Tracker samples of the whole run, noise is drawn once per sample so runs with and without late latching see the same samples
+        class SimulatedTracker
+        {
+        public:
+            SimulatedTracker(const LatencySimulationSettings& settings, const EyeTrajectory& trajectory)
+                : rate(settings.trackerRate), latency(settings.trackerLatency)
+            {
+                const size_t count = static_cast<size_t>(std::ceil(trajectory.getDuration() * rate)) + 1;
+                std::mt19937 random(settings.seed);
+                std::normal_distribution<float> noise(0.0f, settings.trackerNoise);
+                samples.resize(count);
+                for (size_t i = 0; i < count; i++)
+                {
+                    trajectory.evaluate(getCaptureTime(static_cast<int64_t>(i)), samples[i].position);
+                    if (settings.trackerNoise > 0.0f)
+                        for (float& value : samples[i].position)
+                            value += noise(random);
+                }
+            }
+
+            double getCaptureTime(int64_t index) const
+            {
+                return static_cast<double>(index) / rate;
+            }
+
+            //! Index of the newest sample available at time, -1 if there is none
+            int64_t getNewest(double time) const
+            {
+                const double newest = std::floor((time - latency) * rate);
+                if (newest < 0.0)
+                    return -1;
+                return std::min(static_cast<int64_t>(newest), static_cast<int64_t>(samples.size()) - 1);
+            }
+
+            //! Eye pair of a sample, the eyes are interpupillaryDistance apart around the tracked center
+            SR_eyePair getEyePair(int64_t index) const
+            {
+                SR_eyePair pair = {};
+                pair.frameId = static_cast<uint64_t>(index);
+                pair.time = toMicroseconds(getCaptureTime(index));
+                for (int i = 0; i < 3; i++)
+                {
+                    pair.left.p[i] = samples[index].position[i];
+                    pair.right.p[i] = samples[index].position[i];
+                }
+                pair.left.x -= 0.5 * interpupillaryDistance;
+                pair.right.x += 0.5 * interpupillaryDistance;
+                return pair;
+            }
+
+        private:
+            struct Sample
+            {
+                float position[3];
+            };
+
+            double rate;
+            double latency;
+            std::vector<Sample> samples;
+        };
+    }
+
+    LatencySimulationResult simulateLatency(const LatencySimulationSettings& settings, const EyeTrajectory& trajectory, bool lateLatching)
+    {
+        if (!(settings.refreshRate > 0.0) || !(settings.trackerRate > 0.0) || settings.trackerLatency < 0.0 ||
+            static_cast<double>(settings.pipelineFrames) < settings.lateLatchLead)
+            throw std::invalid_argument("Invalid latency simulation settings");
+
+        const SimulatedTracker tracker(settings, trajectory);
+        const std::unique_ptr<EyePredictor> predictor = createEyePredictor(settings.predictor);
+        const double frameTime = 1.0 / settings.refreshRate;
+        const double duration = trajectory.getDuration();
+
+        LatencySimulationResult result;
+        std::vector<double> errors;
+        double horizon = 0.0;
+        int64_t accepted = -1;
+        for (uint64_t frame = 0;; frame++)
+        {
+            const double vsync = static_cast<double>(frame) * frameTime;
+            const double weaveTime = vsync + settings.renderOffset * frameTime;
+            const double photonTime = weaveTime + static_cast<double>(settings.pipelineFrames) * frameTime;
+            if (photonTime > duration)
+                break;
+
+            const double latchTime = lateLatching ? photonTime - settings.lateLatchLead * frameTime : weaveTime;
+            const double predictedTime = weaveTime + static_cast<double>(settings.latencyInFrames) * frameTime;
+            // Both modes start at the first frame whose weave already has two samples, so they cover the same frames
+            if (tracker.getNewest(weaveTime) < 1)
+                continue;
+            const int64_t newest = tracker.getNewest(latchTime);
+            while (accepted < newest)
+                predictor->accept(tracker.getEyePair(++accepted));
+
+            SR_eyePair predicted;
+            float actual[3];
+            predictor->predict(toMicroseconds(predictedTime), predicted);
+            trajectory.evaluate(photonTime, actual);
+            const double dx = 0.5 * (predicted.left.x + predicted.right.x) - actual[0];
+            const double dy = 0.5 * (predicted.left.y + predicted.right.y) - actual[1];
+            const double dz = 0.5 * (predicted.left.z + predicted.right.z) - actual[2];
+            errors.push_back(std::sqrt(dx * dx + dy * dy + dz * dz));
+            horizon += photonTime - tracker.getCaptureTime(newest);
+        }
+
+        result.frames = errors.size();
+        if (errors.empty())
+            return result;
+
+        double sumOfSquares = 0.0;
+        for (double error : errors)
+            sumOfSquares += error * error;
+        result.rmsError = std::sqrt(sumOfSquares / static_cast<double>(errors.size()));
+        result.meanHorizon = horizon / static_cast<double>(errors.size());
+        std::sort(errors.begin(), errors.end());
+        result.maximumError = errors.back();
+        result.percentile95Error = errors[std::min(errors.size() - 1, static_cast<size_t>(0.95 * static_cast<double>(errors.size())))];
+        return result;
+    }
+}
@@ -0,0 +1,50 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/weaver/lensparameters.h"
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+#include "sr/weaver/Weaver.h"
+#include "sr/world/display/display.h"
+#endif
+
+namespace SR
+{
+    bool WeaverLensParameters::isValid() const
+    {
+        return px > 0.0f && n >= 1.0f && doN > 0.0f && filterWidth > 0.0f && filterSlope > 0.0f;
+    }
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+    WeaverLensParameters WeaverLensParameters::fromDimencoWeaver()
+    {
+        WeaverLensParameters parameters;
+        parameters.slant       = Dimenco::Weaver::GetSlant();
+        parameters.px          = Dimenco::Weaver::GetPx();
+        parameters.n           = Dimenco::Weaver::GetN();
+        parameters.doN         = Dimenco::Weaver::GetDoN();
+        parameters.pattern     = Dimenco::Weaver::GetPattern();
+        parameters.filterWidth = Dimenco::Weaver::GetFilterWidth();
+        parameters.filterSlope = Dimenco::Weaver::GetFilterSlope();
+        return parameters;
+    }
+#endif
+
+    bool WeaverDisplayGeometry::isValid() const
+    {
+        return resolutionWidth > 0 && resolutionHeight > 0 && dotPitch > 0.0f;
+    }
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+    WeaverDisplayGeometry WeaverDisplayGeometry::fromDisplay(const IDisplay& display)
+    {
+        WeaverDisplayGeometry geometry;
+        geometry.identifier       = display.identifier();
+        geometry.resolutionWidth  = display.getResolutionWidth();
+        geometry.resolutionHeight = display.getResolutionHeight();
+        geometry.dotPitch         = display.getDotPitch();
+        return geometry;
+    }
+#endif
+}
@@ -0,0 +1,116 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include "sr/weaver/lensparameters.h"
+
+namespace SR
+{
+    /*!
+     * \brief Precomputed constants of the lens phase model shared by all CPU weaving paths.
+     *
+     * The phase of a sub-pixel is expressed in lens periods. It is split into a row term and a column term so that every
+     * weaving path evaluates exactly the same floating point operations in the same order:
+     *
+     *     phase = (rowPhase(c, y) - rowShift(y)) + (x / px - columnShift(x))
+     *
+     * rowPhase and x / px only depend on the panel, columnShift and rowShift describe where the ray from the viewer
+     * through the lens lands on the pixel plane. The ray is refracted by the lens stack using Snell's law per axis.
+     * PhaseMap caches the panel terms and only re-evaluates the shifts when the viewer moves.
+     * A phase with a fractional part around 0.25 is seen by the left eye, around 0.75 by the right eye.
+     */
+    struct LensPhaseModel
+    {
+        float invPx;             //!< 1 / px
+        float slantInvPx;        //!< slant / px
+        float subpixelPhase[3];  //!< Phase of the red, green and blue sub-pixel centers, including the pattern offset
+        float gap;               //!< Physical lens gap D in mm
+        float invN;              //!< 1 / N
+        float dotPitch;          //!< Pixel size in mm
+        float centerX;           //!< Horizontal center of the panel in pixels
+        float centerY;           //!< Vertical center of the panel in pixels
+        float columnShiftScale;  //!< Converts a horizontal ray offset in mm into lens periods
+        float rowShiftScale;     //!< Converts a vertical ray offset in mm into lens periods
+        float filterGain;        //!< filterSlope / filterWidth
+
+        LensPhaseModel(const WeaverLensParameters& lens, const WeaverDisplayGeometry& display)
+        {
+            invPx      = 1.0f / lens.px;
+            slantInvPx = lens.slant / lens.px;
+            for (int c = 0; c < 3; c++)
+                subpixelPhase[c] = (static_cast<float>(c) + 0.5f) / 3.0f * invPx + lens.pattern;
+            gap              = lens.doN * lens.n;
+            invN             = 1.0f / lens.n;
+            dotPitch         = display.dotPitch * 10.0f;
+            centerX          = 0.5f * static_cast<float>(display.resolutionWidth);
+            centerY          = 0.5f * static_cast<float>(display.resolutionHeight);
+            columnShiftScale = invPx / dotPitch;
+            // Display y points up while pixel rows go down
+            rowShiftScale    = -slantInvPx / dotPitch;
+            filterGain       = lens.filterSlope / lens.filterWidth;
+        }
+
+        /*!
+         * \brief Lateral offset in mm on the pixel plane of a ray that leaves the lens at distance d from the eye.
+         */
+        float refractedOffset(float d, float eyeZ) const
+        {
+            const float sinAir   = d / std::sqrt(d * d + eyeZ * eyeZ);
+            const float sinGlass = sinAir * invN;
+            return gap * sinGlass / std::sqrt(1.0f - sinGlass * sinGlass);
+        }
+
+        /*!
+         * \brief Horizontal position in mm of the center of a pixel column, relative to the display center.
+         */
+        float columnPosition(int screenX) const
+        {
+            return (static_cast<float>(screenX) + 0.5f - centerX) * dotPitch;
+        }
+
+        /*!
+         * \brief Vertical position in mm of the center of a pixel row, relative to the display center, pointing up.
+         */
+        float rowPosition(int screenY) const
+        {
+            return (centerY - static_cast<float>(screenY) - 0.5f) * dotPitch;
+        }
+
+        float columnShift(int screenX, float eyeX, float eyeZ) const
+        {
+            return refractedOffset(columnPosition(screenX) - eyeX, eyeZ) * columnShiftScale;
+        }
+
+        float rowShift(int screenY, float eyeY, float eyeZ) const
+        {
+            return refractedOffset(rowPosition(screenY) - eyeY, eyeZ) * rowShiftScale;
+        }
+
+        float rowPhase(int c, int screenY) const
+        {
+            return subpixelPhase[c] + static_cast<float>(screenY) * slantInvPx;
+        }
+
+        float columnPhase(int screenX) const
+        {
+            return static_cast<float>(screenX) * invPx;
+        }
+
+        /*!
+         * \brief Weight of the left view for a sub-pixel phase, the right view receives the remainder.
+         */
+        float leftWeight(float phase) const
+        {
+            const float shifted  = phase + 0.25f;
+            const float distance = std::fabs(shifted - std::floor(shifted) - 0.5f);
+            const float weight   = 0.5f + (0.25f - distance) * filterGain;
+            // Same clamping convention as the vector kernels
+            const float clamped  = weight > 0.0f ? weight : 0.0f;
+            return clamped < 1.0f ? clamped : 1.0f;
+        }
+    };
+}
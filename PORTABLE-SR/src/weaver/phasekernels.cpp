@@ -0,0 +1,58 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "weaver/phasekernels.h"
+#include "weaver/phasekernelsimpl.h"
+
+namespace SR
+{
+    const PhaseKernels& getScalarPhaseKernels()
+    {
+        return PhaseKernelTable<SIMD::Scalar>::get(SIMDLevel::Scalar);
+    }
+
+    const PhaseKernels* getSSE2PhaseKernels()
+    {
+#if defined(__SSE2__) || defined(_M_X64)
+        return &PhaseKernelTable<SIMD::SSE2>::get(SIMDLevel::SSE2);
+#else
+        return nullptr;
+#endif
+    }
+
+    const PhaseKernels* getNEONPhaseKernels()
+    {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return &PhaseKernelTable<SIMD::NEON>::get(SIMDLevel::NEON);
+#else
+        return nullptr;
+#endif
+    }
+
+#if !defined(SRPORTABLE_SIMD_X86)
+    const PhaseKernels* getAVX2PhaseKernels()
+    {
+        return nullptr;
+    }
+
+    const PhaseKernels* getAVX512PhaseKernels()
+    {
+        return nullptr;
+    }
+#endif
+
+    const PhaseKernels& getPhaseKernels()
+    {
+        const PhaseKernels* kernels = nullptr;
+        switch (getSIMDLevel())
+        {
+        case SIMDLevel::SSE2:   kernels = getSSE2PhaseKernels(); break;
+        case SIMDLevel::AVX2:   kernels = getAVX2PhaseKernels(); break;
+        case SIMDLevel::AVX512: kernels = getAVX512PhaseKernels(); break;
+        case SIMDLevel::NEON:   kernels = getNEONPhaseKernels(); break;
+        case SIMDLevel::Scalar: break;
+        }
+        return kernels != nullptr ? *kernels : getScalarPhaseKernels();
+    }
+}
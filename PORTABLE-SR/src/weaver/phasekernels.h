@@ -0,0 +1,48 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include "sr/utility/simd.h"
+#include "weaver/lensphase.h"
+
+namespace SR
+{
+    /*!
+     * \brief Row kernels behind the CPU weaver and fillAttributeRow(), instantiated once per instruction set.
+     */
+    struct PhaseKernels
+    {
+        SIMDLevel level;
+
+        /*!
+         * \brief out[i] = rowOffset + scaleX * (x + i)
+         */
+        void (*affineRow)(float rowOffset, float scaleX, int x, int count, float* out);
+
+        /*!
+         * \brief out[i] = phase[i] - refractedOffset(positionMm[i] - eye, eyeZ) * shiftScale, see LensPhaseModel
+         *
+         * Evaluates the eye dependent column terms with shiftScale = columnShiftScale and the row terms with rowShiftScale.
+         */
+        void (*shiftedPhaseRow)(const LensPhaseModel& model, const float* phase, const float* positionMm, float eye, float eyeZ,
+            float shiftScale, int count, float* out);
+
+        /*!
+         * \brief out[i] = leftWeight(rowTerm + columnTerm[i]), see LensPhaseModel
+         */
+        void (*leftWeightRow)(const LensPhaseModel& model, float rowTerm, const float* columnTerm, int count, float* out);
+    };
+
+    /*!
+     * \brief Returns the kernels of the instruction set selected through setSIMDLevel()
+     */
+    const PhaseKernels& getPhaseKernels();
+
+    const PhaseKernels& getScalarPhaseKernels();
+    const PhaseKernels* getSSE2PhaseKernels();
+    const PhaseKernels* getAVX2PhaseKernels();
+    const PhaseKernels* getAVX512PhaseKernels();
+    const PhaseKernels* getNEONPhaseKernels();
+}
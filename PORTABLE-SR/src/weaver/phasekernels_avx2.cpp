@@ -0,0 +1,15 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+// Compiled with AVX2 enabled, only called after runtime detection
+#include "weaver/phasekernels.h"
+#include "weaver/phasekernelsimpl.h"
+
+namespace SR
+{
+    const PhaseKernels* getAVX2PhaseKernels()
+    {
+        return &PhaseKernelTable<SIMD::AVX2>::get(SIMDLevel::AVX2);
+    }
+}
@@ -0,0 +1,15 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+// Compiled with AVX-512F enabled, only called after runtime detection
+#include "weaver/phasekernels.h"
+#include "weaver/phasekernelsimpl.h"
+
+namespace SR
+{
+    const PhaseKernels* getAVX512PhaseKernels()
+    {
+        return &PhaseKernelTable<SIMD::AVX512>::get(SIMDLevel::AVX512);
+    }
+}
@@ -0,0 +1,109 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include "utility/simdvector.h"
+#include "weaver/phasekernels.h"
+
+namespace SR
+{
+namespace
+{
+    /*!
+     * \brief Kernel bodies shared by all instruction sets.
+     *
+     * Each kernel processes full vectors of V and finishes the row with SIMD::Scalar, so the tail runs
+     * the same sequence of operations as the vector body.
+     */
+    template <class V>
+    struct PhaseKernelBodies
+    {
+        static int affineRow(float rowOffset, float scaleX, int x, int count, float* out)
+        {
+            const typename V::Float offset = V::set(rowOffset);
+            const typename V::Float scale = V::set(scaleX);
+            int i = 0;
+            for (; i + V::width <= count; i += V::width)
+                V::store(out + i, V::add(offset, V::mul(scale, V::index(x + i))));
+            return i;
+        }
+
+        static int shiftedPhaseRow(const LensPhaseModel& model, const float* phase, const float* positionMm, float eye, float eyeZ,
+            float shiftScale, int count, float* out)
+        {
+            const typename V::Float one = V::set(1.0f);
+            const typename V::Float eyeV = V::set(eye);
+            const typename V::Float eyeZ2 = V::set(eyeZ * eyeZ);
+            const typename V::Float invN = V::set(model.invN);
+            const typename V::Float gap = V::set(model.gap);
+            const typename V::Float scale = V::set(shiftScale);
+            int i = 0;
+            for (; i + V::width <= count; i += V::width)
+            {
+                const typename V::Float d = V::sub(V::load(positionMm + i), eyeV);
+                const typename V::Float sinAir = V::div(d, V::sqrt(V::add(V::mul(d, d), eyeZ2)));
+                const typename V::Float sinGlass = V::mul(sinAir, invN);
+                const typename V::Float offset = V::div(V::mul(gap, sinGlass), V::sqrt(V::sub(one, V::mul(sinGlass, sinGlass))));
+                V::store(out + i, V::sub(V::load(phase + i), V::mul(offset, scale)));
+            }
+            return i;
+        }
+
+        static int leftWeightRow(const LensPhaseModel& model, float rowTerm, const float* columnTerm, int count, float* out)
+        {
+            const typename V::Float row = V::set(rowTerm);
+            const typename V::Float quarter = V::set(0.25f);
+            const typename V::Float half = V::set(0.5f);
+            const typename V::Float zero = V::set(0.0f);
+            const typename V::Float one = V::set(1.0f);
+            const typename V::Float gain = V::set(model.filterGain);
+            int i = 0;
+            for (; i + V::width <= count; i += V::width)
+            {
+                const typename V::Float shifted = V::add(V::add(row, V::load(columnTerm + i)), quarter);
+                const typename V::Float distance = V::abs(V::sub(V::sub(shifted, V::floor(shifted)), half));
+                const typename V::Float weight = V::add(half, V::mul(V::sub(quarter, distance), gain));
+                V::store(out + i, V::min(V::max(weight, zero), one));
+            }
+            return i;
+        }
+    };
+
+    /*!
+     * \brief Builds the kernel table of instruction set V
+     */
+    template <class V>
+    struct PhaseKernelTable
+    {
+        using Body = PhaseKernelBodies<V>;
+        using Tail = PhaseKernelBodies<SIMD::Scalar>;
+
+        static void affineRow(float rowOffset, float scaleX, int x, int count, float* out)
+        {
+            const int done = Body::affineRow(rowOffset, scaleX, x, count, out);
+            Tail::affineRow(rowOffset, scaleX, x + done, count - done, out + done);
+        }
+
+        static void shiftedPhaseRow(const LensPhaseModel& model, const float* phase, const float* positionMm, float eye, float eyeZ,
+            float shiftScale, int count, float* out)
+        {
+            const int done = Body::shiftedPhaseRow(model, phase, positionMm, eye, eyeZ, shiftScale, count, out);
+            Tail::shiftedPhaseRow(model, phase + done, positionMm + done, eye, eyeZ, shiftScale, count - done, out + done);
+        }
+
+        static void leftWeightRow(const LensPhaseModel& model, float rowTerm, const float* columnTerm, int count, float* out)
+        {
+            const int done = Body::leftWeightRow(model, rowTerm, columnTerm, count, out);
+            Tail::leftWeightRow(model, rowTerm, columnTerm + done, count - done, out + done);
+        }
+
+        static const PhaseKernels& get(SIMDLevel level)
+        {
+            static const PhaseKernels kernels = { level, &affineRow, &shiftedPhaseRow, &leftWeightRow };
+            return kernels;
+        }
+    };
+}
+}
@@ -0,0 +1,91 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "weaver/phasemap.h"
+
+#include <algorithm>
+
+namespace SR
+{
+    bool PhaseMapKey::operator==(const PhaseMapKey& other) const
+    {
+        return width == other.width && height == other.height && panelX == other.panelX && panelY == other.panelY &&
+            displayIdentifier == other.displayIdentifier && std::equal(displayLocation, displayLocation + 4, other.displayLocation);
+    }
+
+    void PhaseMap::build(const LensPhaseModel& model, const PhaseMapKey& mapKey)
+    {
+        key = mapKey;
+        eyeValid = false;
+
+        columnPhase.resize(key.width);
+        columnPosition.resize(key.width);
+        columnTerm.resize(key.width);
+        for (int x = 0; x < key.width; x++)
+        {
+            columnPhase[x] = model.columnPhase(key.panelX + x);
+            columnPosition[x] = model.columnPosition(key.panelX + x);
+        }
+
+        rowPosition.resize(key.height);
+        for (int y = 0; y < key.height; y++)
+            rowPosition[y] = model.rowPosition(key.panelY + y);
+        for (int c = 0; c < 3; c++)
+        {
+            rowPhase[c].resize(key.height);
+            rowTerm[c].resize(key.height);
+            for (int y = 0; y < key.height; y++)
+                rowPhase[c][y] = model.rowPhase(c, key.panelY + y);
+        }
+    }
+
+    void PhaseMap::update(const LensPhaseModel& model, const PhaseKernels& kernels, const float eyePosition[3])
+    {
+        if (eyeValid && std::equal(eyePosition, eyePosition + 3, eye))
+            return;
+
+        kernels.shiftedPhaseRow(model, columnPhase.data(), columnPosition.data(), eyePosition[0], eyePosition[2],
+            model.columnShiftScale, key.width, columnTerm.data());
+        for (int c = 0; c < 3; c++)
+            kernels.shiftedPhaseRow(model, rowPhase[c].data(), rowPosition.data(), eyePosition[1], eyePosition[2],
+                model.rowShiftScale, key.height, rowTerm[c].data());
+
+        std::copy(eyePosition, eyePosition + 3, eye);
+        eyeValid = true;
+    }
+
+    PhaseMapCache::PhaseMapCache(size_t capacity)
+        : entries(std::max<size_t>(1, capacity))
+    {
+    }
+
+    PhaseMap& PhaseMapCache::get(const LensPhaseModel& model, const PhaseMapKey& key)
+    {
+        useCounter++;
+        Entry* oldest = &entries.front();
+        for (Entry& entry : entries)
+        {
+            if (entry.map && entry.map->getKey() == key)
+            {
+                entry.lastUse = useCounter;
+                return *entry.map;
+            }
+            if (!entry.map || (oldest->map && entry.lastUse < oldest->lastUse))
+                oldest = &entry;
+        }
+
+        // The evicted map keeps its allocations, a viewport of the same size rebuilds without allocating
+        if (!oldest->map)
+            oldest->map.reset(new PhaseMap());
+        oldest->map->build(model, key);
+        oldest->lastUse = useCounter;
+        return *oldest->map;
+    }
+
+    void PhaseMapCache::clear()
+    {
+        for (Entry& entry : entries)
+            entry.map.reset();
+    }
+}
@@ -0,0 +1,91 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "sr/types.h"
+#include "weaver/lensphase.h"
+#include "weaver/phasekernels.h"
+
+namespace SR
+{
+    /*!
+     * \brief Identifies the panel area a phase map was built for.
+     */
+    struct PhaseMapKey
+    {
+        int width = 0;                   //!< Width of the woven region in pixels
+        int height = 0;                  //!< Height of the woven region in pixels
+        int panelX = 0;                  //!< Panel column of the first woven pixel, screen rect plus viewport offset
+        int panelY = 0;                  //!< Panel row of the first woven pixel, screen rect plus viewport offset
+        uint64_t displayIdentifier = 0;  //!< WeaverDisplayGeometry::identifier
+        int64_t displayLocation[4] = {}; //!< IDisplay::getLocation(), left, top, right and bottom
+
+        bool operator==(const PhaseMapKey& other) const;
+    };
+
+    /*!
+     * \brief Lens phase terms of a woven region.
+     *
+     * The panel terms, x / px per column and rowPhase per row and sub-pixel, together with the pixel positions in mm,
+     * are built once per key. update() adds the eye dependent refraction, which costs one evaluation per column and
+     * per row instead of one per pixel, and is skipped entirely while the viewer does not move. The phase of a
+     * sub-pixel is then getRowTerm(c)[y] + getColumnTerm()[x], bit-exact identical to evaluating LensPhaseModel directly.
+     */
+    class PhaseMap
+    {
+    public:
+        void build(const LensPhaseModel& model, const PhaseMapKey& key);
+        void update(const LensPhaseModel& model, const PhaseKernels& kernels, const float eye[3]);
+
+        const PhaseMapKey& getKey() const { return key; }
+        const float* getColumnTerm() const { return columnTerm.data(); }
+        const float* getRowTerm(int c) const { return rowTerm[c].data(); }
+
+    private:
+        PhaseMapKey key;
+        std::vector<float> columnPhase;
+        std::vector<float> columnPosition;
+        std::vector<float> rowPhase[3];
+        std::vector<float> rowPosition;
+
+        std::vector<float> columnTerm;
+        std::vector<float> rowTerm[3];
+        float eye[3] = {};
+        bool eyeValid = false;
+    };
+
+    /*!
+     * \brief Keeps the phase maps of the most recently woven regions.
+     *
+     * Several maps are kept so alternating viewports, e.g. the windows of a multi-window setup, do not rebuild each other's
+     * map every frame. The least recently used map is rebuilt when a new key comes in.
+     */
+    class PhaseMapCache
+    {
+    public:
+        explicit PhaseMapCache(size_t capacity = 4);
+
+        /*!
+         * \brief Returns the map of key, building it when it is not cached
+         */
+        PhaseMap& get(const LensPhaseModel& model, const PhaseMapKey& key);
+
+        void clear();
+
+    private:
+        struct Entry
+        {
+            std::unique_ptr<PhaseMap> map;
+            uint64_t lastUse = 0;
+        };
+
+        std::vector<Entry> entries;
+        uint64_t useCounter = 0;
+    };
+}
@@ -0,0 +1,116 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "sr/utility/half.h"
+#include "sr/weaver/cpupixelformat.h"
+#include "utility/srgbtables.h"
+
+namespace SR
+{
+    /*!
+     * \brief Pixel codecs of the CPU weaving paths, selected once per call so the pixel loops are free of format branches.
+     *
+     * read() converts the RGB channels of a pixel into linear floats, write() converts them back and writes an opaque alpha.
+     */
+    struct Unorm8Codec
+    {
+        static constexpr size_t pixelSize = 4;
+
+        explicit Unorm8Codec(const SRGBTables&) {}
+
+        void read(const uint8_t* pixel, float* rgb) const
+        {
+            for (int c = 0; c < 3; c++)
+                rgb[c] = static_cast<float>(pixel[c]) / 255.0f;
+        }
+
+        void write(const float* rgb, uint8_t* pixel) const
+        {
+            for (int c = 0; c < 3; c++)
+                pixel[c] = static_cast<uint8_t>(std::min(std::max(rgb[c], 0.0f), 1.0f) * 255.0f + 0.5f);
+            pixel[3] = 255;
+        }
+
+        static void copyAlpha(const uint8_t* from, uint8_t* to)
+        {
+            to[3] = from[3];
+        }
+    };
+
+    /*!
+     * \brief RGBA8 holding sRGB encoded values, as selected by setShaderSRGBConversion()
+     */
+    struct SRGB8Codec
+    {
+        static constexpr size_t pixelSize = 4;
+
+        explicit SRGB8Codec(const SRGBTables& tables) : tables(tables) {}
+
+        void read(const uint8_t* pixel, float* rgb) const
+        {
+            for (int c = 0; c < 3; c++)
+                rgb[c] = tables.decode[pixel[c]];
+        }
+
+        void write(const float* rgb, uint8_t* pixel) const
+        {
+            for (int c = 0; c < 3; c++)
+                pixel[c] = encodeSRGB(tables, rgb[c]);
+            pixel[3] = 255;
+        }
+
+        static void copyAlpha(const uint8_t* from, uint8_t* to)
+        {
+            to[3] = from[3];
+        }
+
+        const SRGBTables& tables;
+    };
+
+    struct Half16Codec
+    {
+        static constexpr size_t pixelSize = 8;
+
+        explicit Half16Codec(const SRGBTables&) {}
+
+        void read(const uint8_t* pixel, float* rgb) const
+        {
+            uint16_t half[3];
+            std::memcpy(half, pixel, sizeof(half));
+            for (int c = 0; c < 3; c++)
+                rgb[c] = halfToFloat(half[c]);
+        }
+
+        void write(const float* rgb, uint8_t* pixel) const
+        {
+            const uint16_t half[4] = { floatToHalf(rgb[0]), floatToHalf(rgb[1]), floatToHalf(rgb[2]), 0x3c00 };
+            std::memcpy(pixel, half, sizeof(half));
+        }
+
+        static void copyAlpha(const uint8_t* from, uint8_t* to)
+        {
+            std::memcpy(to + 6, from + 6, 2);
+        }
+    };
+
+    /*!
+     * \brief Calls \p function with the codec of \p format, sRGB only applies to RGBA8
+     */
+    template <class Function>
+    void withPixelCodec(CPUPixelFormat format, bool srgb, const SRGBTables& tables, Function&& function)
+    {
+        if (format == CPUPixelFormat::RGBA16F)
+            function(Half16Codec(tables));
+        else if (srgb)
+            function(SRGB8Codec(tables));
+        else
+            function(Unorm8Codec(tables));
+    }
+}
@@ -0,0 +1,118 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "weaver/weavepipeline.h"
+
+#include "weaver/pixelrow.h"
+
+namespace SR
+{
+    namespace
+    {
+        // Brightness of the left view for BehaviorWhenNotTracking::ShowLeftWithShader, dimmed so the user notices tracking was lost
+        constexpr float notTrackingLevel = 0.5f;
+
+        using WeaveRowFunction = void (*)(const WeavePipeline& pipeline, const WeaveRow& row);
+
+        template <class Reader, class Writer, WeaverACTMode Mode, bool Contrast>
+        void weaveRow(const WeavePipeline& pipeline, const WeaveRow& row)
+        {
+            const Reader reader(*pipeline.srgbTables);
+            const Writer writer(*pipeline.srgbTables);
+            for (int i = 0; i < row.count; i++)
+            {
+                reader.read(row.left + row.columns[i] * Reader::pixelSize, row.leftSamples + 3 * i);
+                reader.read(row.right + row.columns[i] * Reader::pixelSize, row.rightSamples + 3 * i);
+            }
+
+            if (Mode == WeaverACTMode::Static)
+                pipeline.crosstalkKernels->staticRow(pipeline.crosstalk.staticFactor, pipeline.crosstalkScale, 3 * row.count, row.leftSamples, row.rightSamples);
+            else if (Mode == WeaverACTMode::Dynamic)
+                pipeline.crosstalkKernels->dynamicRow(pipeline.crosstalk.staticFactor, pipeline.crosstalk.dynamicFactor, 3 * row.count, row.leftSamples, row.rightSamples);
+
+            for (int i = 0; i < row.count; i++)
+            {
+                const float* left = row.leftSamples + 3 * i;
+                const float* right = row.rightSamples + 3 * i;
+                float woven[3];
+                for (int c = 0; c < 3; c++)
+                {
+                    float weight = row.weights[c][i];
+                    if (Contrast)
+                        weight = 0.5f + pipeline.contrast * (weight - 0.5f);
+                    woven[c] = right[c] + weight * (left[c] - right[c]);
+                }
+                writer.write(woven, row.output + i * Writer::pixelSize);
+            }
+        }
+
+        template <class Reader, class Writer, bool Dimmed>
+        void showLeftRow(const WeavePipeline& pipeline, const WeaveRow& row)
+        {
+            const Reader reader(*pipeline.srgbTables);
+            const Writer writer(*pipeline.srgbTables);
+            for (int i = 0; i < row.count; i++)
+            {
+                float color[3];
+                reader.read(row.left + row.columns[i] * Reader::pixelSize, color);
+                if (Dimmed)
+                    for (float& value : color)
+                        value *= notTrackingLevel;
+                writer.write(color, row.output + i * Writer::pixelSize);
+            }
+        }
+
+        template <class Reader, class Writer, WeaverACTMode Mode>
+        WeaveRowFunction selectContrast(const WeaveOptions& options)
+        {
+            if (options.contrast != 1.0f)
+                return &weaveRow<Reader, Writer, Mode, true>;
+            return &weaveRow<Reader, Writer, Mode, false>;
+        }
+
+        template <class Reader, class Writer>
+        WeaveRowFunction selectMode(const WeaveOptions& options)
+        {
+            switch (options.behavior)
+            {
+            case BehaviorWhenNotTracking::ShowLeft:           return &showLeftRow<Reader, Writer, false>;
+            case BehaviorWhenNotTracking::ShowLeftWithShader: return &showLeftRow<Reader, Writer, true>;
+            case BehaviorWhenNotTracking::Default:            break;
+            }
+
+            switch (options.crosstalk.mode)
+            {
+            case WeaverACTMode::Static:  return selectContrast<Reader, Writer, WeaverACTMode::Static>(options);
+            case WeaverACTMode::Dynamic: return selectContrast<Reader, Writer, WeaverACTMode::Dynamic>(options);
+            case WeaverACTMode::Off:     break;
+            }
+            return selectContrast<Reader, Writer, WeaverACTMode::Off>(options);
+        }
+
+        template <class Reader>
+        WeaveRowFunction selectWriter(const WeaveOptions& options, const SRGBTables& tables)
+        {
+            WeaveRowFunction function = nullptr;
+            withPixelCodec(options.outputFormat, options.srgbWrite, tables, [&](auto writer) {
+                function = selectMode<Reader, decltype(writer)>(options);
+            });
+            return function;
+        }
+    }
+
+    WeavePipeline createWeavePipeline(const WeaveOptions& options)
+    {
+        WeavePipeline pipeline;
+        pipeline.srgbTables = &getSRGBTables();
+        withPixelCodec(options.inputFormat, options.srgbRead, *pipeline.srgbTables, [&](auto reader) {
+            pipeline.weaveRow = selectWriter<decltype(reader)>(options, *pipeline.srgbTables);
+        });
+        pipeline.usesWeights = options.behavior == BehaviorWhenNotTracking::Default;
+        pipeline.contrast = options.contrast;
+        pipeline.crosstalk = clampCrosstalkParameters(options.crosstalk);
+        pipeline.crosstalkScale = 1.0f / (1.0f - pipeline.crosstalk.staticFactor);
+        pipeline.crosstalkKernels = &getCrosstalkKernels();
+        return pipeline;
+    }
+}
@@ -0,0 +1,69 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "sr/weaver/WeaverTypes.h"
+#include "sr/weaver/cpupixelformat.h"
+#include "sr/weaver/crosstalk.h"
+#include "utility/srgbtables.h"
+#include "weaver/crosstalkkernels.h"
+
+namespace SR
+{
+    /*!
+     * \brief Weaver settings that decide which row function a weave runs.
+     */
+    struct WeaveOptions
+    {
+        CPUPixelFormat inputFormat = CPUPixelFormat::RGBA8;
+        CPUPixelFormat outputFormat = CPUPixelFormat::RGBA8;
+        bool srgbRead = false;
+        bool srgbWrite = false;
+        CrosstalkParameters crosstalk;
+        float contrast = 1.0f;                                               //!< In [0, 1]
+        BehaviorWhenNotTracking behavior = BehaviorWhenNotTracking::Default; //!< Default while tracking
+    };
+
+    /*!
+     * \brief One row of a tile, as passed to WeavePipeline::weaveRow.
+     */
+    struct WeaveRow
+    {
+        const uint8_t* left;     //!< First pixel of the left view row
+        const uint8_t* right;    //!< First pixel of the right view row
+        const uint32_t* columns; //!< Source pixel of every output pixel
+        const float* weights[3]; //!< Left weight of every output pixel per sub-pixel, unused if !usesWeights
+        int count;               //!< Number of output pixels
+        uint8_t* output;         //!< First output pixel
+        float* leftSamples;      //!< Scratch for 3 * count floats
+        float* rightSamples;     //!< Scratch for 3 * count floats
+    };
+
+    /*!
+     * \brief Fused weaving row function, specialized at compile time on the active options.
+     *
+     * Every combination of input codec, output codec, ACT mode, contrast and fallback behavior is its own
+     * instantiation, so the pixel loops contain no option branches. A row samples every source pixel once into
+     * interleaved linear floats, applies ACT with the SIMD kernels while the samples are in L1, and interleaves,
+     * encodes and stores the output in a single loop.
+     */
+    struct WeavePipeline
+    {
+        void (*weaveRow)(const WeavePipeline& pipeline, const WeaveRow& row);
+        bool usesWeights;                        //!< False when a fallback shows the left view, the phase is not needed then
+        float contrast;
+        CrosstalkParameters crosstalk;           //!< Clamped
+        float crosstalkScale;                    //!< 1 / (1 - staticFactor)
+        const CrosstalkKernels* crosstalkKernels;
+        const SRGBTables* srgbTables;
+    };
+
+    /*!
+     * \brief Selects the row function of \p options and the kernels of the current instruction set
+     */
+    WeavePipeline createWeavePipeline(const WeaveOptions& options);
+}
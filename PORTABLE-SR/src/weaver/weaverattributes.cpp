@@ -0,0 +1,61 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include "sr/weaver/weaverattributes.h"
+
+#include "weaver/phasekernels.h"
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+#include "sr/weaver/WeaverC.h"
+#endif
+
+namespace SR
+{
+    namespace
+    {
+        void fillChannel(const PhaseKernels& kernels, float offset, float scaleX, float scaleY, int y, int x, int count, float* out)
+        {
+            if (out != nullptr)
+                kernels.affineRow(offset + scaleY * static_cast<float>(y), scaleX, x, count, out);
+        }
+    }
+
+#ifdef SRPORTABLE_WITH_SDK_RUNTIME
+    WeaverInterpolators WeaverInterpolators::fromDimencoWeaver(const FLOAT2& textureRes)
+    {
+        WeaverInterpolators interpolators;
+        ::FillInterpolators(textureRes,
+            &interpolators.phasesOffset, &interpolators.phasesScaleX, &interpolators.phasesScaleY,
+            &interpolators.dxyOffset, &interpolators.dxyScaleX, &interpolators.dxyScaleY,
+            &interpolators.screenPosOffset, &interpolators.screenPosScaleX, &interpolators.screenPosScaleY,
+            &interpolators.weaverVarsOffset, &interpolators.weaverVarsScaleX, &interpolators.weaverVarsScaleY);
+        return interpolators;
+    }
+#endif
+
+    void fillAttributeRow(const WeaverInterpolators& interpolators, int y, int x, int count, const WeaverAttributeRow& row)
+    {
+        if (count <= 0)
+            return;
+
+        const PhaseKernels& kernels = getPhaseKernels();
+        const WeaverInterpolators& i = interpolators;
+
+        fillChannel(kernels, i.phasesOffset.x, i.phasesScaleX.x, i.phasesScaleY.x, y, x, count, row.phases[0]);
+        fillChannel(kernels, i.phasesOffset.y, i.phasesScaleX.y, i.phasesScaleY.y, y, x, count, row.phases[1]);
+        fillChannel(kernels, i.phasesOffset.z, i.phasesScaleX.z, i.phasesScaleY.z, y, x, count, row.phases[2]);
+        fillChannel(kernels, i.phasesOffset.w, i.phasesScaleX.w, i.phasesScaleY.w, y, x, count, row.phases[3]);
+
+        fillChannel(kernels, i.dxyOffset.x, i.dxyScaleX.x, i.dxyScaleY.x, y, x, count, row.dxy[0]);
+        fillChannel(kernels, i.dxyOffset.y, i.dxyScaleX.y, i.dxyScaleY.y, y, x, count, row.dxy[1]);
+        fillChannel(kernels, i.dxyOffset.z, i.dxyScaleX.z, i.dxyScaleY.z, y, x, count, row.dxy[2]);
+        fillChannel(kernels, i.dxyOffset.w, i.dxyScaleX.w, i.dxyScaleY.w, y, x, count, row.dxy[3]);
+
+        fillChannel(kernels, i.screenPosOffset.x, i.screenPosScaleX.x, i.screenPosScaleY.x, y, x, count, row.screenPos[0]);
+        fillChannel(kernels, i.screenPosOffset.y, i.screenPosScaleX.y, i.screenPosScaleY.y, y, x, count, row.screenPos[1]);
+
+        fillChannel(kernels, i.weaverVarsOffset.x, i.weaverVarsScaleX.x, i.weaverVarsScaleY.x, y, x, count, row.weaverVars[0]);
+        fillChannel(kernels, i.weaverVarsOffset.y, i.weaverVarsScaleX.y, i.weaverVarsScaleY.y, y, x, count, row.weaverVars[1]);
+    }
+}
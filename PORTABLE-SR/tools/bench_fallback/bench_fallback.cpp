@@ -0,0 +1,204 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/toolsupport.h"
+#include "sr/sense/eyetracker/fallbackanimator.h"
+
+struct Curve
+{
+    std::string name;
+    SR::EasingCurve curve;
+};
+
+static const Curve knownCurves[] = {
+    { "linear", SR::EasingCurve::Linear },
+    { "smoothstep", SR::EasingCurve::SmoothStep },
+    { "smootherstep", SR::EasingCurve::SmootherStep },
+    { "ease-out-cubic", SR::EasingCurve::EaseOutCubic },
+    { "critically-damped", SR::EasingCurve::CriticallyDamped },
+};
+
+// Where update() is called relative to the UserLost or UserFound event
+enum class Phase { Tracking, Reacquire, Hold, Fallback, Default, Events };
+
+static const struct { const char* name; Phase phase; } phases[] = {
+    { "tracking", Phase::Tracking },
+    { "reacquire", Phase::Reacquire },
+    { "hold", Phase::Hold },
+    { "fallback", Phase::Fallback },
+    { "default", Phase::Default },
+    { "events", Phase::Events },
+};
+
+struct Result
+{
+    std::string curve;
+    std::string phase;
+    size_t tableSize;
+    double nsPerUpdate;
+};
+
+static double run(const Curve& curve, Phase phase, size_t tableSize, double minimumSeconds)
+{
+    SR::FallbackAnimatorSettings settings;
+    settings.fallbackCurve = curve.curve;
+    settings.reacquireCurve = curve.curve;
+    settings.tableSize = tableSize;
+    SR::FallbackAnimator animator(settings);
+
+    // Update times spread over the phase in random order, so every part of the curve is hit
+    const uint64_t eventTime = 1000000000;
+    uint64_t begin = eventTime, end = eventTime + 1000000;
+    switch (phase) {
+    case Phase::Tracking:  begin = eventTime + settings.reacquireDuration; end = begin + 1000000; break;
+    case Phase::Reacquire: end = eventTime + settings.reacquireDuration; break;
+    case Phase::Hold:      end = eventTime + settings.lostDelay; break;
+    case Phase::Fallback:  begin = eventTime + settings.lostDelay; end = begin + settings.fallbackDuration; break;
+    case Phase::Default:   begin = eventTime + settings.lostDelay + settings.fallbackDuration; end = begin + 1000000; break;
+    case Phase::Events:    break;
+    }
+    const bool tracking = phase == Phase::Tracking || phase == Phase::Reacquire || phase == Phase::Events;
+    animator.setTracking(tracking, eventTime);
+
+    const size_t count = 4096;
+    std::mt19937 random(1);
+    std::vector<uint64_t> times(count);
+    for (uint64_t& time : times)
+        time = begin + random() % (end - begin);
+    std::vector<SR_eyePair> pairs(64);
+    for (size_t i = 0; i < pairs.size(); i++) {
+        const double x = std::uniform_real_distribution<double>(-100.0, 100.0)(random);
+        pairs[i].frameId = i;
+        pairs[i].left = SR_point3d{ x - 31.5, 100.0, 600.0 };
+        pairs[i].right = SR_point3d{ x + 31.5, 100.0, 600.0 };
+    }
+
+    volatile double sink = 0.0;
+    return Tools::measure([&] {
+        SR_eyePair output;
+        double sum = 0.0;
+        for (size_t i = 0; i < count; i++) {
+            // Events toggles tracking every 64 frames, which includes the cost of setTracking()
+            if (phase == Phase::Events && i % 64 == 0)
+                animator.setTracking(!animator.isTracking(), eventTime + i * 1000);
+            animator.update(phase == Phase::Events ? eventTime + i * 1000 : times[i], pairs[i % pairs.size()], output);
+            sum += output.left.x;
+        }
+        sink = sink + sum;
+    }, minimumSeconds) / static_cast<double>(count);
+}
+
+static void writeJSON(std::ostream& stream, const std::vector<Result>& results)
+{
+    stream << "{\n";
+    stream << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        stream << "    { \"curve\": \"" << r.curve << "\", \"phase\": \"" << r.phase << "\", \"tableSize\": " << r.tableSize
+               << ", \"nsPerUpdate\": " << r.nsPerUpdate << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    stream << "  ]\n}\n";
+}
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: bench_fallback [options]\n"
+        << "  --curves LIST            linear, smoothstep, smootherstep, ease-out-cubic and critically-damped (default: all)\n"
+        << "  --table-sizes LIST       Samples per precomputed curve (default: 64,256,4096)\n"
+        << "  --min-time SECONDS       Minimum time spent per timing (default: 0.1)\n"
+        << "  --json FILE              Write the results as JSON\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Curve> curves(std::begin(knownCurves), std::end(knownCurves));
+    std::vector<size_t> tableSizes = { 64, 256, 4096 };
+    std::string jsonPath;
+    double minimumSeconds = 0.1;
+
+    Tools::Arguments arguments(argc, argv);
+    while (arguments.next())
+    {
+        bool valid = true;
+        if (arguments.is("--curves", 1)) {
+            curves.clear();
+            for (const std::string& name : arguments.getList()) {
+                auto known = std::find_if(std::begin(knownCurves), std::end(knownCurves), [&](const Curve& c) { return c.name == name; });
+                valid = valid && known != std::end(knownCurves);
+                if (known != std::end(knownCurves))
+                    curves.push_back(*known);
+            }
+        } else if (arguments.is("--table-sizes", 1)) {
+            tableSizes.clear();
+            for (const std::string& size : arguments.getList()) {
+                tableSizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+                valid = valid && tableSizes.back() >= 2;
+            }
+        } else if (arguments.is("--min-time", 1)) {
+            minimumSeconds = arguments.getDouble();
+        } else if (arguments.is("--json", 1)) {
+            jsonPath = arguments.getString();
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            printUsage();
+            return 1;
+        }
+    }
+    if (curves.empty() || tableSizes.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::cout << "ns per update(), the cost should not depend on the curve, the table size or the phase\n";
+    std::cout << std::left << std::setw(28) << "case";
+    for (const auto& phase : phases)
+        std::cout << std::right << std::setw(11) << phase.name;
+    std::cout << "\n" << std::fixed << std::setprecision(2);
+
+    std::vector<Result> results;
+    for (const Curve& curve : curves) {
+        for (size_t tableSize : tableSizes) {
+            std::cout << std::left << std::setw(28) << curve.name + "/" + std::to_string(tableSize) << std::right;
+            for (const auto& phase : phases) {
+                const Result result = { curve.name, phase.name, tableSize, run(curve, phase.phase, tableSize, minimumSeconds) };
+                std::cout << std::setw(11) << result.nsPerUpdate << std::flush;
+                results.push_back(result);
+            }
+            std::cout << "\n";
+        }
+    }
+
+    // Events include setTracking() calls, the steady phases show the cost of update() alone
+    double fastest = 0.0, slowest = 0.0;
+    for (const Result& result : results) {
+        if (result.phase == "events")
+            continue;
+        fastest = fastest == 0.0 ? result.nsPerUpdate : std::min(fastest, result.nsPerUpdate);
+        slowest = std::max(slowest, result.nsPerUpdate);
+    }
+    std::cout << "Slowest to fastest update() without events: " << slowest / fastest << "x" << std::endl;
+
+    if (!jsonPath.empty()) {
+        std::ofstream file(jsonPath);
+        file << std::setprecision(6);
+        writeJSON(file, results);
+        if (!file) {
+            std::cerr << "Failed to write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
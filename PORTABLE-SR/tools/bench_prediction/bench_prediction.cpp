@@ -0,0 +1,382 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/toolsupport.h"
+#include "sr/sense/core/senserecording.h"
+#include "sr/sense/eyetracker/eyepredictor.h"
+#include "sr/utility/eyetrajectory.h"
+
+struct Model
+{
+    std::string name;
+    SR::EyePredictorModel model;
+};
+
+static const Model knownModels[] = {
+    { "cv", SR::EyePredictorModel::ConstantVelocity },
+    { "ca", SR::EyePredictorModel::ConstantAcceleration },
+    { "kalman", SR::EyePredictorModel::Kalman },
+    { "one-euro", SR::EyePredictorModel::OneEuro },
+};
+
+struct Result
+{
+    std::string name;
+    std::string model;
+    double latency;     //!< ms
+    size_t predictions; //!< Eyes with a ground truth, two per replayed sample
+    double rms;         //!< mm
+    double p50;
+    double p95;
+    double p99;
+    double maximum;
+    double jitter;      //!< RMS change of the error vector between consecutive predictions, mm
+    double nsPerPredict;
+    double nsPerBatched; //!< Per prediction when all latencies are predicted in one call
+    double nsPerAccept;
+};
+
+// Reads an eye pair recording, or a text file with one "frameId time lx ly lz rx ry rz" line per sample, time in microseconds,
+// lines starting with # are skipped
+static bool loadTrace(const std::string& path, std::vector<SR_eyePair>& trace)
+{
+    SR::SenseRecording recording;
+    if (recording.open(path)) {
+        if (recording.getType() != SR::SenseRecordType::EyePair)
+            return false;
+        const SR_eyePair* first = &recording.get<SR_eyePair>(0);
+        trace.assign(first, first + recording.size());
+        for (size_t i = 1; i < trace.size(); i++)
+            if (trace[i].time <= trace[i - 1].time)
+                return false;
+        return trace.size() >= 2;
+    }
+
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream stream(line);
+        SR_eyePair pair = {};
+        if (!(stream >> pair.frameId >> pair.time >> pair.left.x >> pair.left.y >> pair.left.z >> pair.right.x >> pair.right.y >> pair.right.z))
+            return false;
+        if (!trace.empty() && pair.time <= trace.back().time)
+            return false;
+        trace.push_back(pair);
+    }
+    return trace.size() >= 2;
+}
+
+// Samples a sway at the tracker rate with seeded noise, like an eye tracker following a swaying viewer
+static std::vector<SR_eyePair> createTrace(double rate, double duration, float noise)
+{
+    const float center[3] = { 0.0f, 100.0f, 600.0f };
+    const SR::EyeTrajectory trajectory = SR::EyeTrajectory::sway(center, 100.0f, 0.5, duration);
+    std::mt19937 random(1);
+    std::normal_distribution<double> distribution(0.0, noise);
+    std::vector<SR_eyePair> trace(static_cast<size_t>(duration * rate) + 1);
+    for (size_t i = 0; i < trace.size(); i++) {
+        const double time = static_cast<double>(i) / rate;
+        float position[3];
+        trajectory.evaluate(time, position);
+        SR_eyePair& pair = trace[i];
+        pair.frameId = i;
+        pair.time = static_cast<uint64_t>(std::llround(time * 1.0e6));
+        for (int c = 0; c < 3; c++) {
+            pair.left.p[c] = position[c] + (noise > 0.0f ? distribution(random) : 0.0);
+            pair.right.p[c] = position[c] + (noise > 0.0f ? distribution(random) : 0.0);
+        }
+        pair.left.x -= 31.5;
+        pair.right.x += 31.5;
+    }
+    return trace;
+}
+
+// Recorded position at time, interpolated linearly between samples, false outside the trace
+static bool interpolate(const std::vector<SR_eyePair>& trace, uint64_t time, SR_eyePair& output)
+{
+    auto next = std::lower_bound(trace.begin(), trace.end(), time, [](const SR_eyePair& pair, uint64_t t) { return pair.time < t; });
+    if (next == trace.end() || (next == trace.begin() && next->time != time))
+        return false;
+    if (next->time == time) {
+        output = *next;
+        return true;
+    }
+    const SR_eyePair& previous = *(next - 1);
+    const double fraction = static_cast<double>(time - previous.time) / static_cast<double>(next->time - previous.time);
+    for (int e = 0; e < 2; e++)
+        for (int c = 0; c < 3; c++)
+            output.eyes[e].p[c] = previous.eyes[e].p[c] + fraction * (next->eyes[e].p[c] - previous.eyes[e].p[c]);
+    return true;
+}
+
+static double percentile(const std::vector<double>& sorted, double fraction)
+{
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(fraction * static_cast<double>(sorted.size())))];
+}
+
+// After every sample, predicts latency ahead and compares with the recorded position at that time
+static Result evaluate(const Model& model, const SR::EyePredictorSettings& base, const std::vector<SR_eyePair>& trace, double latency,
+    double minimumSeconds)
+{
+    SR::EyePredictorSettings settings = base;
+    settings.model = model.model;
+    const std::unique_ptr<SR::EyePredictor> predictor = SR::createEyePredictor(settings);
+    const uint64_t latencyMicroseconds = static_cast<uint64_t>(std::llround(latency * 1000.0));
+
+    std::vector<double> errors;
+    double jitterSquares = 0.0;
+    size_t jitterCount = 0;
+    double previousError[2][3] = {};
+    bool hasPrevious = false;
+    for (const SR_eyePair& sample : trace) {
+        predictor->accept(sample);
+        SR_eyePair predicted, actual;
+        if (!interpolate(trace, sample.time + latencyMicroseconds, actual) || !predictor->predict(sample.time + latencyMicroseconds, predicted)) {
+            hasPrevious = false;
+            continue;
+        }
+        for (int e = 0; e < 2; e++) {
+            double squares = 0.0, changeSquares = 0.0;
+            for (int c = 0; c < 3; c++) {
+                const double error = predicted.eyes[e].p[c] - actual.eyes[e].p[c];
+                squares += error * error;
+                changeSquares += (error - previousError[e][c]) * (error - previousError[e][c]);
+                previousError[e][c] = error;
+            }
+            errors.push_back(std::sqrt(squares));
+            if (hasPrevious) {
+                jitterSquares += changeSquares;
+                jitterCount++;
+            }
+        }
+        hasPrevious = true;
+    }
+
+    Result result = {};
+    result.name = model.name + "/" + std::to_string(latencyMicroseconds / 1000) + "ms";
+    result.model = model.name;
+    result.latency = latency;
+    result.predictions = errors.size();
+    if (!errors.empty()) {
+        double squares = 0.0;
+        for (double error : errors)
+            squares += error * error;
+        result.rms = std::sqrt(squares / static_cast<double>(errors.size()));
+        std::sort(errors.begin(), errors.end());
+        result.p50 = percentile(errors, 0.5);
+        result.p95 = percentile(errors, 0.95);
+        result.p99 = percentile(errors, 0.99);
+        result.maximum = errors.back();
+    }
+    if (jitterCount > 0)
+        result.jitter = std::sqrt(jitterSquares / static_cast<double>(jitterCount));
+
+    // accept() is timed over a full replay, predict() on the filled predictor, both per call
+    const double count = static_cast<double>(trace.size());
+    result.nsPerAccept = Tools::measure([&] {
+        predictor->reset();
+        for (const SR_eyePair& sample : trace)
+            predictor->accept(sample);
+    }, minimumSeconds) / count;
+    volatile double sink = 0.0;
+    result.nsPerPredict = Tools::measure([&] {
+        SR_eyePair predicted;
+        double sum = 0.0;
+        for (const SR_eyePair& sample : trace) {
+            predictor->predict(sample.time + latencyMicroseconds, predicted);
+            sum += predicted.left.x;
+        }
+        sink = sink + sum;
+    }, minimumSeconds) / count;
+    return result;
+}
+
+// Per prediction when all latencies are predicted at once, like windows with their own latency sharing one predictor.
+// The cost does not depend on the latencies, so it is timed once per model on a predictor that saw the whole trace.
+static double measureBatched(const Model& model, const SR::EyePredictorSettings& base, const std::vector<SR_eyePair>& trace,
+    const std::vector<double>& latencies, double minimumSeconds)
+{
+    SR::EyePredictorSettings settings = base;
+    settings.model = model.model;
+    const std::unique_ptr<SR::EyePredictor> predictor = SR::createEyePredictor(settings);
+    for (const SR_eyePair& sample : trace)
+        predictor->accept(sample);
+
+    std::vector<uint64_t> offsets, times(latencies.size());
+    for (double l : latencies)
+        offsets.push_back(static_cast<uint64_t>(std::llround(l * 1000.0)));
+    std::vector<SR_eyePair> predictions(latencies.size());
+    volatile double sink = 0.0;
+    return Tools::measure([&] {
+        double sum = 0.0;
+        for (const SR_eyePair& sample : trace) {
+            for (size_t i = 0; i < offsets.size(); i++)
+                times[i] = sample.time + offsets[i];
+            predictor->predict(times.data(), times.size(), predictions.data());
+            sum += predictions.back().left.x;
+        }
+        sink = sink + sum;
+    }, minimumSeconds) / (static_cast<double>(trace.size()) * static_cast<double>(latencies.size()));
+}
+
+static void writeJSON(std::ostream& stream, const std::vector<Result>& results, size_t samples)
+{
+    stream << "{\n";
+    stream << "  \"samples\": " << samples << ",\n";
+    stream << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        stream << "    { \"name\": \"" << r.name << "\", \"model\": \"" << r.model << "\", \"latencyMs\": " << r.latency
+               << ", \"predictions\": " << r.predictions << ", \"rms\": " << r.rms << ", \"p50\": " << r.p50 << ", \"p95\": " << r.p95
+               << ", \"p99\": " << r.p99 << ", \"max\": " << r.maximum << ", \"jitter\": " << r.jitter
+               << ", \"nsPerPredict\": " << r.nsPerPredict << ", \"nsPerBatched\": " << r.nsPerBatched << ", \"nsPerAccept\": " << r.nsPerAccept << " }"
+               << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    stream << "  ]\n}\n";
+}
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: bench_prediction [options]\n"
+        << "  --trace FILE             Eye pair recording, or one \"frameId time lx ly lz rx ry rz\" line per sample, time in us (default: synthetic sway)\n"
+        << "  --rate HZ                Sample rate of the synthetic sway (default: 60)\n"
+        << "  --noise MM               Noise of the synthetic sway (default: 0.5)\n"
+        << "  --duration SECONDS       Length of the synthetic sway (default: 60)\n"
+        << "  --models LIST            cv, ca, kalman and one-euro (default: all)\n"
+        << "  --latencies LIST         Prediction horizons in ms (default: 16.667,33.333,50)\n"
+        << "  --window SAMPLES         Samples fitted by cv and ca (default: 2 for cv, 3 for ca)\n"
+        << "  --kalman Q R             Kalman acceleration noise in mm^2/s^3 and sample noise in mm (default: 1e6 1)\n"
+        << "  --one-euro MIN BETA DCUT One-Euro cutoff in Hz, speed coefficient and velocity cutoff in Hz (default: 1 0.01 1)\n"
+        << "  --min-time SECONDS       Minimum time spent per timing (default: 0.1)\n"
+        << "  --json FILE              Write the results as JSON\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Model> models(std::begin(knownModels), std::end(knownModels));
+    std::vector<double> latencies = { 1000.0 / 60.0, 2000.0 / 60.0, 50.0 };
+    SR::EyePredictorSettings settings;
+    size_t window = 0;
+    std::string tracePath, jsonPath;
+    double rate = 60.0;
+    double duration = 60.0;
+    float noise = 0.5f;
+    double minimumSeconds = 0.1;
+
+    Tools::Arguments arguments(argc, argv);
+    while (arguments.next())
+    {
+        bool valid = true;
+        if (arguments.is("--trace", 1)) {
+            tracePath = arguments.getString();
+        } else if (arguments.is("--rate", 1)) {
+            rate = arguments.getDouble();
+            valid = rate > 0.0;
+        } else if (arguments.is("--noise", 1)) {
+            noise = arguments.getFloat();
+        } else if (arguments.is("--duration", 1)) {
+            duration = arguments.getDouble();
+        } else if (arguments.is("--models", 1)) {
+            models.clear();
+            for (const std::string& name : arguments.getList()) {
+                auto known = std::find_if(std::begin(knownModels), std::end(knownModels), [&](const Model& m) { return m.name == name; });
+                valid = valid && known != std::end(knownModels);
+                if (known != std::end(knownModels))
+                    models.push_back(*known);
+            }
+        } else if (arguments.is("--latencies", 1)) {
+            latencies.clear();
+            for (const std::string& latency : arguments.getList())
+                latencies.push_back(std::strtod(latency.c_str(), nullptr));
+        } else if (arguments.is("--window", 1)) {
+            window = arguments.getUnsigned();
+        } else if (arguments.is("--kalman", 2)) {
+            settings.processNoise = arguments.getDouble();
+            settings.measurementNoise = arguments.getDouble();
+        } else if (arguments.is("--one-euro", 3)) {
+            settings.minimumCutoff = arguments.getDouble();
+            settings.beta = arguments.getDouble();
+            settings.derivativeCutoff = arguments.getDouble();
+        } else if (arguments.is("--min-time", 1)) {
+            minimumSeconds = arguments.getDouble();
+        } else if (arguments.is("--json", 1)) {
+            jsonPath = arguments.getString();
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::vector<SR_eyePair> trace;
+    if (!tracePath.empty()) {
+        if (!loadTrace(tracePath, trace)) {
+            std::cerr << "Failed to read " << tracePath << ", or it is not sorted by time" << std::endl;
+            return 1;
+        }
+    } else {
+        trace = createTrace(rate, duration, noise);
+    }
+
+    std::cout << trace.size() << " samples over " << std::setprecision(3) << static_cast<double>(trace.back().time - trace.front().time) * 1.0e-6
+              << " s, errors in mm\n";
+    std::cout << std::left << std::setw(18) << "case" << std::right << std::setw(9) << "rms" << std::setw(9) << "p50" << std::setw(9) << "p95"
+              << std::setw(9) << "p99" << std::setw(9) << "max" << std::setw(9) << "jitter" << std::setw(12) << "ns/predict" << std::setw(12) << "ns/batched"
+              << std::setw(11) << "ns/accept"
+              << "\n" << std::fixed;
+
+    std::vector<Result> results;
+    try {
+        for (const Model& model : models) {
+            // The polynomial models default to their smallest window
+            settings.window = window != 0 ? window : model.model == SR::EyePredictorModel::ConstantAcceleration ? 3 : 2;
+            const double nsPerBatched = measureBatched(model, settings, trace, latencies, minimumSeconds);
+            for (double latency : latencies) {
+                Result result = evaluate(model, settings, trace, latency, minimumSeconds);
+                result.nsPerBatched = nsPerBatched;
+                std::cout << std::left << std::setw(18) << result.name << std::right << std::setprecision(3) << std::setw(9) << result.rms
+                          << std::setw(9) << result.p50 << std::setw(9) << result.p95 << std::setw(9) << result.p99 << std::setw(9) << result.maximum
+                          << std::setw(9) << result.jitter << std::setprecision(1) << std::setw(12) << result.nsPerPredict << std::setw(12) << result.nsPerBatched
+                          << std::setw(11) << result.nsPerAccept
+                          << std::endl;
+                results.push_back(result);
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream file(jsonPath);
+        file << std::setprecision(6);
+        writeJSON(file, results, trace.size());
+        if (!file) {
+            std::cerr << "Failed to write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,358 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/toolsupport.h"
+#include "sr/network/core/sharedmemorytransport.h"
+#include "sr/network/core/tcptransport.h"
+
+// Every allocation of the process is counted, to show that steady state streaming does not allocate per packet
+static std::atomic<uint64_t> allocations{ 0 };
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// Counts the packets of one client and checks that they arrive complete and in order
+class CountingReceiver : public SR::Receiver {
+public:
+    void receive(SR_packet& packet) override
+    {
+        uint64_t sequence = 0;
+        std::memcpy(&sequence, &packet.payload, sizeof(sequence));
+        if (sequence != expected || packet.size != SR_packet_headerSize + payloadSize)
+            errors++;
+        expected = sequence + 1;
+        last.store(sequence, std::memory_order_release);
+        bytes += packet.size;
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void print(SR_packet& packet) override
+    {
+        SR_packet_print(packet);
+    }
+
+    uint64_t payloadSize = 0;
+    uint64_t expected = 0;
+    uint64_t bytes = 0;
+    uint64_t errors = 0;
+    std::atomic<uint64_t> count{ 0 };
+    std::atomic<uint64_t> last{ 0 };
+};
+
+// Sends every packet of a client back to all clients
+class EchoReceiver : public SR::Receiver {
+public:
+    void receive(SR_packet& packet) override
+    {
+        server->broadcast(packet.destination, &packet.payload, packet.size - SR_packet_headerSize);
+        server->flush();
+    }
+
+    void print(SR_packet& packet) override
+    {
+        SR_packet_print(packet);
+    }
+
+    SR::TCPServer* server = nullptr;
+};
+
+struct Result
+{
+    std::string transport;
+    size_t clients;
+    size_t payloadSize;
+    size_t coalesceSize;
+    double packetsPerSecond; //!< Received by all clients together
+    double megabytesPerSecond;
+    double allocationsPerPacket;
+    double writesPerPacket;  //!< Writes of the server per packet and client
+    uint64_t errors;
+    double roundTrip;        //!< Median microseconds from a client to the server and back
+};
+
+static bool waitFor(const std::vector<std::unique_ptr<CountingReceiver>>& receivers, uint64_t count)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    for (const std::unique_ptr<CountingReceiver>& receiver : receivers) {
+        while (receiver->count.load(std::memory_order_acquire) < count) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::yield();
+        }
+    }
+    return true;
+}
+
+static bool run(size_t clients, size_t payloadSize, const SR::TCPTransportSettings& settings, uint64_t packets, Result& result)
+{
+    EchoReceiver serverReceiver;
+    SR::TCPServer server(serverReceiver, settings);
+    serverReceiver.server = &server;
+    std::vector<std::shared_ptr<SR::TCPConnection>> accepted;
+    std::mutex acceptedMutex;
+    server.setConnectionHandler([&](const std::shared_ptr<SR::TCPConnection>& connection) {
+        std::lock_guard<std::mutex> lock(acceptedMutex);
+        accepted.push_back(connection);
+    });
+    if (!server.listen(0, "127.0.0.1"))
+        return false;
+
+    std::vector<std::unique_ptr<CountingReceiver>> receivers;
+    std::vector<std::unique_ptr<SR::TCPConnection>> connections;
+    for (size_t i = 0; i < clients; i++) {
+        receivers.emplace_back(new CountingReceiver());
+        receivers.back()->payloadSize = payloadSize;
+        connections.emplace_back(new SR::TCPConnection(*receivers.back(), settings));
+        if (!connections.back()->connect("127.0.0.1", server.getPort()))
+            return false;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (server.getConnectionCount() < clients && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (server.getConnectionCount() < clients)
+        return false;
+    // Loopback connections switch to shared memory once both sides handled the switch packets
+    auto switched = [&] {
+        std::lock_guard<std::mutex> lock(acceptedMutex);
+        bool all = accepted.size() == clients;
+        for (const std::shared_ptr<SR::TCPConnection>& connection : accepted)
+            all = all && connection->isSharedMemory();
+        for (const std::unique_ptr<SR::TCPConnection>& connection : connections)
+            all = all && connection->isSharedMemory();
+        return all;
+    };
+    while (settings.sharedMemoryRingSize != 0 && !switched() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (settings.sharedMemoryRingSize != 0 && !switched())
+        return false;
+
+    std::vector<uint64_t> payload((payloadSize + 7) / 8 + 1);
+    uint64_t sequence = 0;
+    // The server disconnects a client whose send queue overflows, so the broadcast stays at most a quarter of the queue
+    // ahead of the slowest client
+    const uint64_t window = std::max<uint64_t>(settings.sendQueueSize / 4 / (SR_packet_headerSize + payloadSize), 1);
+    auto broadcast = [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++, sequence++) {
+            if (sequence % 64 == 0 && sequence > window && !waitFor(receivers, sequence - window))
+                return false;
+            payload[0] = sequence;
+            server.broadcast(0, payload.data(), payloadSize);
+        }
+        return true;
+    };
+
+    // The warm-up grows the receive buffers and fills the allocation caches of asio
+    const uint64_t warmup = std::max<uint64_t>(packets / 10, 100);
+    if (!broadcast(warmup))
+        return false;
+    server.flush();
+    if (!waitFor(receivers, warmup))
+        return false;
+
+    auto countWrites = [&] {
+        std::lock_guard<std::mutex> lock(acceptedMutex);
+        uint64_t writes = 0;
+        for (const std::shared_ptr<SR::TCPConnection>& connection : accepted)
+            writes += connection->getWriteCount();
+        return writes;
+    };
+    const uint64_t writesBefore = countWrites();
+    const uint64_t allocationsBefore = allocations.load();
+    const auto begin = std::chrono::steady_clock::now();
+    if (!broadcast(packets))
+        return false;
+    server.flush();
+    if (!waitFor(receivers, warmup + packets))
+        return false;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    const uint64_t allocated = allocations.load() - allocationsBefore;
+    const uint64_t writes = countWrites() - writesBefore;
+
+    const double received = static_cast<double>(packets * clients);
+    result.clients = clients;
+    result.payloadSize = payloadSize;
+    result.coalesceSize = settings.coalesceSize;
+    result.packetsPerSecond = received / seconds;
+    result.megabytesPerSecond = received * static_cast<double>(SR_packet_headerSize + payloadSize) / seconds / 1e6;
+    result.allocationsPerPacket = static_cast<double>(allocated) / received;
+    result.writesPerPacket = static_cast<double>(writes) / received;
+    result.errors = 0;
+    for (const std::unique_ptr<CountingReceiver>& receiver : receivers)
+        result.errors += receiver->errors;
+
+    // Round trips of the first client through the echo of the server
+    std::vector<double> roundTrips;
+    for (int i = 0; i < 1000; i++, sequence++) {
+        payload[0] = sequence;
+        const auto sent = std::chrono::steady_clock::now();
+        connections[0]->send(0, payload.data(), payloadSize);
+        connections[0]->flush();
+        while (receivers[0]->last.load(std::memory_order_acquire) != sequence) {
+            if (std::chrono::steady_clock::now() - sent > std::chrono::seconds(5))
+                return false;
+            std::this_thread::yield();
+        }
+        roundTrips.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sent).count());
+    }
+    std::nth_element(roundTrips.begin(), roundTrips.begin() + roundTrips.size() / 2, roundTrips.end());
+    result.roundTrip = roundTrips[roundTrips.size() / 2];
+    return true;
+}
+
+static void writeJSON(std::ostream& stream, const std::vector<Result>& results)
+{
+    stream << "{\n";
+    stream << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        stream << "    { \"transport\": \"" << r.transport << "\", \"clients\": " << r.clients << ", \"payloadSize\": " << r.payloadSize
+               << ", \"coalesceSize\": " << r.coalesceSize << ", \"packetsPerSecond\": " << r.packetsPerSecond
+               << ", \"megabytesPerSecond\": " << r.megabytesPerSecond << ", \"allocationsPerPacket\": " << r.allocationsPerPacket
+               << ", \"writesPerPacket\": " << r.writesPerPacket << ", \"errors\": " << r.errors
+               << ", \"roundTrip\": " << r.roundTrip << " }"
+               << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    stream << "  ]\n}\n";
+}
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: bench_transport [options]\n"
+        << "  --transports LIST        tcp and shm, shared memory between local processes (default: tcp,shm)\n"
+        << "  --clients LIST           Loopback clients the server broadcasts to (default: 1,4)\n"
+        << "  --sizes LIST             Payload bytes per packet (default: 64,1024,65536)\n"
+        << "  --coalesce LIST          Bytes collected per TCP write, 0 writes every packet (default: 0,4096)\n"
+        << "  --delay US               Microseconds a collected packet waits at most (default: 1000)\n"
+        << "  --packets N              Packets broadcast per case after the warm-up (default: 100000)\n"
+        << "  --json FILE              Write the results as JSON\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> transports = { "tcp", "shm" };
+    std::vector<size_t> clientCounts = { 1, 4 };
+    std::vector<size_t> payloadSizes = { 64, 1024, 65536 };
+    std::vector<size_t> coalesceSizes = { 0, 4096 };
+    SR::TCPTransportSettings settings;
+    uint64_t packets = 100000;
+    std::string jsonPath;
+
+    Tools::Arguments arguments(argc, argv);
+    while (arguments.next())
+    {
+        bool valid = true;
+        if (arguments.is("--transports", 1)) {
+            transports = arguments.getList();
+            for (const std::string& transport : transports)
+                valid = valid && (transport == "tcp" || transport == "shm");
+        } else if (arguments.is("--clients", 1)) {
+            clientCounts.clear();
+            for (const std::string& count : arguments.getList()) {
+                clientCounts.push_back(std::strtoull(count.c_str(), nullptr, 10));
+                valid = valid && clientCounts.back() > 0;
+            }
+        } else if (arguments.is("--sizes", 1)) {
+            payloadSizes.clear();
+            for (const std::string& size : arguments.getList()) {
+                payloadSizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+                valid = valid && payloadSizes.back() >= sizeof(uint64_t);
+            }
+        } else if (arguments.is("--coalesce", 1)) {
+            coalesceSizes.clear();
+            for (const std::string& size : arguments.getList())
+                coalesceSizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+        } else if (arguments.is("--delay", 1)) {
+            settings.coalesceDelay = arguments.getUnsigned();
+        } else if (arguments.is("--packets", 1)) {
+            packets = arguments.getUnsigned();
+            valid = packets > 0;
+        } else if (arguments.is("--json", 1)) {
+            jsonPath = arguments.getString();
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            printUsage();
+            return 1;
+        }
+    }
+    if (transports.empty() || clientCounts.empty() || payloadSizes.empty() || coalesceSizes.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::cout << std::left << std::setw(11) << "transport" << std::setw(10) << "clients" << std::setw(10) << "payload" << std::setw(10) << "coalesce"
+              << std::right << std::setw(14) << "packets/s" << std::setw(12) << "MB/s" << std::setw(14) << "allocs/packet"
+              << std::setw(14) << "writes/packet" << std::setw(8) << "errors" << std::setw(12) << "rtt us" << "\n";
+
+    std::vector<Result> results;
+    for (const std::string& transport : transports) {
+        // Shared memory copies every packet into the ring, coalescing only applies to TCP
+        const std::vector<size_t> coalesce = transport == "tcp" ? coalesceSizes : std::vector<size_t>{ 0 };
+        settings.sharedMemoryRingSize = transport == "shm" ? SR::SharedMemoryTransportSettings().ringSize : 0;
+        for (size_t clients : clientCounts) {
+            for (size_t payloadSize : payloadSizes) {
+                for (size_t coalesceSize : coalesce) {
+                    settings.coalesceSize = coalesceSize;
+                    Result result;
+                    if (!run(clients, payloadSize, settings, packets, result)) {
+                        std::cerr << "Loopback transfer over " << transport << " with " << clients << " clients and " << payloadSize
+                                  << " byte packets failed" << std::endl;
+                        return 1;
+                    }
+                    result.transport = transport;
+                    std::cout << std::left << std::setw(11) << transport << std::setw(10) << clients << std::setw(10) << payloadSize
+                              << std::setw(10) << coalesceSize << std::right << std::fixed << std::setprecision(0) << std::setw(14)
+                              << result.packetsPerSecond << std::setprecision(1) << std::setw(12) << result.megabytesPerSecond
+                              << std::setprecision(4) << std::setw(14) << result.allocationsPerPacket << std::setw(14)
+                              << result.writesPerPacket << std::setw(8) << result.errors << std::setprecision(1) << std::setw(12)
+                              << result.roundTrip << std::endl;
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream file(jsonPath);
+        file << std::setprecision(6);
+        writeJSON(file, results);
+        if (!file) {
+            std::cerr << "Failed to write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
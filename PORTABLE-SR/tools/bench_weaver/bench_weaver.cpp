@@ -0,0 +1,454 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/toolsupport.h"
+#include "sr/utility/half.h"
+#include "sr/utility/simd.h"
+#include "sr/weaver/cpuweaver.h"
+#include "weaver/lensphase.h"
+#include "weaver/phasekernels.h"
+#include "weaver/phasemap.h"
+#include "weaver/weavepipeline.h"
+
+struct Resolution
+{
+    std::string name;
+    int width;
+    int height;
+};
+
+static const Resolution knownResolutions[] = {
+    { "1080p", 1920, 1080 },
+    { "1440p", 2560, 1440 },
+    { "4k", 3840, 2160 },
+    { "8k", 7680, 4320 },
+};
+
+// Names of the per-stage timings, in pipeline order. The row samples, interleaves and stores, ACT is timed as its increase of the row.
+static const char* const stageNames[] = { "phase", "weights", "row", "act" };
+
+struct Settings
+{
+    std::vector<Resolution> resolutions;
+    std::vector<SR::CPUPixelFormat> formats = { SR::CPUPixelFormat::RGBA8, SR::CPUPixelFormat::RGBA16F };
+    std::vector<WeaverACTMode> modes = { WeaverACTMode::Off, WeaverACTMode::Static, WeaverACTMode::Dynamic };
+    std::vector<unsigned int> threads = { 1, 0 };
+    std::set<std::string> selected[4]; //!< Parts of the case names chosen on the command line, empty where every case counts
+    bool srgb = false;
+    double minimumSeconds = 0.2;
+};
+
+struct Result
+{
+    std::string name;
+    Resolution resolution;
+    SR::CPUPixelFormat format;
+    WeaverACTMode mode;
+    unsigned int threads;
+    double nsPerPixel;
+    double gbPerSecond;
+    std::map<std::string, double> stages; //!< ns per pixel, single threaded
+};
+
+static const char* formatName(SR::CPUPixelFormat format)
+{
+    return format == SR::CPUPixelFormat::RGBA16F ? "rgba16f" : "rgba8";
+}
+
+// The thread part of a case name, 0 stays "all" so that a baseline does not depend on the machine that wrote it
+static std::string threadsName(unsigned int threads)
+{
+    return threads == 0 ? "tall" : "t" + std::to_string(threads);
+}
+
+static const char* modeName(WeaverACTMode mode)
+{
+    switch (mode) {
+    case WeaverACTMode::Static:  return "static";
+    case WeaverACTMode::Dynamic: return "dynamic";
+    case WeaverACTMode::Off:     break;
+    }
+    return "off";
+}
+
+// Side-by-side views at the recommended view size of SR displays, two thirds of the panel resolution
+static std::vector<uint8_t> createViews(const Resolution& resolution, SR::CPUPixelFormat format, int& width, int& height)
+{
+    width = 2 * (resolution.width * 2 / 3);
+    height = resolution.height * 2 / 3;
+    std::vector<uint8_t> views(static_cast<size_t>(width) * height * SR::getCPUPixelSize(format));
+    std::mt19937 random(1);
+    if (format == SR::CPUPixelFormat::RGBA16F) {
+        for (size_t i = 0; i + 1 < views.size(); i += 2) {
+            const uint16_t half = SR::floatToHalf(static_cast<float>(random() & 0xff) / 255.0f);
+            std::memcpy(&views[i], &half, sizeof(half));
+        }
+    } else {
+        for (uint8_t& value : views)
+            value = static_cast<uint8_t>(random());
+    }
+    return views;
+}
+
+// Runs the row function the weaver selects for options over a full frame on the calling thread, in ns per output pixel
+static double measureRows(const SR::WeaveOptions& options, const std::vector<uint8_t>& views, int viewsWidth, int viewsHeight,
+    const std::vector<uint32_t>& columns, const float* const weights[3], int height, double minimumSeconds)
+{
+    const SR::WeavePipeline pipeline = SR::createWeavePipeline(options);
+    const int width = static_cast<int>(columns.size());
+    const size_t rowPitch = static_cast<size_t>(viewsWidth) * SR::getCPUPixelSize(options.inputFormat);
+    const size_t outputPixelSize = static_cast<size_t>(SR::getCPUPixelSize(options.outputFormat));
+    std::vector<float> left(3 * static_cast<size_t>(width));
+    std::vector<float> right(3 * static_cast<size_t>(width));
+    std::vector<uint8_t> output(static_cast<size_t>(width) * height * outputPixelSize);
+
+    SR::WeaveRow row;
+    row.columns = columns.data();
+    std::copy(weights, weights + 3, row.weights);
+    row.count = width;
+    row.leftSamples = left.data();
+    row.rightSamples = right.data();
+    return Tools::measure([&] {
+        for (int y = 0; y < height; y++) {
+            row.left = views.data() + static_cast<size_t>((2 * static_cast<int64_t>(y) + 1) * viewsHeight / (2 * height)) * rowPitch;
+            row.right = row.left + rowPitch / 2;
+            row.output = output.data() + static_cast<size_t>(y) * width * outputPixelSize;
+            pipeline.weaveRow(pipeline, row);
+        }
+    }, minimumSeconds) / (static_cast<double>(width) * height);
+}
+
+// Times every stage of a frame on one thread, in ns per output pixel
+static std::map<std::string, double> measureStages(const Resolution& resolution, SR::CPUPixelFormat format, WeaverACTMode mode, bool srgb,
+    const std::vector<uint8_t>& views, int viewsWidth, int viewsHeight, double minimumSeconds)
+{
+    const SR::WeaverLensParameters lens;
+    SR::WeaverDisplayGeometry display;
+    display.resolutionWidth = resolution.width;
+    display.resolutionHeight = resolution.height;
+    const SR::LensPhaseModel model(lens, display);
+    const SR::PhaseKernels& kernels = SR::getPhaseKernels();
+    const double pixels = static_cast<double>(resolution.width) * resolution.height;
+
+    SR::PhaseMapKey key;
+    key.width = resolution.width;
+    key.height = resolution.height;
+    SR::PhaseMap phaseMap;
+    phaseMap.build(model, key);
+    float eye[3] = { 0.0f, 100.0f, 600.0f };
+    std::map<std::string, double> stages;
+    stages["phase"] = Tools::measure([&] {
+        // A moving viewer, otherwise the update is skipped
+        eye[0] = eye[0] == 0.0f ? 0.5f : 0.0f;
+        phaseMap.update(model, kernels, eye);
+    }, minimumSeconds) / pixels;
+
+    std::vector<float> weightRow(3 * static_cast<size_t>(resolution.width));
+    stages["weights"] = Tools::measure([&] {
+        for (int y = 0; y < resolution.height; y++)
+            for (int c = 0; c < 3; c++)
+                kernels.leftWeightRow(model, phaseMap.getRowTerm(c)[y], phaseMap.getColumnTerm(), resolution.width, weightRow.data() + c * resolution.width);
+    }, minimumSeconds) / pixels;
+
+    const int viewWidth = viewsWidth / 2;
+    std::vector<uint32_t> columns(static_cast<size_t>(resolution.width));
+    for (int x = 0; x < resolution.width; x++)
+        columns[x] = static_cast<uint32_t>((2 * static_cast<int64_t>(x) + 1) * viewWidth / (2 * resolution.width));
+    const float* weights[3] = { weightRow.data(), weightRow.data() + resolution.width, weightRow.data() + 2 * resolution.width };
+
+    // The options the weaver passes to createWeavePipeline(), the stages of the fused row are switched off through them
+    SR::WeaveOptions options;
+    options.inputFormat = format;
+    options.outputFormat = format;
+    options.srgbRead = srgb;
+    options.srgbWrite = srgb;
+    options.crosstalk.mode = WeaverACTMode::Off;
+    options.crosstalk.staticFactor = 0.05f;
+    options.crosstalk.dynamicFactor = 0.2f;
+    stages["row"] = measureRows(options, views, viewsWidth, viewsHeight, columns, weights, resolution.height, minimumSeconds);
+    stages["act"] = 0.0;
+    if (mode != WeaverACTMode::Off) {
+        options.crosstalk.mode = mode;
+        const double withACT = measureRows(options, views, viewsWidth, viewsHeight, columns, weights, resolution.height, minimumSeconds);
+        stages["act"] = std::max(withACT - stages["row"], 0.0);
+    }
+    return stages;
+}
+
+static Result measureWeave(const Resolution& resolution, SR::CPUPixelFormat format, WeaverACTMode mode, unsigned int threads, bool srgb,
+    const std::vector<uint8_t>& views, int viewsWidth, int viewsHeight, double minimumSeconds)
+{
+    SR::WeaverDisplayGeometry display;
+    display.resolutionWidth = resolution.width;
+    display.resolutionHeight = resolution.height;
+    const int pixelSize = SR::getCPUPixelSize(format);
+    std::vector<uint8_t> output(static_cast<size_t>(resolution.width) * resolution.height * pixelSize);
+
+    SR::ICPUWeaver1* weaver = nullptr;
+    SR::CreateCPUWeaver(SR::WeaverLensParameters(), display, &weaver);
+    weaver->setInputViewBuffer(views.data(), viewsWidth, viewsHeight, viewsWidth * pixelSize, format);
+    weaver->setOutputBuffer(output.data(), resolution.width, resolution.height, resolution.width * pixelSize, format);
+    weaver->setShaderSRGBConversion(srgb, srgb);
+    weaver->setACTMode(mode);
+    weaver->setCrosstalkStaticFactor(0.05f);
+    weaver->setCrosstalkDynamicFactor(0.2f);
+    weaver->setThreadCount(threads);
+
+    bool moved = false;
+    const double ns = Tools::measure([&] {
+        const float offset = moved ? 0.5f : 0.0f;
+        const float left[3] = { -31.5f + offset, 100.0f, 600.0f };
+        const float right[3] = { 31.5f + offset, 100.0f, 600.0f };
+        moved = !moved;
+        weaver->setEyePositions(left, right);
+        weaver->weave();
+    }, minimumSeconds);
+    weaver->destroy();
+
+    const double pixels = static_cast<double>(resolution.width) * resolution.height;
+    const double bytes = static_cast<double>(views.size()) + static_cast<double>(output.size());
+
+    Result result;
+    result.resolution = resolution;
+    result.format = format;
+    result.mode = mode;
+    result.threads = threads;
+    result.name = resolution.name + "/" + formatName(format) + "/" + modeName(mode) + "/" + threadsName(threads);
+    result.nsPerPixel = ns / pixels;
+    result.gbPerSecond = bytes / ns;
+    return result;
+}
+
+// One result per line, so readBaseline() can parse the file without a JSON library
+static void writeJSON(std::ostream& stream, const std::vector<Result>& results, bool srgb)
+{
+    stream << "{\n";
+    stream << "  \"simd\": \"" << SR::getSIMDLevelName(SR::getSIMDLevel()) << "\",\n";
+    stream << "  \"srgb\": " << (srgb ? "true" : "false") << ",\n";
+    stream << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        stream << "    { \"name\": \"" << r.name << "\", \"width\": " << r.resolution.width << ", \"height\": " << r.resolution.height
+               << ", \"format\": \"" << formatName(r.format) << "\", \"act\": \"" << modeName(r.mode) << "\", \"threads\": " << r.threads
+               << ", \"nsPerPixel\": " << r.nsPerPixel << ", \"gbPerSecond\": " << r.gbPerSecond << ", \"stages\": {";
+        bool first = true;
+        for (const char* stage : stageNames) {
+            stream << (first ? " " : ", ") << "\"" << stage << "\": " << r.stages.at(stage);
+            first = false;
+        }
+        stream << " } }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    stream << "  ]\n}\n";
+}
+
+// Reads the ns per pixel of every result and stage of a file written by writeJSON(), keyed by name and name/stage
+static bool readBaseline(const std::string& path, std::map<std::string, double>& baseline)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    auto readNumber = [](const std::string& line, const std::string& key, size_t from, double& value) {
+        const size_t position = line.find("\"" + key + "\": ", from);
+        if (position == std::string::npos)
+            return false;
+        value = std::strtod(line.c_str() + position + key.size() + 4, nullptr);
+        return true;
+    };
+
+    std::string line;
+    while (std::getline(file, line)) {
+        const size_t nameStart = line.find("\"name\": \"");
+        if (nameStart == std::string::npos)
+            continue;
+        const size_t nameEnd = line.find('"', nameStart + 9);
+        const std::string name = line.substr(nameStart + 9, nameEnd - nameStart - 9);
+        double value = 0.0;
+        if (readNumber(line, "nsPerPixel", nameEnd, value))
+            baseline[name] = value;
+        const size_t stages = line.find("\"stages\"", nameEnd);
+        for (const char* stage : stageNames)
+            if (stages != std::string::npos && readNumber(line, stage, stages, value))
+                baseline[name + "/" + stage] = value;
+    }
+    return true;
+}
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: bench_weaver [options]\n"
+        << "  --resolutions LIST   1080p, 1440p, 4k and 8k (default: all)\n"
+        << "  --formats LIST       rgba8 and rgba16f (default: both)\n"
+        << "  --act LIST           off, static and dynamic (default: all)\n"
+        << "  --threads LIST       Thread counts, 0 for all hardware threads, named tall (default: 1,0)\n"
+        << "  --srgb               Convert RGBA8 between sRGB and linear while weaving\n"
+        << "  --simd LEVEL         scalar, sse2, avx2, avx512 or neon (default: best supported)\n"
+        << "  --min-time SECONDS   Minimum time spent per measurement (default: 0.2)\n"
+        << "  --json FILE          Write the results as JSON\n"
+        << "  --baseline FILE      Fail when a result is slower than in this JSON file or missing\n"
+        << "  --tolerance FRACTION Allowed slowdown against the baseline (default: 0.1)\n";
+}
+
+int main(int argc, char** argv)
+{
+    Settings settings;
+    settings.resolutions.assign(std::begin(knownResolutions), std::end(knownResolutions));
+    std::string jsonPath, baselinePath;
+    double tolerance = 0.1;
+
+    Tools::Arguments arguments(argc, argv);
+    while (arguments.next())
+    {
+        bool valid = true;
+        if (arguments.is("--resolutions", 1)) {
+            settings.resolutions.clear();
+            for (const std::string& name : arguments.getList()) {
+                auto known = std::find_if(std::begin(knownResolutions), std::end(knownResolutions), [&](const Resolution& r) { return r.name == name; });
+                valid = valid && known != std::end(knownResolutions);
+                if (known != std::end(knownResolutions))
+                    settings.resolutions.push_back(*known);
+                settings.selected[0].insert(name);
+            }
+        } else if (arguments.is("--formats", 1)) {
+            settings.formats.clear();
+            for (const std::string& name : arguments.getList()) {
+                valid = valid && (name == "rgba8" || name == "rgba16f");
+                settings.formats.push_back(name == "rgba16f" ? SR::CPUPixelFormat::RGBA16F : SR::CPUPixelFormat::RGBA8);
+                settings.selected[1].insert(name);
+            }
+        } else if (arguments.is("--act", 1)) {
+            settings.modes.clear();
+            for (const std::string& name : arguments.getList()) {
+                valid = valid && (name == "off" || name == "static" || name == "dynamic");
+                settings.modes.push_back(name == "static" ? WeaverACTMode::Static : name == "dynamic" ? WeaverACTMode::Dynamic : WeaverACTMode::Off);
+                settings.selected[2].insert(name);
+            }
+        } else if (arguments.is("--threads", 1)) {
+            settings.threads.clear();
+            for (const std::string& count : arguments.getList()) {
+                settings.threads.push_back(static_cast<unsigned int>(std::atoi(count.c_str())));
+                settings.selected[3].insert(threadsName(settings.threads.back()));
+            }
+        } else if (arguments.is("--srgb")) {
+            settings.srgb = true;
+        } else if (arguments.is("--simd", 1)) {
+            const std::string name = arguments.getString();
+            if (!Tools::selectSIMDLevel(name)) {
+                std::cerr << "SIMD level " << name << " is not supported" << std::endl;
+                return 1;
+            }
+        } else if (arguments.is("--min-time", 1)) {
+            settings.minimumSeconds = arguments.getDouble();
+        } else if (arguments.is("--json", 1)) {
+            jsonPath = arguments.getString();
+        } else if (arguments.is("--baseline", 1)) {
+            baselinePath = arguments.getString();
+        } else if (arguments.is("--tolerance", 1)) {
+            tolerance = arguments.getDouble();
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::sort(settings.threads.begin(), settings.threads.end());
+    settings.threads.erase(std::unique(settings.threads.begin(), settings.threads.end()), settings.threads.end());
+
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty() && !readBaseline(baselinePath, baseline)) {
+        std::cerr << "Failed to read " << baselinePath << std::endl;
+        return 1;
+    }
+
+    std::cout << "SIMD " << SR::getSIMDLevelName(SR::getSIMDLevel()) << (settings.srgb ? ", sRGB" : "") << ", ns per pixel\n";
+    std::cout << std::left << std::setw(32) << "case" << std::right << std::setw(9) << "total" << std::setw(9) << "GB/s";
+    for (const char* stage : stageNames)
+        std::cout << std::setw(11) << stage;
+    std::cout << "\n" << std::fixed;
+
+    std::vector<Result> results;
+    for (const Resolution& resolution : settings.resolutions) {
+        for (SR::CPUPixelFormat format : settings.formats) {
+            int viewsWidth = 0, viewsHeight = 0;
+            const std::vector<uint8_t> views = createViews(resolution, format, viewsWidth, viewsHeight);
+            for (WeaverACTMode mode : settings.modes) {
+                const std::map<std::string, double> stages = measureStages(resolution, format, mode, settings.srgb, views, viewsWidth, viewsHeight, settings.minimumSeconds);
+                for (unsigned int threads : settings.threads) {
+                    Result result = measureWeave(resolution, format, mode, threads, settings.srgb, views, viewsWidth, viewsHeight, settings.minimumSeconds);
+                    result.stages = stages;
+                    std::cout << std::left << std::setw(32) << result.name << std::right << std::setprecision(3) << std::setw(9) << result.nsPerPixel
+                              << std::setprecision(2) << std::setw(9) << result.gbPerSecond << std::setprecision(3);
+                    for (const char* stage : stageNames)
+                        std::cout << std::setw(11) << stages.at(stage);
+                    std::cout << std::endl;
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream file(jsonPath);
+        file << std::setprecision(6);
+        writeJSON(file, results, settings.srgb);
+        if (!file) {
+            std::cerr << "Failed to write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+
+    // Stages are compared too, so a regression hidden by a faster stage elsewhere still fails. ACT is a difference of two
+    // runs, stages get an absolute allowance so sub-nanosecond stages do not fail on noise.
+    const double stageNoise = 0.05;
+    int regressions = 0;
+    std::map<std::string, double> unmatched = baseline;
+    auto compare = [&](const std::string& name, double value, double noise) {
+        auto reference = baseline.find(name);
+        if (reference == baseline.end())
+            return;
+        unmatched.erase(name);
+        if (value <= reference->second * (1.0 + tolerance) + noise)
+            return;
+        std::cerr << "Regression " << name << ": " << value << " ns/pixel, baseline " << reference->second << std::endl;
+        regressions++;
+    };
+    for (const Result& result : results) {
+        compare(result.name, result.nsPerPixel, 0.0);
+        for (const char* stage : stageNames)
+            compare(result.name + "/" + stage, result.stages.at(stage), stageNoise);
+    }
+    // A renamed or dropped case or stage would otherwise never fail the comparison again. Cases outside the resolutions,
+    // formats, modes and thread counts chosen on the command line were left out on purpose.
+    for (const auto& entry : unmatched) {
+        std::stringstream parts(entry.first);
+        std::string part;
+        bool chosen = true;
+        for (const std::set<std::string>& selected : settings.selected)
+            if (std::getline(parts, part, '/') && !selected.empty() && selected.count(part) == 0)
+                chosen = false;
+        if (!chosen)
+            continue;
+        std::cerr << "Missing " << entry.first << ": in the baseline but not measured" << std::endl;
+        regressions++;
+    }
+    return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "sr/utility/simd.h"
+
+// Command line parsing and timing shared by the tools, header only so every tool stays a single source file
+namespace Tools {
+
+inline std::vector<std::string> splitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+/*!
+ * \brief Walks the command line one option at a time, the getters consume the values that follow it
+ */
+class Arguments {
+public:
+    /*!
+     * \param first Index of the first option, after the program name and any positional arguments
+     */
+    Arguments(int argc, char** argv, int first = 1) : argc(argc), argv(argv), index(first - 1) {}
+
+    /*!
+     * \brief Moves to the next option, false after the last one
+     */
+    bool next() { return ++index < argc; }
+
+    std::string get() const { return argv[index]; }
+
+    /*!
+     * \brief The current option is \p option and at least \p count values follow it
+     */
+    bool is(const char* option, int count = 0) const { return get() == option && index + count < argc; }
+
+    /*!
+     * \brief The value after the current one without consuming it, empty if there is none
+     */
+    std::string peek() const { return index + 1 < argc ? argv[index + 1] : ""; }
+
+    std::string getString() { return argv[++index]; }
+    double getDouble() { return std::strtod(argv[++index], nullptr); }
+    float getFloat() { return std::strtof(argv[++index], nullptr); }
+    int getInt() { return std::atoi(argv[++index]); }
+    uint64_t getUnsigned() { return std::strtoull(argv[++index], nullptr, 10); }
+    std::vector<std::string> getList() { return splitList(argv[++index]); }
+
+private:
+    const int argc;
+    char** const argv;
+    int index;
+};
+
+/*!
+ * \brief Selects the SIMD level called \p name, false if it is unknown or not supported on this CPU
+ */
+inline bool selectSIMDLevel(const std::string& name)
+{
+    bool selected = false;
+    for (SR::SIMDLevel level : { SR::SIMDLevel::Scalar, SR::SIMDLevel::SSE2, SR::SIMDLevel::AVX2, SR::SIMDLevel::AVX512, SR::SIMDLevel::NEON })
+        if (name == SR::getSIMDLevelName(level))
+            selected = SR::setSIMDLevel(level);
+    return selected;
+}
+
+// Runs function until minimumSeconds have passed, at least three times, and returns the median duration in ns
+template <class Function>
+double measure(Function&& function, double minimumSeconds)
+{
+    using Clock = std::chrono::steady_clock;
+    function();
+    std::vector<double> samples;
+    const Clock::time_point start = Clock::now();
+    while (samples.size() < 3 || std::chrono::duration<double>(Clock::now() - start).count() < minimumSeconds) {
+        const Clock::time_point begin = Clock::now();
+        function();
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - begin).count());
+    }
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+}
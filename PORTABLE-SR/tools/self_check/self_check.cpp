@@ -0,0 +1,686 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "common/toolsupport.h"
+#include "sr/network/core/sensepackets.h"
+#include "sr/network/core/sharedmemorytransport.h"
+#include "sr/network/core/tcptransport.h"
+#include "sr/sense/core/streamstatistics.h"
+#include "sr/weaver/correctiontexturestore.h"
+
+// Counts the checks of one area and prints every failure
+class Checker {
+public:
+    void expect(bool condition, const std::string& what)
+    {
+        checks++;
+        if (!condition) {
+            failures++;
+            std::cerr << "  failed: " << what << std::endl;
+        }
+    }
+
+    void expectNear(double value, double expected, double tolerance, const std::string& what)
+    {
+        expect(std::fabs(value - expected) <= tolerance, what + " is " + std::to_string(value) + ", expected " + std::to_string(expected));
+    }
+
+    int checks = 0;
+    int failures = 0;
+};
+
+// Feeds dispatches at chosen steady clock times, as if InstrumentedListener had measured them
+class ClockedInstrumentation : public SR::StreamInstrumentation {
+public:
+    void dispatch(uint64_t frameId, int64_t nanoseconds)
+    {
+        record(frameId, 0, 0, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(nanoseconds)), 0);
+    }
+};
+
+// A constant period has no jitter, whatever its fraction of a microsecond, and alternating intervals have their deviation
+static void checkJitter(Checker& checker)
+{
+    for (int64_t period : { 999600, 1000000, 1000400, 8333333, 16666667 }) {
+        ClockedInstrumentation instrumentation;
+        for (uint64_t frame = 1; frame <= 10000; frame++)
+            instrumentation.dispatch(frame, static_cast<int64_t>(frame) * period);
+        const SR::StreamStatistics statistics = instrumentation.getStatistics();
+        const std::string name = "period of " + std::to_string(period) + " ns";
+        checker.expect(statistics.interval.count == 9999, name + " counts every interval");
+        checker.expectNear(statistics.interval.mean, static_cast<double>(period) * 1.0e-3, 1.0e-6, name + " mean");
+        checker.expectNear(statistics.jitter, 0.0, 0.01, name + " jitter");
+    }
+
+    ClockedInstrumentation alternating;
+    int64_t time = 1;
+    for (uint64_t frame = 1; frame <= 10001; frame++) {
+        alternating.dispatch(frame, time);
+        time += frame % 2 != 0 ? 900000 : 1100000;
+    }
+    checker.expectNear(alternating.getStatistics().jitter, 100.0, 0.01, "jitter of 900 and 1100 us intervals");
+}
+
+// Textures come back as stored in both compressions, and threads that store the same key at once leave one complete file
+static void checkCorrectionTextures(Checker& checker)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() /
+        ("srportable-self-check-" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count()));
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    checker.expect(!error, "create " + directory.string());
+    const SR::CorrectionTextureStore store(directory.string());
+
+    // Runs of equal pixels and noise, so the delta encoding meets both
+    const int width = 1024, height = 512, channels = 4;
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * channels);
+    uint32_t random = 1;
+    for (size_t i = 0; i < pixels.size(); i++) {
+        random = random * 1664525u + 1013904223u;
+        pixels[i] = i / 4096 % 2 == 0 ? static_cast<unsigned char>(i / 512) : static_cast<unsigned char>(random >> 24);
+    }
+    for (SR::CorrectionTextureCompression compression : { SR::CorrectionTextureCompression::None, SR::CorrectionTextureCompression::Delta }) {
+        const bool delta = compression == SR::CorrectionTextureCompression::Delta;
+        const std::string name = delta ? "delta texture" : "uncompressed texture";
+        const uint64_t key = delta ? 2 : 1;
+        checker.expect(store.store(CorrectionA, key, false, pixels.data(), width, height, channels, 32, compression) == WeaverSuccess, name + " is stored");
+        SR::CorrectionTexture texture;
+        checker.expect(store.load(CorrectionA, key, false, texture) == WeaverSuccess, name + " loads");
+        checker.expect(texture.getWidth() == width && texture.getHeight() == height && texture.getChannels() == channels &&
+                texture.getBitsPerPixel() == 32 && texture.getSize() == pixels.size(),
+            name + " keeps its description");
+        checker.expect(texture.getData() != nullptr && std::memcmp(texture.getData(), pixels.data(), pixels.size()) == 0, name + " keeps its pixels");
+        checker.expect(texture.isShared() != delta, name + " is shared only when uncompressed");
+    }
+    // The last byte belongs to the payload of both, a flipped bit has to fail the checksum rather than load wrong pixels
+    for (uint64_t key : { 1, 2 }) {
+        const std::string path = store.getPath(CorrectionA, key, false);
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+        const char last = static_cast<char>(file.get() ^ 0x10);
+        file.seekp(-1, std::ios::end);
+        file.put(last);
+        file.close();
+        SR::CorrectionTexture damaged;
+        checker.expect(store.load(CorrectionA, key, false, damaged) == WeaverTextureFailedToLoad,
+            std::string(key == 2 ? "delta" : "uncompressed") + " texture with a damaged pixel fails to load");
+    }
+    SR::CorrectionTexture missing;
+    checker.expect(store.load(CorrectionB, 1, false, missing) == WeaverTextureNotFound, "a texture that was never stored is not found");
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 8; thread++) {
+        threads.emplace_back([&, thread] {
+            const std::vector<unsigned char> fill(pixels.size(), static_cast<unsigned char>(thread));
+            for (int i = 0; i < 20; i++)
+                store.store(CorrectionB, 3, false, fill.data(), width, height, channels, 32, SR::CorrectionTextureCompression::None);
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    SR::CorrectionTexture raced;
+    const bool loaded = store.load(CorrectionB, 3, false, raced) == WeaverSuccess && raced.getSize() == pixels.size();
+    checker.expect(loaded, "a texture stored by several threads at once loads");
+    if (loaded) {
+        const unsigned char* data = raced.getData();
+        checker.expect(std::all_of(data, data + raced.getSize(), [&](unsigned char value) { return value == data[0]; }),
+            "a texture stored by several threads at once is one complete store");
+    }
+    size_t files = 0;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, error)) {
+        (void)entry;
+        files++;
+    }
+    checker.expect(files == 3, "no temporary files are left, " + std::to_string(files) + " files for 3 textures");
+    std::filesystem::remove_all(directory, error);
+}
+
+// Keeps the packets of a SensePacketWriter and hands chosen ones to a reader, laid out as a transport delivers them
+class PacketLoopback {
+public:
+    SR::SensePacketWriter::Sink getSink()
+    {
+        return [this](uint64_t destination, void* payload, uint64_t payloadSize) {
+            std::vector<uint64_t> packet(2 + (payloadSize + 7) / 8);
+            packet[0] = SR_packet_headerSize + payloadSize;
+            packet[1] = destination;
+            std::memcpy(packet.data() + 2, payload, static_cast<size_t>(payloadSize));
+            packets.push_back(std::move(packet));
+        };
+    }
+
+    void deliver(size_t index, SR::SensePacketReader& reader)
+    {
+        reader.receive(*reinterpret_cast<SR_packet*>(packets[index].data()));
+    }
+
+    void deliverAll(SR::SensePacketReader& reader)
+    {
+        for (size_t index = 0; index < packets.size(); index++)
+            deliver(index, reader);
+    }
+
+    std::vector<std::vector<uint64_t>> packets;
+};
+
+class FrameCollector : public SR::EyePairListener, public SR::HeadListener, public SR::HandPoseListener, public SR::SystemEventListener {
+public:
+    void accept(const SR_eyePair& frame) override { eyePairs.push_back(frame); }
+    void accept(const SR_head& frame) override { heads.push_back(frame); }
+    void accept(const SR_handPose& frame) override { handPoses.push_back(frame); }
+    void accept(const SR::SystemEvent& frame) override { systemEvents.push_back(frame); }
+
+    std::vector<SR_eyePair> eyePairs;
+    std::vector<SR_head> heads;
+    std::vector<SR_handPose> handPoses;
+    std::vector<SR::SystemEvent> systemEvents;
+};
+
+// Random walk in mm with fractions below the fixed point step, deterministic so a failure can be repeated
+class Walk {
+public:
+    double next(double position)
+    {
+        random = random * 6364136223846793005ull + 1442695040888963407ull;
+        return position + static_cast<double>(static_cast<int64_t>(random >> 33) % 2000001 - 1000000) * 1e-5;
+    }
+
+private:
+    uint64_t random = 1;
+};
+
+// NaN and infinity decode as NaN, everything else within the fixed point step
+static bool isNear(double value, double expected, double tolerance)
+{
+    if (!std::isfinite(expected))
+        return std::isnan(value);
+    return std::fabs(value - expected) <= tolerance;
+}
+
+static bool isNear(const SR_point3d* points, const SR_point3d* expected, int count, double tolerance)
+{
+    for (int i = 0; i < count; i++)
+        for (int axis = 0; axis < 3; axis++)
+            if (!isNear(points[i].p[axis], expected[i].p[axis], tolerance))
+                return false;
+    return true;
+}
+
+// Half a fixed point step, and a little for the rounding of the double
+const double positionTolerance = 0.005 + 1e-9;
+const double orientationTolerance = 0.5e-5 + 1e-12;
+
+static bool matches(const SR_eyePair& frame, const SR_eyePair& expected, double tolerance)
+{
+    return frame.frameId == expected.frameId && frame.time == expected.time && isNear(frame.eyes, expected.eyes, 2, tolerance);
+}
+
+static bool matches(const SR_head& frame, const SR_head& expected, double tolerance)
+{
+    return frame.frameId == expected.frameId && frame.time == expected.time && frame.headPose.frameId == expected.headPose.frameId &&
+        frame.headPose.time == expected.headPose.time && frame.eyes.frameId == expected.eyes.frameId && frame.eyes.time == expected.eyes.time &&
+        frame.ears.frameId == expected.ears.frameId && frame.ears.time == expected.ears.time &&
+        isNear(&frame.headPose.position, &expected.headPose.position, 1, tolerance) &&
+        isNear(&frame.headPose.orientation, &expected.headPose.orientation, 1, tolerance == 0.0 ? 0.0 : orientationTolerance) &&
+        isNear(frame.eyes.eyes, expected.eyes.eyes, 2, tolerance) && isNear(frame.ears.ears, expected.ears.ears, 2, tolerance);
+}
+
+static bool matches(const SR_handPose& frame, const SR_handPose& expected, double tolerance)
+{
+    return frame.frameId == expected.frameId && frame.time == expected.time && frame.handId == expected.handId && frame.side == expected.side &&
+        isNear(frame.joints, expected.joints, 21, tolerance);
+}
+
+// Every decoded frame is the one written with its frame id, a frame decoded against the wrong reference is not
+template <class Frame>
+static bool matchesWritten(const std::vector<Frame>& decoded, const std::vector<Frame>& written, double tolerance)
+{
+    return std::all_of(decoded.begin(), decoded.end(), [&](const Frame& frame) {
+        return std::any_of(written.begin(), written.end(), [&](const Frame& source) { return matches(frame, source, tolerance); });
+    });
+}
+
+static std::vector<SR_eyePair> makeEyePairs(int count)
+{
+    Walk walk;
+    std::vector<SR_eyePair> frames(count);
+    SR_point3d eyes[2] = { { -31.5, 12.25, 600.0 }, { 31.5, 12.25, 600.0 } };
+    for (int i = 0; i < count; i++) {
+        for (SR_point3d& eye : eyes)
+            for (double& coordinate : eye.p)
+                coordinate = walk.next(coordinate);
+        frames[i] = SR_eyePair{};
+        frames[i].frameId = 1000 + i;
+        frames[i].time = 1700000000000000ull + i * 8333ull + (i % 3);
+        std::copy(eyes, eyes + 2, frames[i].eyes);
+    }
+    return frames;
+}
+
+static std::vector<SR_head> makeHeads(int count)
+{
+    Walk walk;
+    std::vector<SR_head> frames(count);
+    SR_head head{};
+    head.headPose.position = { 0.0, 20.0, 650.0 };
+    head.eyes.eyes[0] = { -31.5, 12.25, 600.0 };
+    head.eyes.eyes[1] = { 31.5, 12.25, 600.0 };
+    head.ears.ears[0] = { -75.0, 0.0, 680.0 };
+    head.ears.ears[1] = { 75.0, 0.0, 680.0 };
+    for (int i = 0; i < count; i++) {
+        for (SR_point3d* point : { &head.headPose.position, &head.eyes.eyes[0], &head.eyes.eyes[1], &head.ears.ears[0], &head.ears.ears[1] })
+            for (double& coordinate : point->p)
+                coordinate = walk.next(coordinate);
+        for (double& angle : head.headPose.orientation.p)
+            angle = walk.next(angle * 100.0) / 100.0;
+        head.frameId = 5000 + i;
+        head.time = 1700000000000000ull + i * 16667ull;
+        head.headPose.frameId = head.eyes.frameId = head.ears.frameId = head.frameId - i % 2;
+        head.headPose.time = head.time - 120;
+        head.eyes.time = head.time - 80;
+        head.ears.time = head.time - 40;
+        frames[i] = head;
+    }
+    return frames;
+}
+
+// Both hands of a frame follow each other, as the hand tracker sends them
+static std::vector<SR_handPose> makeHandPoses(int count)
+{
+    Walk walk;
+    std::vector<SR_handPose> frames(count * 2);
+    for (int i = 0; i < count * 2; i++) {
+        SR_handPose& frame = frames[i];
+        frame = i < 2 ? SR_handPose{} : frames[i - 2];
+        frame.frameId = 9000 + i / 2;
+        frame.time = 1700000000000000ull + i / 2 * 11111ull;
+        frame.handId = 7 + i % 2;
+        frame.side = i % 2 == 0 ? LeftHand : RightHand;
+        for (int joint = 0; joint < 21; joint++)
+            for (int axis = 0; axis < 3; axis++)
+                frame.joints[joint].p[axis] = i < 2 ? (i % 2 == 0 ? -100.0 : 100.0) + joint * 10.0 + axis : walk.next(frame.joints[joint].p[axis]);
+    }
+    return frames;
+}
+
+// Frames of every sense come back as written in both encodings, and the compact codec keeps its edge cases: NaN and
+// infinity, the clamp of huge values, lost packets and a key frame that the transport delivered late
+static void checkSensePackets(Checker& checker)
+{
+    const std::vector<SR_eyePair> eyePairs = makeEyePairs(200);
+    const std::vector<SR_head> heads = makeHeads(200);
+    const std::vector<SR_handPose> handPoses = makeHandPoses(100);
+    std::vector<SR::SystemEvent> systemEvents(2);
+    systemEvents[0] = { 1700000000000001ull, SRUnavailable, "Display lost" };
+    systemEvents[1] = { 1700000000000002ull, SRRestored, std::string(300, 'x') };
+
+    for (SR::SensePacketEncoding encoding : { SR::SensePacketEncoding::Raw, SR::SensePacketEncoding::Compact }) {
+        const bool compact = encoding == SR::SensePacketEncoding::Compact;
+        const std::string name = compact ? "compact " : "raw ";
+        const double tolerance = compact ? positionTolerance : 0.0;
+        PacketLoopback loopback;
+        SR::SensePacketWriter writer(loopback.getSink(), encoding, 16);
+        for (size_t i = 0; i < eyePairs.size(); i++) {
+            writer.accept(eyePairs[i]);
+            writer.accept(heads[i]);
+            writer.accept(handPoses[i]);
+            if (i % 100 == 0)
+                writer.accept(systemEvents[i / 100]);
+        }
+        SR::SensePacketReader reader;
+        FrameCollector collector;
+        reader.addListener(static_cast<SR::EyePairListener*>(&collector));
+        reader.addListener(static_cast<SR::HeadListener*>(&collector));
+        reader.addListener(static_cast<SR::HandPoseListener*>(&collector));
+        reader.addListener(static_cast<SR::SystemEventListener*>(&collector));
+        loopback.deliverAll(reader);
+
+        checker.expect(writer.getSentCount() == loopback.packets.size(), name + "writer counts every packet");
+        checker.expect(reader.getDecodedCount() == loopback.packets.size() && reader.getSkippedCount() == 0 && reader.getRejectedCount() == 0,
+            name + "reader decodes every packet, " + std::to_string(reader.getDecodedCount()) + " of " + std::to_string(loopback.packets.size()));
+        checker.expect(collector.eyePairs.size() == eyePairs.size() &&
+                std::equal(eyePairs.begin(), eyePairs.end(), collector.eyePairs.begin(), [&](const SR_eyePair& expected, const SR_eyePair& frame) {
+                    return matches(frame, expected, tolerance);
+                }),
+            name + "eye pairs come back as written");
+        checker.expect(collector.heads.size() == heads.size() &&
+                std::equal(heads.begin(), heads.end(), collector.heads.begin(), [&](const SR_head& expected, const SR_head& frame) {
+                    return matches(frame, expected, tolerance);
+                }),
+            name + "heads come back as written");
+        checker.expect(collector.handPoses.size() == handPoses.size() &&
+                std::equal(collector.handPoses.begin(), collector.handPoses.end(), handPoses.begin(), [&](const SR_handPose& frame, const SR_handPose& expected) {
+                    return matches(frame, expected, tolerance);
+                }),
+            name + "hand poses come back as written");
+        checker.expect(collector.systemEvents.size() == systemEvents.size() &&
+                std::equal(systemEvents.begin(), systemEvents.end(), collector.systemEvents.begin(), [](const SR::SystemEvent& expected, const SR::SystemEvent& event) {
+                    return event.time == expected.time && event.eventType == expected.eventType && event.message == expected.message;
+                }),
+            name + "system events come back as written");
+    }
+
+    // Values without a fixed point, and deltas from and back to them
+    {
+        PacketLoopback loopback;
+        SR::SensePacketWriter writer(loopback.getSink(), SR::SensePacketEncoding::Compact, 16);
+        std::vector<SR_eyePair> written(eyePairs.begin(), eyePairs.begin() + 6);
+        const double infinity = std::numeric_limits<double>::infinity();
+        written[1].eyes[0] = { std::numeric_limits<double>::quiet_NaN(), infinity, -infinity };
+        written[2].eyes[0] = { 1e30, -1e30, 4.1e16 };
+        written[3].eyes[0] = { std::numeric_limits<double>::quiet_NaN(), -1e30, 1e30 };
+        written[4].eyes[1] = { std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), -0.0 };
+        for (const SR_eyePair& frame : written)
+            writer.accept(frame);
+        SR_head head = heads[0];
+        head.headPose.orientation = { std::numeric_limits<double>::quiet_NaN(), infinity, 0.5 };
+        writer.accept(head);
+        writer.accept(heads[1]);
+
+        SR::SensePacketReader reader;
+        FrameCollector collector;
+        reader.addListener(static_cast<SR::EyePairListener*>(&collector));
+        reader.addListener(static_cast<SR::HeadListener*>(&collector));
+        loopback.deliverAll(reader);
+        checker.expect(collector.eyePairs.size() == written.size() && collector.heads.size() == 2 && reader.getRejectedCount() == 0,
+            "frames with values without a fixed point decode");
+        if (collector.eyePairs.size() == written.size() && collector.heads.size() == 2) {
+            const SR_point3d* eyes = collector.eyePairs[1].eyes;
+            checker.expect(std::isnan(eyes[0].x) && std::isnan(eyes[0].y) && std::isnan(eyes[0].z), "NaN and infinity decode as NaN");
+            checker.expect(isNear(collector.eyePairs[1].eyes[1].p[0], written[1].eyes[1].p[0], positionTolerance), "the other eye keeps its values");
+            eyes = collector.eyePairs[2].eyes;
+            checker.expectNear(eyes[0].x, 4e16, 0.0, "1e30 mm is clamped");
+            checker.expectNear(eyes[0].y, -4e16, 0.0, "-1e30 mm is clamped");
+            checker.expectNear(eyes[0].z, 4e16, 0.0, "4.1e16 mm is clamped");
+            eyes = collector.eyePairs[3].eyes;
+            checker.expect(std::isnan(eyes[0].x) && eyes[0].y == -4e16 && eyes[0].z == 4e16, "deltas between NaN and clamped values");
+            eyes = collector.eyePairs[4].eyes;
+            checker.expect(eyes[1].x == 4e16 && eyes[1].y == -4e16 && eyes[1].z == 0.0, "the largest doubles are clamped");
+            checker.expect(matches(collector.eyePairs[5], written[5], positionTolerance), "the frame after them decodes as written");
+            const SR_point3d& orientation = collector.heads[0].headPose.orientation;
+            checker.expect(std::isnan(orientation.x) && std::isnan(orientation.y) && isNear(orientation.z, 0.5, orientationTolerance),
+                "an orientation without a fixed point decodes as NaN");
+            checker.expect(matches(collector.heads[1], heads[1], positionTolerance), "the head after it decodes as written");
+        }
+    }
+
+    // Packets 5 and 6 are lost, the reader skips the deltas that follow them until the key frame at 16
+    {
+        PacketLoopback loopback;
+        SR::SensePacketWriter writer(loopback.getSink(), SR::SensePacketEncoding::Compact, 16);
+        for (const SR_eyePair& frame : eyePairs)
+            writer.accept(frame);
+        SR::SensePacketReader reader;
+        FrameCollector collector;
+        reader.addListener(static_cast<SR::EyePairListener*>(&collector));
+        for (size_t index = 0; index < loopback.packets.size(); index++)
+            if (index != 5 && index != 6)
+                loopback.deliver(index, reader);
+        checker.expect(reader.getSkippedCount() == 9 && reader.getDecodedCount() == eyePairs.size() - 11 && reader.getRejectedCount() == 0,
+            "lost packets skip the frames until the next key frame, " + std::to_string(reader.getSkippedCount()) + " skipped");
+        checker.expect(matchesWritten(collector.eyePairs, eyePairs, positionTolerance), "no frame is decoded against a lost reference");
+        checker.expect(!collector.eyePairs.empty() && collector.eyePairs[5].frameId == eyePairs[16].frameId, "decoding resumes at the key frame");
+    }
+
+    // A lost right hand leaves the left hand stream alone, and a requested key frame resumes the right one at once
+    {
+        PacketLoopback loopback;
+        SR::SensePacketWriter writer(loopback.getSink(), SR::SensePacketEncoding::Compact, 16);
+        for (size_t i = 0; i < 20; i++) {
+            if (i == 6)
+                writer.requestKeyFrame();
+            writer.accept(handPoses[i]);
+        }
+        SR::SensePacketReader reader;
+        FrameCollector collector;
+        reader.addListener(static_cast<SR::HandPoseListener*>(&collector));
+        for (size_t index = 0; index < loopback.packets.size(); index++)
+            if (index != 3)
+                loopback.deliver(index, reader);
+        checker.expect(reader.getSkippedCount() == 1 && reader.getDecodedCount() == 18, "a lost hand skips only its own stream until the requested key frame");
+        checker.expect(matchesWritten(collector.handPoses, handPoses, positionTolerance), "hand poses after a lost packet decode as written");
+    }
+
+    // The transport delivers the key frame at 16 after the delta that follows it, the reader waits for the key frame at 32
+    {
+        PacketLoopback loopback;
+        SR::SensePacketWriter writer(loopback.getSink(), SR::SensePacketEncoding::Compact, 16);
+        for (const SR_eyePair& frame : eyePairs)
+            writer.accept(frame);
+        SR::SensePacketReader reader;
+        FrameCollector collector;
+        reader.addListener(static_cast<SR::EyePairListener*>(&collector));
+        for (size_t index = 0; index < loopback.packets.size(); index++)
+            loopback.deliver(index == 16 ? 17 : index == 17 ? 16 : index, reader);
+        checker.expect(reader.getSkippedCount() == 15 && reader.getDecodedCount() == eyePairs.size() - 15 && reader.getRejectedCount() == 0,
+            "a late key frame skips the frames until the next one, " + std::to_string(reader.getSkippedCount()) + " skipped");
+        checker.expect(matchesWritten(collector.eyePairs, eyePairs, positionTolerance), "no frame is decoded against a late key frame");
+    }
+}
+
+// Copies every packet a transport delivers, and whether it lay 8 byte aligned
+class PacketRecorder : public SR::Receiver {
+public:
+    void receive(SR_packet& packet) override
+    {
+        const unsigned char* payload = reinterpret_cast<const unsigned char*>(&packet.payload);
+        std::lock_guard<std::mutex> lock(mutex);
+        packets.emplace_back(payload, payload + (packet.size - SR_packet_headerSize));
+        destinations.push_back(packet.destination);
+        aligned = aligned && reinterpret_cast<uintptr_t>(&packet) % 8 == 0;
+        count.store(packets.size(), std::memory_order_release);
+    }
+
+    void print(SR_packet& packet) override
+    {
+        SR_packet_print(packet);
+    }
+
+    bool waitFor(size_t expected) const
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (count.load(std::memory_order_acquire) < expected) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    std::mutex mutex;
+    std::vector<std::vector<unsigned char>> packets;
+    std::vector<uint64_t> destinations;
+    bool aligned = true;
+    std::atomic<size_t> count{ 0 };
+};
+
+// Payload of the packet with this index, every byte depends on both so a shifted or swapped packet shows
+static std::vector<unsigned char> makePayload(size_t index, size_t size)
+{
+    std::vector<unsigned char> payload(size);
+    for (size_t i = 0; i < size; i++)
+        payload[i] = static_cast<unsigned char>(index * 31 + i * 7 + i / 251);
+    return payload;
+}
+
+// Sends packets of these payload sizes with their index as destination
+static void sendPackets(const std::vector<size_t>& sizes, const std::function<void(uint64_t, void*, uint64_t)>& send)
+{
+    for (size_t index = 0; index < sizes.size(); index++) {
+        std::vector<unsigned char> payload = makePayload(index, sizes[index]);
+        send(index, payload.data(), payload.size());
+    }
+}
+
+static void expectPackets(Checker& checker, PacketRecorder& recorder, const std::vector<size_t>& sizes, const std::string& name)
+{
+    checker.expect(recorder.waitFor(sizes.size()), name + " delivers all " + std::to_string(sizes.size()) + " packets, " +
+        std::to_string(recorder.count.load()) + " arrived");
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    size_t intact = 0;
+    for (size_t index = 0; index < sizes.size() && index < recorder.packets.size(); index++)
+        if (recorder.destinations[index] == index && recorder.packets[index] == makePayload(index, sizes[index]))
+            intact++;
+    checker.expect(intact == sizes.size(), name + " keeps the order, size and bytes of every packet, " + std::to_string(intact) + " intact");
+    checker.expect(recorder.aligned, name + " hands out every packet 8 byte aligned");
+}
+
+// Packets of every size modulo 8, empty ones and ones larger than the initial receive buffer are framed and reassembled
+// in both directions, written one by one and coalesced
+static void checkTCPFraming(Checker& checker)
+{
+    std::vector<size_t> sizes;
+    for (int round = 0; round < 3; round++)
+        for (size_t size : { 0, 1, 7, 9, 13, 8, 4095, 65537, 3, 200003, 5, 16 })
+            sizes.push_back(size);
+
+    for (size_t coalesceSize : { 0, 4096 }) {
+        const std::string mode = coalesceSize == 0 ? "TCP" : "coalesced TCP";
+        SR::TCPTransportSettings settings;
+        settings.coalesceSize = coalesceSize;
+        PacketRecorder serverRecorder, clientRecorder;
+        SR::TCPServer server(serverRecorder, settings);
+        SR::TCPConnection client(clientRecorder, settings);
+        if (!server.listen(0, "127.0.0.1") || !client.connect("127.0.0.1", server.getPort())) {
+            checker.expect(false, mode + " connects over loopback");
+            continue;
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (server.getConnectionCount() == 0 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        sendPackets(sizes, [&](uint64_t destination, void* payload, uint64_t payloadSize) { client.send(destination, payload, payloadSize); });
+        client.flush();
+        expectPackets(checker, serverRecorder, sizes, mode + " from the client");
+        sendPackets(sizes, [&](uint64_t destination, void* payload, uint64_t payloadSize) { server.broadcast(destination, payload, payloadSize); });
+        server.flush();
+        expectPackets(checker, clientRecorder, sizes, mode + " from the server");
+        checker.expect(client.getReceiveBufferSize() >= SR_packet_headerSize + 200003, mode + " grows the receive buffer to the largest packet");
+    }
+}
+
+// Records never wrap around the end of a shared memory ring, the rest is skipped with a zero size marker. Sizes up to half
+// of a small ring make every packet land at another position, and both directions deliver every byte in order.
+static void checkSharedMemoryRing(Checker& checker)
+{
+    SR::SharedMemoryTransportSettings settings;
+    settings.ringSize = 4096;
+    const size_t largest = settings.ringSize / 2 - SR_packet_headerSize;
+    // Two of the largest fill the ring exactly, the rest land at changing positions
+    std::vector<size_t> sizes = { largest, largest };
+    for (int round = 0; round < 200; round++)
+        for (size_t size : { size_t(0), size_t(1), size_t(13), size_t(999), largest, size_t(511), size_t(8), size_t(1500), size_t(7) })
+            sizes.push_back(size);
+
+    // Where the records land, as SharedMemoryChannel::send() places them
+    size_t position = 0, markers = 0, exactEnds = 0;
+    for (size_t size : sizes) {
+        const size_t length = (SR_packet_headerSize + size + 7) / 8 * 8;
+        if (position + length > settings.ringSize) {
+            markers++;
+            position = 0;
+        }
+        position += length;
+        if (position == settings.ringSize)
+            exactEnds++;
+        position %= settings.ringSize;
+    }
+    checker.expect(markers > 0 && exactEnds > 0, "the packets wrap the ring with a marker " + std::to_string(markers) +
+        " times and end exactly at its end " + std::to_string(exactEnds) + " times");
+
+    PacketRecorder createdRecorder, openedRecorder;
+    SR::SharedMemoryChannel created(createdRecorder, settings), opened(openedRecorder, settings);
+    const std::string name = SR::SharedMemoryChannel::makeUniqueName();
+    if (!created.create(name) || !opened.open(name)) {
+        checker.expect(false, "a shared memory channel is created and opened");
+        return;
+    }
+    created.unlink();
+
+    sendPackets(sizes, [&](uint64_t destination, void* payload, uint64_t payloadSize) { created.send(destination, payload, payloadSize); });
+    expectPackets(checker, openedRecorder, sizes, "shared memory from the creator");
+    sendPackets(sizes, [&](uint64_t destination, void* payload, uint64_t payloadSize) { opened.send(destination, payload, payloadSize); });
+    expectPackets(checker, createdRecorder, sizes, "shared memory from the opener");
+    checker.expect(created.isActive() && opened.isActive(), "the channel stays open after every wrap");
+
+    bool rejected = false;
+    try {
+        std::vector<unsigned char> payload(largest + 1);
+        created.send(0, payload.data(), payload.size());
+    }
+    catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    checker.expect(rejected, "a packet larger than half of the ring is rejected");
+}
+
+static const struct {
+    const char* name;
+    void (*run)(Checker& checker);
+} knownChecks[] = {
+    { "jitter", checkJitter },
+    { "correction-textures", checkCorrectionTextures },
+    { "sense-packets", checkSensePackets },
+    { "tcp-framing", checkTCPFraming },
+    { "shared-memory-ring", checkSharedMemoryRing },
+};
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: self_check [options]\n"
+        << "  --checks LIST            jitter, correction-textures, sense-packets, tcp-framing and shared-memory-ring (default: all)\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> names;
+    for (const auto& check : knownChecks)
+        names.push_back(check.name);
+
+    Tools::Arguments arguments(argc, argv);
+    while (arguments.next())
+    {
+        bool valid = true;
+        if (arguments.is("--checks", 1)) {
+            names = arguments.getList();
+            for (const std::string& name : names)
+                valid = valid && std::any_of(std::begin(knownChecks), std::end(knownChecks), [&](const auto& check) { return name == check.name; });
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            printUsage();
+            return 1;
+        }
+    }
+
+    int failures = 0;
+    for (const auto& check : knownChecks) {
+        if (std::find(names.begin(), names.end(), check.name) == names.end())
+            continue;
+        Checker checker;
+        check.run(checker);
+        std::cout << check.name << ": " << checker.checks - checker.failures << " of " << checker.checks << " passed" << std::endl;
+        failures += checker.failures;
+    }
+    return failures == 0 ? 0 : 1;
+}
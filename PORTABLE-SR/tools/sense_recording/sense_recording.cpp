@@ -0,0 +1,154 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "common/toolsupport.h"
+#include "sr/sense/core/senserecording.h"
+
+static const char* typeName(SR::SenseRecordType type)
+{
+    switch (type) {
+    case SR::SenseRecordType::EyePair:        return "eye pair";
+    case SR::SenseRecordType::Head:           return "head";
+    case SR::SenseRecordType::HeadPose:       return "head pose";
+    case SR::SenseRecordType::WeaverPosition: return "weaver position";
+    }
+    return "unknown";
+}
+
+static void printPoint(std::ostream& stream, const SR_point3d& point)
+{
+    stream << ' ' << point.x << ' ' << point.y << ' ' << point.z;
+}
+
+// One line per record, eye pairs in the "frameId time lx ly lz rx ry rz" layout read by bench_prediction
+static void printRecord(std::ostream& stream, const SR::SenseRecording& recording, size_t index)
+{
+    switch (recording.getType()) {
+    case SR::SenseRecordType::EyePair: {
+        const SR_eyePair& pair = recording.get<SR_eyePair>(index);
+        stream << pair.frameId << ' ' << pair.time;
+        printPoint(stream, pair.left);
+        printPoint(stream, pair.right);
+        break;
+    }
+    case SR::SenseRecordType::Head: {
+        const SR_head& head = recording.get<SR_head>(index);
+        stream << head.frameId << ' ' << head.time;
+        printPoint(stream, head.headPose.position);
+        printPoint(stream, head.headPose.orientation);
+        printPoint(stream, head.eyes.left);
+        printPoint(stream, head.eyes.right);
+        printPoint(stream, head.ears.left);
+        printPoint(stream, head.ears.right);
+        break;
+    }
+    case SR::SenseRecordType::HeadPose: {
+        const SR_headPose& pose = recording.get<SR_headPose>(index);
+        stream << pose.frameId << ' ' << pose.time;
+        printPoint(stream, pose.position);
+        printPoint(stream, pose.orientation);
+        break;
+    }
+    case SR::SenseRecordType::WeaverPosition: {
+        const SR_weaverPosition& position = recording.get<SR_weaverPosition>(index);
+        stream << position.frameId << ' ' << position.time;
+        printPoint(stream, position.weaverPosition);
+        break;
+    }
+    }
+    stream << '\n';
+}
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: sense_recording info RECORDING\n"
+        << "       sense_recording dump RECORDING [--from TIME] [--to TIME]\n"
+        << "       sense_recording import TRACE RECORDING\n"
+        << "  info     Prints the type, record count and time range\n"
+        << "  dump     Prints the records from TIME up to TIME in microseconds since epoch as text\n"
+        << "  import   Converts a text trace with one \"frameId time lx ly lz rx ry rz\" line per eye pair into a recording\n";
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    const std::string command = argv[1];
+
+    if (command == "import" && argc == 4) {
+        std::ifstream trace(argv[2]);
+        SR::SenseRecordWriter writer;
+        if (!trace || !writer.open(argv[3], SR::SenseRecordType::EyePair, false)) {
+            std::cerr << "Failed to open " << (trace ? argv[3] : argv[2]) << std::endl;
+            return 1;
+        }
+        std::string line;
+        size_t count = 0;
+        while (std::getline(trace, line)) {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream stream(line);
+            SR_eyePair pair = {};
+            if (!(stream >> pair.frameId >> pair.time >> pair.left.x >> pair.left.y >> pair.left.z >> pair.right.x >> pair.right.y >> pair.right.z) ||
+                !writer.write(pair)) {
+                std::cerr << "Invalid or out of order eye pair: " << line << std::endl;
+                return 1;
+            }
+            count++;
+        }
+        writer.close();
+        std::cout << "Imported " << count << " eye pairs" << std::endl;
+        return 0;
+    }
+
+    SR::SenseRecording recording;
+    if ((command != "info" && command != "dump") || !recording.open(argv[2])) {
+        if (command == "info" || command == "dump")
+            std::cerr << "Failed to open " << argv[2] << " as a recording" << std::endl;
+        else
+            printUsage();
+        return 1;
+    }
+
+    if (command == "info") {
+        std::cout << typeName(recording.getType()) << " recording, " << recording.size() << " records";
+        if (recording.size() > 0) {
+            const uint64_t first = recording.getTime(0);
+            const uint64_t last = recording.getTime(recording.size() - 1);
+            std::cout << " from " << first << " to " << last << " us, " << std::fixed << std::setprecision(1)
+                      << static_cast<double>(last - first) * 1.0e-6 << " s";
+        }
+        std::cout << std::endl;
+        return 0;
+    }
+
+    uint64_t from = 0;
+    uint64_t to = UINT64_MAX;
+    Tools::Arguments arguments(argc, argv, 3);
+    while (arguments.next()) {
+        if (arguments.is("--from", 1)) {
+            from = arguments.getUnsigned();
+        } else if (arguments.is("--to", 1)) {
+            to = arguments.getUnsigned();
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    // Enough digits for every double to read back unchanged, so a dump imports into the same recording
+    std::cout << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (size_t i = recording.seek(from); i < recording.size() && recording.getTime(i) <= to; i++)
+        printRecord(std::cout, recording, i);
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "common/toolsupport.h"
+#include "sr/utility/eyetrajectory.h"
+#include "sr/weaver/latencysimulation.h"
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: simulate_latency [options]\n"
+        << "  --refresh HZ               Vsync rate (default: 60)\n"
+        << "  --pipeline FRAMES          Vsyncs from weave() until the frame is visible (default: 2)\n"
+        << "  --latency FRAMES           Value passed to setLatencyInFrames() (default: the pipeline depth)\n"
+        << "  --sweep                    Simulate every latency from 0 to the pipeline depth plus 2\n"
+        << "  --render-offset FRAMES     Time from vsync to the weave() call (default: 0.25)\n"
+        << "  --lead FRAMES              Time from the late latch until the frame is visible (default: 0.5)\n"
+        << "  --tracker RATE LATENCY_MS  Tracker samples per second and capture to availability latency (default: 60 30)\n"
+        << "  --noise MM                 Tracker noise standard deviation (default: 0)\n"
+        << "  --predictor MODEL          cv, ca, kalman or one-euro (default: cv)\n"
+        << "  --window SAMPLES           Samples fitted by cv and ca (default: 2 for cv, 3 for ca)\n"
+        << "  --kalman Q R               Kalman acceleration noise in mm^2/s^3 and sample noise in mm (default: 1e6 1)\n"
+        << "  --one-euro MIN BETA DCUT   One-Euro cutoff in Hz, speed coefficient and velocity cutoff in Hz (default: 1 0.01 1)\n"
+        << "  --sway AMPLITUDE_MM HZ     Side to side sway at 600 mm (default: 100 0.5)\n"
+        << "  --trajectory FILE          Keyframes, one \"time x y z\" line each, instead of the sway\n"
+        << "  --duration SECONDS         Length of the sway (default: 20)\n";
+}
+
+int main(int argc, char** argv)
+{
+    SR::LatencySimulationSettings settings;
+    bool latencySet = false;
+    bool sweep = false;
+    bool windowSet = false;
+    float amplitude = 100.0f;
+    double frequency = 0.5;
+    double duration = 20.0;
+    std::string trajectoryPath;
+
+    Tools::Arguments arguments(argc, argv);
+    while (arguments.next())
+    {
+        if (arguments.is("--refresh", 1)) {
+            settings.refreshRate = arguments.getDouble();
+        } else if (arguments.is("--pipeline", 1)) {
+            settings.pipelineFrames = arguments.getUnsigned();
+        } else if (arguments.is("--latency", 1)) {
+            settings.latencyInFrames = arguments.getUnsigned();
+            latencySet = true;
+        } else if (arguments.is("--sweep")) {
+            sweep = true;
+        } else if (arguments.is("--render-offset", 1)) {
+            settings.renderOffset = arguments.getDouble();
+        } else if (arguments.is("--lead", 1)) {
+            settings.lateLatchLead = arguments.getDouble();
+        } else if (arguments.is("--tracker", 2)) {
+            settings.trackerRate = arguments.getDouble();
+            settings.trackerLatency = arguments.getDouble() / 1000.0;
+        } else if (arguments.is("--noise", 1)) {
+            settings.trackerNoise = arguments.getFloat();
+        } else if (arguments.is("--predictor", 1)) {
+            const std::string model = arguments.getString();
+            if (model == "cv") {
+                settings.predictor.model = SR::EyePredictorModel::ConstantVelocity;
+            } else if (model == "ca") {
+                settings.predictor.model = SR::EyePredictorModel::ConstantAcceleration;
+            } else if (model == "kalman") {
+                settings.predictor.model = SR::EyePredictorModel::Kalman;
+            } else if (model == "one-euro") {
+                settings.predictor.model = SR::EyePredictorModel::OneEuro;
+            } else {
+                printUsage();
+                return 1;
+            }
+        } else if (arguments.is("--window", 1)) {
+            settings.predictor.window = arguments.getUnsigned();
+            windowSet = true;
+        } else if (arguments.is("--kalman", 2)) {
+            settings.predictor.processNoise = arguments.getDouble();
+            settings.predictor.measurementNoise = arguments.getDouble();
+        } else if (arguments.is("--one-euro", 3)) {
+            settings.predictor.minimumCutoff = arguments.getDouble();
+            settings.predictor.beta = arguments.getDouble();
+            settings.predictor.derivativeCutoff = arguments.getDouble();
+        } else if (arguments.is("--sway", 2)) {
+            amplitude = arguments.getFloat();
+            frequency = arguments.getDouble();
+        } else if (arguments.is("--trajectory", 1)) {
+            trajectoryPath = arguments.getString();
+        } else if (arguments.is("--duration", 1)) {
+            duration = arguments.getDouble();
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (!windowSet && settings.predictor.model == SR::EyePredictorModel::ConstantAcceleration)
+        settings.predictor.window = 3;
+
+    SR::EyeTrajectory trajectory;
+    if (!trajectoryPath.empty()) {
+        if (!SR::EyeTrajectory::load(trajectoryPath, trajectory)) {
+            std::cerr << "Failed to read " << trajectoryPath << std::endl;
+            return 1;
+        }
+    } else {
+        const float center[3] = { 0.0f, 100.0f, 600.0f };
+        trajectory = SR::EyeTrajectory::sway(center, amplitude, frequency, duration);
+    }
+
+    uint64_t first = latencySet ? settings.latencyInFrames : settings.pipelineFrames;
+    uint64_t last = first;
+    if (sweep) {
+        first = 0;
+        last = settings.pipelineFrames + 2;
+    }
+
+    std::cout << "Photon-time eye position error in mm, " << settings.refreshRate << " Hz, pipeline of " << settings.pipelineFrames << " frames\n";
+    std::cout << std::setw(8) << "latency" << " |" << std::setw(9) << "rms" << std::setw(9) << "p95" << std::setw(9) << "max"
+              << std::setw(11) << "horizon" << " | late latching:" << std::setw(9) << "rms" << std::setw(9) << "p95" << std::setw(9) << "max"
+              << std::setw(11) << "horizon" << "\n";
+    std::cout << std::fixed;
+    try {
+        for (uint64_t latency = first; latency <= last; latency++) {
+            settings.latencyInFrames = latency;
+            const SR::LatencySimulationResult plain = SR::simulateLatency(settings, trajectory, false);
+            const SR::LatencySimulationResult latched = SR::simulateLatency(settings, trajectory, true);
+            std::cout << std::setw(8) << latency << " |" << std::setprecision(2)
+                      << std::setw(9) << plain.rmsError << std::setw(9) << plain.percentile95Error << std::setw(9) << plain.maximumError
+                      << std::setprecision(1) << std::setw(8) << plain.meanHorizon * 1000.0 << " ms |" << std::setw(15) << "" << std::setprecision(2)
+                      << std::setw(9) << latched.rmsError << std::setw(9) << latched.percentile95Error << std::setw(9) << latched.maximumError
+                      << std::setprecision(1) << std::setw(8) << latched.meanHorizon * 1000.0 << " ms\n";
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
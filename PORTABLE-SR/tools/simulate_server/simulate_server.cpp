@@ -0,0 +1,440 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/toolsupport.h"
+#include "sr/network/core/sensepackets.h"
+#include "sr/network/core/sharedmemorytransport.h"
+#include "sr/network/core/tcptransport.h"
+#include "sr/sense/core/sensesimulator.h"
+#include "sr/sense/core/streamstatistics.h"
+#include "sr/utility/eyetrajectory.h"
+
+static uint64_t now()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// Turns every head frame into a left and a right hand held in front of the user, for streams without a hand tracker
+class HandSynthesizer : public SR::HeadListener {
+public:
+    explicit HandSynthesizer(SR::HandPoseListener& listener) : listener(listener) {}
+
+    void accept(const SR_head& head) override
+    {
+        for (uint64_t side = 0; side < 2; side++) {
+            SR_handPose hand = {};
+            hand.frameId = head.frameId;
+            hand.time = head.time;
+            hand.handId = side;
+            hand.side = static_cast<SR_handSide>(side);
+            const double mirror = side == 0 ? -1.0 : 1.0;
+            const double wrist[3] = { head.headPose.position.x + mirror * 180.0, head.headPose.position.y - 250.0, head.headPose.position.z - 250.0 };
+            // An open hand pointing up, the thumb towards the other hand
+            auto place = [&](int joint, double x, double y) {
+                hand.joints[joint] = { wrist[0] + mirror * x, wrist[1] + y, wrist[2] };
+            };
+            place(Wrist, 0.0, 0.0);
+            place(Palm, 0.0, 40.0);
+            for (int i = 0; i < 3; i++)
+                place(Thumb_Metacarpal + i, -30.0 - 15.0 * i, 30.0 + 15.0 * i);
+            for (int finger = 0; finger < 4; finger++)
+                for (int i = 0; i < 4; i++)
+                    place(Index_Metacarpal + 4 * finger + i, -20.0 + 15.0 * finger, 80.0 + 25.0 * i);
+            listener.accept(hand);
+        }
+    }
+
+private:
+    SR::HandPoseListener& listener;
+};
+
+// Shared by all load clients, measures from the time stamped on a frame to its arrival at a client
+class LatencyListener : public SR::EyePairListener, public SR::HeadListener, public SR::HandPoseListener, public SR::SystemEventListener {
+public:
+    void accept(const SR_eyePair& frame) override { record(frame.time); }
+    void accept(const SR_head& frame) override { record(frame.time); }
+    void accept(const SR_handPose& frame) override { record(frame.time); }
+    void accept(const SR::SystemEvent& frame) override { record(frame.time); }
+
+    SR::DurationHistogram interval;
+    SR::DurationHistogram total;
+
+private:
+    void record(uint64_t time)
+    {
+        const uint64_t arrival = now();
+        const uint64_t nanoseconds = arrival > time ? (arrival - time) * 1000 : 0;
+        interval.record(nanoseconds);
+        total.record(nanoseconds);
+    }
+};
+
+// Decodes the packets of one load client and counts what arrived
+class ClientReceiver : public SR::SensePacketReader {
+public:
+    void receive(SR_packet& packet) override
+    {
+        packets.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(packet.size, std::memory_order_relaxed);
+        SR::SensePacketReader::receive(packet);
+    }
+
+    std::atomic<uint64_t> packets{ 0 };
+    std::atomic<uint64_t> bytes{ 0 };
+};
+
+// A client that reconnects like an application in a non-blocking client mode: a few attempts with a growing back-off
+struct Client {
+    ClientReceiver receiver;
+    std::unique_ptr<SR::TCPConnection> connection;
+
+    bool connect(const std::string& host, uint16_t port, const SR::TCPTransportSettings& settings, SR::SensePacketEncoding encoding,
+        uint64_t& failures)
+    {
+        connection.reset();
+        for (int attempt = 0; attempt < 5; attempt++) {
+            if (attempt > 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10 << attempt));
+            connection.reset(new SR::TCPConnection(receiver, settings));
+            if (connection->connect(host, port)) {
+                if (encoding != SR::SensePacketEncoding::Raw)
+                    SR::SensePacketReader::requestEncoding(*connection, encoding);
+                return true;
+            }
+            failures++;
+        }
+        connection.reset();
+        return false;
+    }
+};
+
+struct Report
+{
+    double time;             //!< Seconds since the start
+    size_t clients;          //!< Connections of the server, or connected load clients without a server
+    double sentPerSecond;    //!< Frames the server sent, each to every client
+    double receivedPerSecond;
+    double megabytesPerSecond;
+    double p50;              //!< Microseconds from the frame time to the arrival at a load client
+    double p99;
+    uint64_t reconnects;
+    uint64_t failures;
+};
+
+static void writeJSON(std::ostream& stream, const std::vector<Report>& reports)
+{
+    stream << "{\n";
+    stream << "  \"results\": [\n";
+    for (size_t i = 0; i < reports.size(); i++) {
+        const Report& r = reports[i];
+        stream << "    { \"time\": " << r.time << ", \"clients\": " << r.clients << ", \"sentPerSecond\": " << r.sentPerSecond
+               << ", \"receivedPerSecond\": " << r.receivedPerSecond << ", \"megabytesPerSecond\": " << r.megabytesPerSecond
+               << ", \"p50\": " << r.p50 << ", \"p99\": " << r.p99 << ", \"reconnects\": " << r.reconnects
+               << ", \"failures\": " << r.failures << " }" << (i + 1 < reports.size() ? "," : "") << "\n";
+    }
+    stream << "  ]\n}\n";
+}
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: simulate_server [options]\n"
+        << "  --port PORT              Port to accept clients on, 0 picks a free one (default: 7100)\n"
+        << "  --connect HOST           Run only the load clients, against the server on HOST and --port\n"
+        << "  --senses LIST            eyes, head, hands and events (default: eyes,head,hands,events)\n"
+        << "  --rate HZ                Tracker frames per second (default: 120)\n"
+        << "  --event-period SECONDS   Alternate user lost and found events, 0 sends none (default: 5)\n"
+        << "  --payload BYTES          Pad every packet payload to at least BYTES, clients then get raw frames\n"
+        << "  --encoding NAME          raw or compact, the encoding load clients ask for (default: raw)\n"
+        << "  --load N                 In-process clients that decode the stream and measure latency (default: 0)\n"
+        << "  --churn SECONDS          Reconnect one load client after the other every SECONDS\n"
+        << "  --shared-memory          Let loopback clients switch to shared memory\n"
+        << "  --coalesce BYTES         Bytes collected per TCP write, 0 writes every packet (default: 0)\n"
+        << "  --duration SECONDS       Stop after SECONDS, 0 runs until killed (default: 0)\n"
+        << "  --report SECONDS         Print throughput and latency every SECONDS (default: 1)\n"
+        << "  --json FILE              Write the reports as JSON\n";
+}
+
+int main(int argc, char** argv)
+{
+    uint16_t port = 7100;
+    std::string host;
+    std::vector<std::string> senses = { "eyes", "head", "hands", "events" };
+    SR::SenseSimulatorSettings simulatorSettings;
+    simulatorSettings.rate = 120.0;
+    simulatorSettings.loop = true;
+    double eventPeriod = 5.0;
+    uint64_t payloadSize = 0;
+    size_t load = 0;
+    SR::SensePacketEncoding encoding = SR::SensePacketEncoding::Raw;
+    double churnPeriod = 0.0;
+    SR::TCPTransportSettings settings;
+    double duration = 0.0;
+    double reportPeriod = 1.0;
+    std::string jsonPath;
+
+    Tools::Arguments arguments(argc, argv);
+    while (arguments.next())
+    {
+        bool valid = true;
+        if (arguments.is("--port", 1)) {
+            const uint64_t value = arguments.getUnsigned();
+            port = static_cast<uint16_t>(value);
+            valid = value <= 65535;
+        } else if (arguments.is("--connect", 1)) {
+            host = arguments.getString();
+        } else if (arguments.is("--senses", 1)) {
+            senses = arguments.getList();
+            for (const std::string& sense : senses)
+                valid = valid && (sense == "eyes" || sense == "head" || sense == "hands" || sense == "events");
+        } else if (arguments.is("--rate", 1)) {
+            simulatorSettings.rate = arguments.getDouble();
+            valid = simulatorSettings.rate > 0.0;
+        } else if (arguments.is("--event-period", 1)) {
+            eventPeriod = arguments.getDouble();
+        } else if (arguments.is("--payload", 1)) {
+            payloadSize = arguments.getUnsigned();
+        } else if (arguments.is("--encoding", 1)) {
+            const std::string name = arguments.getString();
+            encoding = name == "compact" ? SR::SensePacketEncoding::Compact : SR::SensePacketEncoding::Raw;
+            valid = name == "raw" || name == "compact";
+        } else if (arguments.is("--load", 1)) {
+            load = arguments.getUnsigned();
+        } else if (arguments.is("--churn", 1)) {
+            churnPeriod = arguments.getDouble();
+        } else if (arguments.is("--shared-memory")) {
+            settings.sharedMemoryRingSize = SR::SharedMemoryTransportSettings().ringSize;
+        } else if (arguments.is("--coalesce", 1)) {
+            settings.coalesceSize = arguments.getUnsigned();
+        } else if (arguments.is("--duration", 1)) {
+            duration = arguments.getDouble();
+        } else if (arguments.is("--report", 1)) {
+            reportPeriod = arguments.getDouble();
+            valid = reportPeriod > 0.0;
+        } else if (arguments.is("--json", 1)) {
+            jsonPath = arguments.getString();
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            printUsage();
+            return 1;
+        }
+    }
+    if (!host.empty() && (load == 0 || port == 0)) {
+        std::cerr << "--connect needs --load and a port" << std::endl;
+        return 1;
+    }
+    auto hasSense = [&](const char* sense) { return std::find(senses.begin(), senses.end(), sense) != senses.end(); };
+
+    // The server receives nothing from its clients, only the stream it publishes matters
+    SR::SensePacketReader serverReceiver;
+    std::unique_ptr<SR::TCPServer> server;
+    std::unique_ptr<SR::SenseSimulator> simulator;
+    std::unique_ptr<SR::SensePacketPublisher> publisher;
+    std::unique_ptr<SR::SensePacketWriter> writer;
+    std::unique_ptr<HandSynthesizer> hands;
+    SR::SystemEventListener* events = nullptr;
+    std::function<uint64_t()> getSentCount = [] { return uint64_t(0); };
+    std::mutex paddingMutex;
+    std::vector<uint64_t> padding(static_cast<size_t>(payloadSize / 8 + 1));
+
+    if (host.empty()) {
+        server.reset(new SR::TCPServer(serverReceiver, settings));
+        if (!server->listen(port)) {
+            std::cerr << "Failed to listen on port " << port << std::endl;
+            return 1;
+        }
+        port = server->getPort();
+        host = "127.0.0.1";
+        std::cout << "Listening on port " << port << std::endl;
+
+        const float center[3] = { 0.0f, 100.0f, 600.0f };
+        simulator.reset(new SR::SenseSimulator(SR::EyeTrajectory::sway(center, 100.0f, 0.5, 10.0), simulatorSettings));
+        // The publisher and the writer listen to every sense
+        auto attach = [&](auto& target) {
+            if (hasSense("eyes"))
+                simulator->addListener(static_cast<SR::EyePairListener*>(&target));
+            if (hasSense("head"))
+                simulator->addListener(static_cast<SR::HeadListener*>(&target));
+            if (hasSense("hands")) {
+                hands.reset(new HandSynthesizer(target));
+                simulator->addListener(hands.get());
+            }
+            events = &target;
+            getSentCount = [&target] { return target.getSentCount(); };
+        };
+
+        if (payloadSize == 0) {
+            // Every client gets the encoding it asks for
+            publisher.reset(new SR::SensePacketPublisher(*server));
+            attach(*publisher);
+        } else {
+            SR::TCPServer& target = *server;
+            writer.reset(new SR::SensePacketWriter([&](uint64_t destination, void* payload, uint64_t size) {
+                if (size >= payloadSize) {
+                    target.broadcast(destination, payload, size);
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(paddingMutex);
+                std::memcpy(padding.data(), payload, static_cast<size_t>(size));
+                std::memset(reinterpret_cast<unsigned char*>(padding.data()) + size, 0, static_cast<size_t>(payloadSize - size));
+                target.broadcast(destination, padding.data(), payloadSize);
+            }));
+            attach(*writer);
+        }
+    }
+
+    LatencyListener latency;
+    std::vector<std::unique_ptr<Client>> clients;
+    uint64_t reconnects = 0, failures = 0;
+    for (size_t i = 0; i < load; i++) {
+        clients.emplace_back(new Client());
+        ClientReceiver& receiver = clients.back()->receiver;
+        receiver.addListener(static_cast<SR::EyePairListener*>(&latency));
+        receiver.addListener(static_cast<SR::HeadListener*>(&latency));
+        receiver.addListener(static_cast<SR::HandPoseListener*>(&latency));
+        receiver.addListener(static_cast<SR::SystemEventListener*>(&latency));
+        if (!clients.back()->connect(host, port, settings, encoding, failures)) {
+            std::cerr << "Load client " << i << " failed to connect to " << host << ":" << port << std::endl;
+            return 1;
+        }
+    }
+    // Frames only count once every load client is there to receive them
+    const auto connectDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (server && server->getConnectionCount() < load && std::chrono::steady_clock::now() < connectDeadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    if (simulator)
+        simulator->start();
+
+    std::cout << std::right << std::setw(8) << "time s" << std::setw(9) << "clients" << std::setw(11) << "sent/s" << std::setw(12)
+              << "received/s" << std::setw(10) << "MB/s" << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(12)
+              << "reconnects" << std::setw(10) << "failures" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    Clock::time_point nextReport = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(reportPeriod));
+    Clock::time_point nextEvent = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(eventPeriod));
+    Clock::time_point nextChurn = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(churnPeriod));
+    Clock::time_point lastReport = start;
+    uint64_t lastSent = 0, lastPackets = 0, lastBytes = 0;
+    bool userFound = true;
+    size_t churnIndex = 0;
+    std::vector<Report> reports;
+
+    auto countReceived = [&](uint64_t& packets, uint64_t& bytes) {
+        packets = bytes = 0;
+        for (const std::unique_ptr<Client>& client : clients) {
+            packets += client->receiver.packets.load(std::memory_order_relaxed);
+            bytes += client->receiver.bytes.load(std::memory_order_relaxed);
+        }
+    };
+
+    while (true) {
+        const Clock::time_point current = Clock::now();
+        const bool finished = duration > 0.0 && current - start >= std::chrono::duration<double>(duration);
+
+        if (events && hasSense("events") && eventPeriod > 0.0 && current >= nextEvent) {
+            userFound = !userFound;
+            SR::SystemEvent event;
+            event.time = now();
+            event.eventType = userFound ? SR_eventType::UserFound : SR_eventType::UserLost;
+            event.message = userFound ? "User found" : "User lost";
+            events->accept(event);
+            nextEvent += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(eventPeriod));
+        }
+
+        if (!clients.empty() && churnPeriod > 0.0 && current >= nextChurn) {
+            Client& client = *clients[churnIndex++ % clients.size()];
+            reconnects++;
+            client.connect(host, port, settings, encoding, failures);
+            nextChurn += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(churnPeriod));
+        }
+
+        if (current >= nextReport || finished) {
+            const double seconds = std::chrono::duration<double>(current - lastReport).count();
+            const uint64_t sent = getSentCount();
+            uint64_t packets, bytes;
+            countReceived(packets, bytes);
+            const SR::DurationHistogram::Summary summary = latency.interval.getSummary();
+            latency.interval.reset();
+
+            Report report;
+            report.time = std::chrono::duration<double>(current - start).count();
+            report.clients = server ? server->getConnectionCount()
+                                     : static_cast<size_t>(std::count_if(clients.begin(), clients.end(), [](const std::unique_ptr<Client>& client) {
+                                           return client->connection && client->connection->isActive();
+                                       }));
+            report.sentPerSecond = static_cast<double>(sent - lastSent) / seconds;
+            report.receivedPerSecond = static_cast<double>(packets - lastPackets) / seconds;
+            report.megabytesPerSecond = static_cast<double>(bytes - lastBytes) / seconds / 1e6;
+            report.p50 = summary.p50;
+            report.p99 = summary.p99;
+            report.reconnects = reconnects;
+            report.failures = failures;
+            reports.push_back(report);
+            std::cout << std::fixed << std::setprecision(1) << std::setw(8) << report.time << std::setw(9) << report.clients
+                      << std::setprecision(0) << std::setw(11) << report.sentPerSecond << std::setw(12) << report.receivedPerSecond
+                      << std::setprecision(2) << std::setw(10) << report.megabytesPerSecond << std::setprecision(1) << std::setw(10)
+                      << report.p50 << std::setw(10) << report.p99 << std::setw(12) << reconnects << std::setw(10) << failures << std::endl;
+
+            lastReport = current;
+            lastSent = sent;
+            lastPackets = packets;
+            lastBytes = bytes;
+            nextReport += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(reportPeriod));
+        }
+        if (finished)
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (simulator)
+        simulator->stop();
+    if (server)
+        server->flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    uint64_t packets, bytes, decoded = 0, skipped = 0, rejected = 0;
+    countReceived(packets, bytes);
+    for (const std::unique_ptr<Client>& client : clients) {
+        decoded += client->receiver.getDecodedCount();
+        skipped += client->receiver.getSkippedCount();
+        rejected += client->receiver.getRejectedCount();
+    }
+    const SR::DurationHistogram::Summary summary = latency.total.getSummary();
+    std::cout << "Sent " << getSentCount() << " frames, load clients received " << packets << " packets of "
+              << std::setprecision(1) << (packets > 0 ? static_cast<double>(bytes) / static_cast<double>(packets) : 0.0)
+              << " bytes on average, decoded " << decoded << ", skipped " << skipped << ", rejected " << rejected << ", latency p50 "
+              << summary.p50 << " us, p99 " << summary.p99 << " us, max " << summary.maximum << " us" << std::endl;
+
+    if (!jsonPath.empty()) {
+        std::ofstream file(jsonPath);
+        file << std::setprecision(6);
+        writeJSON(file, reports);
+        if (!file) {
+            std::cerr << "Failed to write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+    // A stream that a client could not decode, or load clients that got nothing, fail end-to-end runs
+    return rejected == 0 && (clients.empty() || decoded > 0) ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/toolsupport.h"
+#include "sr/sense/core/asynclistener.h"
+#include "sr/sense/core/latestvalue.h"
+#include "sr/sense/core/senserecording.h"
+#include "sr/sense/core/sensesimulator.h"
+#include "sr/sense/core/streamstatistics.h"
+#include "sr/utility/eyetrajectory.h"
+
+// Collects the intervals between frames, measured on the steady clock when they arrive
+class IntervalListener : public SR::EyePairListener {
+public:
+    void accept(const SR_eyePair&) override
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (count++ > 0)
+            intervals.push_back(std::chrono::duration<double, std::micro>(now - previous).count());
+        previous = now;
+    }
+
+    uint64_t count = 0;
+    std::vector<double> intervals;
+    std::chrono::steady_clock::time_point previous;
+};
+
+// Stands in for a listener that takes long, e.g. a UI that redraws on every frame
+class SlowListener : public SR::EyePairListener {
+public:
+    explicit SlowListener(double milliseconds) : duration(std::chrono::duration<double, std::milli>(milliseconds)) {}
+
+    void accept(const SR_eyePair&) override
+    {
+        std::this_thread::sleep_for(duration);
+    }
+
+    std::chrono::duration<double, std::milli> duration;
+};
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: simulate_tracker [options]\n"
+        << "  --sway AMPLITUDE_MM HZ     Side to side sway at 600 mm (default: 100 0.5)\n"
+        << "  --random-walk MM SEED      Random movement with this standard deviation per axis\n"
+        << "  --step X Y Z X Y Z TIME    Jump from one position to another after TIME seconds\n"
+        << "  --trajectory FILE          Keyframes, one \"time x y z\" line each\n"
+        << "  --recording FILE           Replay an eye pair or head recording with its own timing\n"
+        << "  --rate HZ                  Frames per second of trajectories (default: 60)\n"
+        << "  --duration SECONDS         Length of generated trajectories (default: 10)\n"
+        << "  --realtime                 Emit frames on a thread in real time instead of on a simulated clock\n"
+        << "  --record FILE              Record the emitted eye pairs\n"
+        << "  --slow-listener MS         Add a listener that takes MS milliseconds per frame\n"
+        << "  --async POLICY             Dispatch to the slow listener on its own thread, drop-oldest or backpressure\n"
+        << "  --render HZ                With --realtime, poll the newest eye pair from a render thread at HZ\n"
+        << "  --stats SECONDS            Print latency, jitter and listener statistics of the listeners every SECONDS\n";
+}
+
+int main(int argc, char** argv)
+{
+    SR::SenseSimulatorSettings settings;
+    settings.simulatedClock = true;
+    std::string source = "sway";
+    float amplitude = 100.0f, deviation = 0.0f;
+    double frequency = 0.5, stepTime = 0.0;
+    double duration = 10.0;
+    uint32_t seed = 1;
+    float from[3] = {}, to[3] = {};
+    std::string path, recordPath;
+    double slowMilliseconds = 0.0;
+    bool async = false;
+    SR::OverflowPolicy policy = SR::OverflowPolicy::DropOldest;
+    double renderRate = 0.0;
+    double statsPeriod = 0.0;
+
+    Tools::Arguments arguments(argc, argv);
+    while (arguments.next())
+    {
+        if (arguments.is("--sway", 2)) {
+            source = "sway";
+            amplitude = arguments.getFloat();
+            frequency = arguments.getDouble();
+        } else if (arguments.is("--random-walk", 2)) {
+            source = "random-walk";
+            deviation = arguments.getFloat();
+            seed = static_cast<uint32_t>(arguments.getUnsigned());
+        } else if (arguments.is("--step", 7)) {
+            source = "step";
+            for (float& value : from)
+                value = arguments.getFloat();
+            for (float& value : to)
+                value = arguments.getFloat();
+            stepTime = arguments.getDouble();
+        } else if (arguments.is("--trajectory", 1)) {
+            source = "trajectory";
+            path = arguments.getString();
+        } else if (arguments.is("--recording", 1)) {
+            source = "recording";
+            path = arguments.getString();
+        } else if (arguments.is("--rate", 1)) {
+            settings.rate = arguments.getDouble();
+        } else if (arguments.is("--duration", 1)) {
+            duration = arguments.getDouble();
+        } else if (arguments.is("--realtime")) {
+            settings.simulatedClock = false;
+        } else if (arguments.is("--record", 1)) {
+            recordPath = arguments.getString();
+        } else if (arguments.is("--slow-listener", 1)) {
+            slowMilliseconds = arguments.getDouble();
+        } else if (arguments.is("--async", 1) && (arguments.peek() == "drop-oldest" || arguments.peek() == "backpressure")) {
+            async = true;
+            policy = std::string(arguments.getString()) == "backpressure" ? SR::OverflowPolicy::Backpressure : SR::OverflowPolicy::DropOldest;
+        } else if (arguments.is("--stats", 1)) {
+            statsPeriod = arguments.getDouble();
+        } else if (arguments.is("--render", 1)) {
+            renderRate = arguments.getDouble();
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::unique_ptr<SR::SenseSimulator> simulator;
+    try {
+        const float center[3] = { 0.0f, 100.0f, 600.0f };
+        if (source == "recording") {
+            SR::SenseRecording recording;
+            if (!recording.open(path)) {
+                std::cerr << "Failed to open " << path << " as a recording" << std::endl;
+                return 1;
+            }
+            simulator.reset(new SR::SenseSimulator(std::move(recording), settings));
+        } else {
+            SR::EyeTrajectory trajectory;
+            if (source == "trajectory" && !SR::EyeTrajectory::load(path, trajectory)) {
+                std::cerr << "Failed to read " << path << std::endl;
+                return 1;
+            }
+            if (source == "sway")
+                trajectory = SR::EyeTrajectory::sway(center, amplitude, frequency, duration);
+            else if (source == "random-walk")
+                trajectory = SR::EyeTrajectory::randomWalk(center, deviation, duration, seed);
+            else if (source == "step")
+                trajectory = SR::EyeTrajectory::step(from, to, stepTime, duration);
+            simulator.reset(new SR::SenseSimulator(std::move(trajectory), settings));
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    SR::EyePairRecorder recorder;
+    if (!recordPath.empty()) {
+        if (!recorder.open(recordPath, false)) {
+            std::cerr << "Failed to write " << recordPath << std::endl;
+            return 1;
+        }
+        simulator->addListener(&recorder);
+    }
+    std::unique_ptr<SR::StreamStatisticsReporter> reporter;
+    if (statsPeriod > 0.0)
+        reporter.reset(new SR::StreamStatisticsReporter(std::chrono::milliseconds(std::llround(statsPeriod * 1000.0)),
+            [](const std::string& line) { std::cout << line << std::endl; }));
+
+    // With --stats the slow listener is measured behind the queue, so its latency includes the time frames wait there
+    SlowListener slow(slowMilliseconds);
+    SR::InstrumentedEyePairListener instrumentedSlow(slow);
+    SR::EyePairListener* slowListener = reporter ? static_cast<SR::EyePairListener*>(&instrumentedSlow) : &slow;
+    std::unique_ptr<SR::AsyncEyePairListener> asyncSlow;
+    if (slowMilliseconds > 0.0) {
+        if (async) {
+            asyncSlow.reset(new SR::AsyncEyePairListener(*slowListener, 16, policy));
+            simulator->addListener(asyncSlow.get());
+        } else {
+            simulator->addListener(slowListener);
+        }
+        if (reporter)
+            reporter->add("slow listener", instrumentedSlow);
+    }
+    IntervalListener intervals;
+    SR::InstrumentedEyePairListener instrumentedIntervals(intervals);
+    SR::EyePairListener* intervalListener = reporter ? static_cast<SR::EyePairListener*>(&instrumentedIntervals) : &intervals;
+    simulator->addListener(intervalListener);
+    if (reporter)
+        reporter->add("eye pairs", instrumentedIntervals);
+    SR::LatestEyePair latest;
+    simulator->addListener(&latest);
+
+    // Timed up to the last frame of the source, the render thread and the listeners wind down afterwards
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point end;
+    if (settings.simulatedClock) {
+        while (simulator->advance(1000)) {
+        }
+        end = std::chrono::steady_clock::now();
+    } else {
+        simulator->start();
+        // Stands in for a render loop that reads the eye positions once per frame
+        std::atomic<bool> rendering{ renderRate > 0.0 };
+        uint64_t renders = 0, newFrames = 0;
+        double readNanoseconds = 0.0;
+        std::thread render([&] {
+            uint64_t version = 0;
+            std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+            while (rendering.load()) {
+                const std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+                SR_eyePair pair;
+                if (latest.get(pair) && latest.getVersion() != version) {
+                    version = latest.getVersion();
+                    newFrames++;
+                }
+                readNanoseconds += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - before).count();
+                renders++;
+                next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / renderRate));
+                std::this_thread::sleep_until(next);
+            }
+        });
+        simulator->wait();
+        end = std::chrono::steady_clock::now();
+        simulator->stop();
+        rendering.store(false);
+        render.join();
+        if (renders > 0)
+            std::cout << "Render thread read " << renders << " times, " << newFrames << " with a new eye pair, " << std::fixed
+                      << std::setprecision(0) << readNanoseconds / static_cast<double>(renders) << " ns per read" << std::endl;
+    }
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    simulator->removeListener(intervalListener);
+    simulator->removeListener(&latest);
+    if (asyncSlow)
+        simulator->removeListener(asyncSlow.get());
+    else if (slowMilliseconds > 0.0)
+        simulator->removeListener(slowListener);
+    recorder.getWriter().close();
+    if (reporter)
+        reporter->report();
+
+    std::cout << simulator->getFrameCount() << " frames in " << std::fixed << std::setprecision(3) << seconds << " s";
+    if (!intervals.intervals.empty()) {
+        std::vector<double> sorted = intervals.intervals;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (double interval : sorted)
+            sum += interval;
+        const double mean = sum / static_cast<double>(sorted.size());
+        std::cout << ", frame interval mean " << std::setprecision(1) << mean << " us, median " << sorted[sorted.size() / 2]
+                  << " us, max " << sorted.back() << " us";
+    }
+    std::cout << std::endl;
+    if (asyncSlow)
+        std::cout << "Slow listener received " << asyncSlow->getDeliveredCount() << " frames, " << asyncSlow->getDroppedCount() << " dropped, "
+                  << asyncSlow->getWaitCount() << " waits" << std::endl;
+    if (!recordPath.empty())
+        std::cout << "Recorded " << recorder.getRecordedCount() << " eye pairs to " << recordPath << std::endl;
+    return 0;
+}
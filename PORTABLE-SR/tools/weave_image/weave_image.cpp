@@ -0,0 +1,196 @@
+/*!
+ * Copyright (C) 2025 Leia, Inc.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/toolsupport.h"
+#include "sr/utility/simd.h"
+#include "sr/weaver/cpuweaver.h"
+
+// Reads a binary PPM (P6) image into RGBA8 pixels
+static bool readPPM(const std::string& path, std::vector<uint8_t>& pixels, int& width, int& height)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::string magic;
+    int maxValue = 0;
+    file >> magic >> width >> height >> maxValue;
+    file.get();
+    if (!file || magic != "P6" || maxValue != 255 || width <= 0 || height <= 0)
+        return false;
+
+    std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+    file.read(reinterpret_cast<char*>(rgb.data()), rgb.size());
+    if (!file)
+        return false;
+
+    pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; i++)
+    {
+        std::memcpy(&pixels[i * 4], &rgb[i * 3], 3);
+        pixels[i * 4 + 3] = 255;
+    }
+    return true;
+}
+
+// Writes RGBA8 pixels as a binary PPM (P6) image
+static bool writePPM(const std::string& path, const std::vector<uint8_t>& pixels, int width, int height)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << "P6\n" << width << " " << height << "\n255\n";
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; i++)
+        file.write(reinterpret_cast<const char*>(&pixels[i * 4]), 3);
+    return static_cast<bool>(file);
+}
+
+static void printUsage()
+{
+    std::cout
+        << "Usage: weave_image [options] <side-by-side.ppm> <woven.ppm>\n"
+        << "  --size W H                 Size of the woven image (default: size of the input)\n"
+        << "  --screen X Y               Position of the woven image on the panel (default: 0 0)\n"
+        << "  --display W H DOTPITCH     Panel resolution and dot pitch in cm\n"
+        << "  --lens SLANT PX N DON PATTERN FILTERWIDTH FILTERSLOPE\n"
+        << "  --eyes LX LY LZ RX RY RZ   Eye positions in mm (default: -31.5 100 600 31.5 100 600)\n"
+        << "  --srgb                     Convert sRGB input to linear and back while weaving\n"
+        << "  --act MODE STATIC DYNAMIC  Anti-crosstalk mode off, static or dynamic, and its factors (default: off)\n"
+        << "  --contrast C               Weaving contrast in [0, 1] (default: 1)\n"
+        << "  --not-tracking BEHAVIOR    Weave as if tracking was lost: left or left-shader\n"
+        << "  --threads N                Number of weaving threads (default: all hardware threads)\n"
+        << "  --simd LEVEL               scalar, sse2, avx2, avx512 or neon (default: best supported)\n";
+}
+
+int main(int argc, char** argv)
+{
+    SR::WeaverLensParameters lens;
+    SR::WeaverDisplayGeometry display;
+    std::vector<std::string> files;
+    int outputWidth = 0, outputHeight = 0, screenX = 0, screenY = 0;
+    float left[3] = { -31.5f, 100.0f, 600.0f };
+    float right[3] = { 31.5f, 100.0f, 600.0f };
+    bool srgb = false;
+    SR::CrosstalkParameters crosstalk;
+    float contrast = 1.0f;
+    bool tracking = true;
+    BehaviorWhenNotTracking behavior = BehaviorWhenNotTracking::Default;
+    unsigned int threads = 0;
+
+    Tools::Arguments arguments(argc, argv);
+    while (arguments.next())
+    {
+        if (arguments.is("--size", 2)) {
+            outputWidth = arguments.getInt();
+            outputHeight = arguments.getInt();
+        } else if (arguments.is("--screen", 2)) {
+            screenX = arguments.getInt();
+            screenY = arguments.getInt();
+        } else if (arguments.is("--display", 3)) {
+            display.resolutionWidth = arguments.getInt();
+            display.resolutionHeight = arguments.getInt();
+            display.dotPitch = arguments.getFloat();
+        } else if (arguments.is("--lens", 7)) {
+            lens.slant = arguments.getFloat();
+            lens.px = arguments.getFloat();
+            lens.n = arguments.getFloat();
+            lens.doN = arguments.getFloat();
+            lens.pattern = arguments.getFloat();
+            lens.filterWidth = arguments.getFloat();
+            lens.filterSlope = arguments.getFloat();
+        } else if (arguments.is("--eyes", 6)) {
+            for (float& v : left) v = arguments.getFloat();
+            for (float& v : right) v = arguments.getFloat();
+        } else if (arguments.is("--srgb")) {
+            srgb = true;
+        } else if (arguments.is("--act", 3)) {
+            const std::string mode = arguments.getString();
+            if (mode == "static") {
+                crosstalk.mode = WeaverACTMode::Static;
+            } else if (mode == "dynamic") {
+                crosstalk.mode = WeaverACTMode::Dynamic;
+            } else if (mode != "off") {
+                printUsage();
+                return 1;
+            }
+            crosstalk.staticFactor = arguments.getFloat();
+            crosstalk.dynamicFactor = arguments.getFloat();
+        } else if (arguments.is("--contrast", 1)) {
+            contrast = arguments.getFloat();
+        } else if (arguments.is("--not-tracking", 1)) {
+            const std::string name = arguments.getString();
+            if (name == "left") {
+                behavior = BehaviorWhenNotTracking::ShowLeft;
+            } else if (name == "left-shader") {
+                behavior = BehaviorWhenNotTracking::ShowLeftWithShader;
+            } else {
+                printUsage();
+                return 1;
+            }
+            tracking = false;
+        } else if (arguments.is("--threads", 1)) {
+            threads = static_cast<unsigned int>(arguments.getInt());
+        } else if (arguments.is("--simd", 1)) {
+            const std::string name = arguments.getString();
+            if (!Tools::selectSIMDLevel(name)) {
+                std::cerr << "SIMD level " << name << " is not supported" << std::endl;
+                return 1;
+            }
+        } else if (arguments.get().size() > 1 && arguments.get()[0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            files.push_back(arguments.get());
+        }
+    }
+
+    if (files.size() != 2) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<uint8_t> input;
+    int inputWidth = 0, inputHeight = 0;
+    if (!readPPM(files[0], input, inputWidth, inputHeight)) {
+        std::cerr << "Failed to read " << files[0] << std::endl;
+        return 1;
+    }
+    if (outputWidth <= 0 || outputHeight <= 0) {
+        outputWidth = inputWidth;
+        outputHeight = inputHeight;
+    }
+    std::vector<uint8_t> output(static_cast<size_t>(outputWidth) * outputHeight * 4);
+
+    SR::ICPUWeaver1* weaver = nullptr;
+    try {
+        SR::CreateCPUWeaver(lens, display, &weaver);
+        weaver->setInputViewBuffer(input.data(), inputWidth, inputHeight, inputWidth * 4, SR::CPUPixelFormat::RGBA8);
+        weaver->setOutputBuffer(output.data(), outputWidth, outputHeight, outputWidth * 4, SR::CPUPixelFormat::RGBA8);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        if (weaver != nullptr)
+            weaver->destroy();
+        return 1;
+    }
+    weaver->setScreenRect(screenX, screenY);
+    weaver->setEyePositions(left, right);
+    weaver->setShaderSRGBConversion(srgb, srgb);
+    weaver->setACTMode(crosstalk.mode);
+    weaver->setCrosstalkStaticFactor(crosstalk.staticFactor);
+    weaver->setCrosstalkDynamicFactor(crosstalk.dynamicFactor);
+    weaver->setContrast(contrast);
+    weaver->setBehaviorWhenNotTracking(behavior);
+    weaver->setTracking(tracking);
+    weaver->setThreadCount(threads);
+    weaver->weave();
+    weaver->destroy();
+
+    if (!writePPM(files[1], output, outputWidth, outputHeight)) {
+        std::cerr << "Failed to write " << files[1] << std::endl;
+        return 1;
+    }
+    return 0;
+}